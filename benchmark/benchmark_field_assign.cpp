@@ -0,0 +1,99 @@
+#include <benchmark/benchmark.h>
+
+#include <samurai/field.hpp>
+#include <samurai/numeric/field_row.hpp>
+#include <samurai/uniform_mesh.hpp>
+
+// Bandwidth of the field update unp1 = u - dt * v on a uniform 2D mesh: field expression assignment
+// (with the default execution policy) against hand-written loops on the rows of cells and on the whole storage.
+
+class FieldAssignFixture : public ::benchmark::Fixture
+{
+  public:
+
+    static constexpr std::size_t dim = 2;
+    using config                     = samurai::UniformConfig<dim>;
+    using mesh_t                     = samurai::UniformMesh<config>;
+    using mesh_id_t                  = typename mesh_t::mesh_id_t;
+
+    template <class Update>
+    void bench(benchmark::State& state, Update&& update)
+    {
+        auto level = static_cast<std::size_t>(state.range(0));
+        samurai::Box<double, dim> box{
+            {0, 0},
+            {1, 1}
+        };
+        mesh_t mesh{box, level};
+
+        auto u    = samurai::make_field<double, 1>("u", mesh);
+        auto v    = samurai::make_field<double, 1>("v", mesh);
+        auto unp1 = samurai::make_field<double, 1>("unp1", mesh);
+        u.fill(1.);
+        v.fill(2.);
+        unp1.fill(0.);
+
+        double dt = 0.5 / (1 << level);
+        for (auto _ : state)
+        {
+            update(unp1, u, v, dt);
+            benchmark::DoNotOptimize(unp1.array().data());
+            benchmark::ClobberMemory();
+        }
+        auto nb_cells              = mesh.nb_cells(mesh_id_t::cells);
+        state.counters["nb cells"] = static_cast<double>(nb_cells);
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * nb_cells));
+        state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * nb_cells * 3 * sizeof(double)));
+    }
+};
+
+BENCHMARK_DEFINE_F(FieldAssignFixture, Expression)(benchmark::State& state)
+{
+    bench(state,
+          [](auto& unp1, const auto& u, const auto& v, double dt)
+          {
+              unp1 = u - dt * v;
+          });
+}
+
+BENCHMARK_REGISTER_F(FieldAssignFixture, Expression)->DenseRange(8, 12, 2)->UseRealTime();
+
+BENCHMARK_DEFINE_F(FieldAssignFixture, RowLoop)(benchmark::State& state)
+{
+    bench(state,
+          [](auto& unp1, const auto& u, const auto& v, double dt)
+          {
+              samurai::for_each_interval(unp1.mesh(),
+                                         [&](std::size_t level, const auto& i, const auto& index)
+                                         {
+                                             auto out = samurai::detail::make_field_row(unp1, level, i, index);
+                                             auto a   = samurai::detail::make_field_row(u, level, i, index);
+                                             auto b   = samurai::detail::make_field_row(v, level, i, index);
+                                             for (std::ptrdiff_t x = 0; x < static_cast<std::ptrdiff_t>(i.size()); ++x)
+                                             {
+                                                 out(x, 0) = a(x, 0) - dt * b(x, 0);
+                                             }
+                                         });
+          });
+}
+
+BENCHMARK_REGISTER_F(FieldAssignFixture, RowLoop)->DenseRange(8, 12, 2)->UseRealTime();
+
+// Upper bound: one loop on the whole storage, ghosts included
+BENCHMARK_DEFINE_F(FieldAssignFixture, StorageLoop)(benchmark::State& state)
+{
+    bench(state,
+          [](auto& unp1, const auto& u, const auto& v, double dt)
+          {
+              double* out     = unp1.array().data();
+              const double* a = u.array().data();
+              const double* b = v.array().data();
+              std::size_t n   = unp1.array().size();
+              for (std::size_t k = 0; k < n; ++k)
+              {
+                  out[k] = a[k] - dt * b[k];
+              }
+          });
+}
+
+BENCHMARK_REGISTER_F(FieldAssignFixture, StorageLoop)->DenseRange(8, 12, 2)->UseRealTime();
@@ -0,0 +1,83 @@
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <xtensor/xmath.hpp>
+
+#include <samurai/field.hpp>
+#include <samurai/parallel.hpp>
+#include <samurai/uniform_mesh.hpp>
+
+// Thread scaling of parallel_for_each_interval on a uniform 2D mesh: a cell-wise update u = sqrt(|v|) + sin(w),
+// with the level of the mesh and the number of threads as arguments.
+
+class ParallelFixture : public ::benchmark::Fixture
+{
+  public:
+
+    static constexpr std::size_t dim = 2;
+    using config                     = samurai::UniformConfig<dim>;
+    using mesh_t                     = samurai::UniformMesh<config>;
+    using mesh_id_t                  = typename mesh_t::mesh_id_t;
+
+    template <class Policy>
+    void bench(benchmark::State& state, Policy policy)
+    {
+        auto level = static_cast<std::size_t>(state.range(0));
+        samurai::Box<double, dim> box{
+            {0, 0},
+            {1, 1}
+        };
+        mesh_t mesh{box, level};
+
+        auto u = samurai::make_field<double, 1>("u", mesh);
+        auto v = samurai::make_field<double, 1>("v", mesh);
+        auto w = samurai::make_field<double, 1>("w", mesh);
+        samurai::for_each_cell(mesh[mesh_id_t::cells],
+                               [&](auto& cell)
+                               {
+                                   v[cell] = cell.center(0) - 0.5;
+                                   w[cell] = cell.center(1);
+                               });
+
+        for (auto _ : state)
+        {
+            samurai::parallel_for_each_interval(policy,
+                                                mesh[mesh_id_t::cells],
+                                                [&](std::size_t l, const auto& i, const auto& index)
+                                                {
+                                                    u(l, i, index) = xt::sqrt(xt::abs(v(l, i, index))) + xt::sin(w(l, i, index));
+                                                });
+            benchmark::DoNotOptimize(u.array().data());
+        }
+        state.counters["nb cells"] = static_cast<double>(mesh.nb_cells(mesh_id_t::cells));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mesh.nb_cells(mesh_id_t::cells)));
+    }
+};
+
+BENCHMARK_DEFINE_F(ParallelFixture, Sequential)(benchmark::State& state)
+{
+    bench(state, samurai::execution::seq);
+}
+
+BENCHMARK_REGISTER_F(ParallelFixture, Sequential)->DenseRange(8, 12, 2)->UseRealTime();
+
+BENCHMARK_DEFINE_F(ParallelFixture, ThreadPool)(benchmark::State& state)
+{
+    samurai::ThreadPool::instance().set_num_threads(static_cast<std::size_t>(state.range(1)));
+    state.counters["threads"] = static_cast<double>(samurai::ThreadPool::instance().num_threads());
+    bench(state, samurai::execution::thread_pool);
+}
+
+BENCHMARK_REGISTER_F(ParallelFixture, ThreadPool)->ArgsProduct({{8, 10, 12}, {1, 2, 4, 8, 16, 32, 64}})->UseRealTime();
+
+#ifdef SAMURAI_WITH_OPENMP
+BENCHMARK_DEFINE_F(ParallelFixture, OpenMP)(benchmark::State& state)
+{
+    omp_set_num_threads(static_cast<int>(state.range(1)));
+    state.counters["threads"] = static_cast<double>(state.range(1));
+    bench(state, samurai::execution::openmp);
+}
+
+BENCHMARK_REGISTER_F(ParallelFixture, OpenMP)->ArgsProduct({{8, 10, 12}, {1, 2, 4, 8, 16, 32, 64}})->UseRealTime();
+#endif
@@ -0,0 +1,89 @@
+#include <benchmark/benchmark.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+#include "../test/test_adapted_mesh.hpp"
+
+// Assembly of the matrices of demos/FiniteVolume/heat.cpp and demos/FiniteVolume/stokes_2d.cpp:
+// preallocation then insertion entry by entry (create_matrix() + assemble_matrix()) against the CSR arrays
+// filled by the sweeps of the assembly (create_csr_matrix()).
+// Arguments: the maximum level of the mesh, and 0 (insertion) or 1 (CSR).
+//
+//     ./bench_samurai_petsc --benchmark_filter=assembly
+
+namespace
+{
+    constexpr std::size_t dim = 2;
+    using Config              = samurai::MRConfig<dim>;
+    using mesh_t              = samurai::MRMesh<Config>;
+
+    template <class Assembly>
+    void bench_assembly(benchmark::State& state, Assembly& assembly)
+    {
+        bool csr = state.range(1) != 0;
+        for (auto _ : state)
+        {
+            Mat A;
+            if (csr)
+            {
+                assembly.create_csr_matrix(A);
+            }
+            else
+            {
+                assembly.create_matrix(A);
+                assembly.assemble_matrix(A);
+            }
+            benchmark::DoNotOptimize(A);
+            MatDestroy(&A);
+        }
+        state.SetLabel(csr ? "csr" : "insertion");
+    }
+}
+
+static void PETSC_heat_assembly(benchmark::State& state)
+{
+    auto mesh = samurai::adapted_mesh(2, static_cast<std::size_t>(state.range(0)), 0.4, 1e-4);
+    auto u    = samurai::make_field<double, 1>("u", mesh);
+    samurai::make_bc<samurai::Neumann>(u, 0.);
+
+    double dt       = 1e-3;
+    auto diff       = samurai::make_diffusion<decltype(u)>();
+    auto id         = samurai::make_identity<decltype(u)>();
+    auto back_euler = id + dt * diff;
+
+    auto assembly = samurai::petsc::make_assembly(back_euler);
+    assembly.set_unknown(u);
+    bench_assembly(state, assembly);
+    state.counters["cells"] = static_cast<double>(mesh.nb_cells());
+}
+
+static void PETSC_stokes_assembly(benchmark::State& state)
+{
+    auto level = static_cast<std::size_t>(state.range(0));
+    samurai::Box<double, dim> box({0., 0.}, {1., 1.});
+    mesh_t mesh{box, level, level};
+
+    auto velocity = samurai::make_field<dim, false>("velocity", mesh);
+    auto pressure = samurai::make_field<1, false>("pressure", mesh);
+    samurai::make_bc<samurai::Dirichlet>(velocity, 0., 0.);
+    samurai::make_bc<samurai::Neumann>(pressure, 0.);
+
+    using VelocityField = decltype(velocity);
+    using PressureField = decltype(pressure);
+
+    auto diff    = samurai::make_diffusion<VelocityField>();
+    auto grad    = samurai::make_gradient<PressureField>();
+    auto div     = samurai::make_divergence<VelocityField>();
+    auto zero_op = samurai::make_zero_operator<PressureField>();
+
+    auto stokes = samurai::make_block_operator<2, 2>(diff, grad, -div, zero_op);
+
+    auto assembly = samurai::petsc::make_assembly<true>(stokes);
+    assembly.set_unknowns(velocity, pressure);
+    bench_assembly(state, assembly);
+    state.counters["cells"] = static_cast<double>(mesh.nb_cells());
+}
+
+BENCHMARK(PETSC_heat_assembly)->ArgsProduct({{6, 8, 10}, {0, 1}})->Unit(benchmark::kMillisecond);
+BENCHMARK(PETSC_stokes_assembly)->ArgsProduct({{5, 6, 7}, {0, 1}})->Unit(benchmark::kMillisecond);
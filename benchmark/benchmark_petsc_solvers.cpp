@@ -0,0 +1,102 @@
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+// Solution of one time step of demos/FiniteVolume/heat.cpp (backward Euler) with a CG preconditioned by
+// the samurai geometric multigrid (samurai_gmg), PETSc's algebraic multigrid (gamg) or Hypre's BoomerAMG.
+// Arguments: the maximum level of the mesh (the minimum level is 0), and 0 (samurai GMG), 1 (gamg) or 2 (hypre).
+// The setup of the preconditioner is included in the timings.
+//
+//     ./bench_samurai_petsc --benchmark_filter=solve
+
+namespace
+{
+    constexpr std::size_t dim = 2;
+    using Config              = samurai::MRConfig<dim>;
+    using mesh_t              = samurai::MRMesh<Config>;
+
+    // Gaussian bump, adapted as in the heat demo
+    mesh_t adapted_mesh(std::size_t max_level)
+    {
+        samurai::Box<double, dim> box({-2., -2.}, {2., 2.});
+        mesh_t mesh{box, 0, max_level};
+
+        auto u = samurai::make_field<double, 1>("u", mesh);
+        samurai::for_each_cell(mesh,
+                               [&](const auto& cell)
+                               {
+                                   auto x  = cell.center(0);
+                                   auto y  = cell.center(1);
+                                   u[cell] = std::exp(-20 * (x * x + y * y));
+                               });
+        samurai::make_bc<samurai::Neumann>(u, 0.);
+        auto MRadaptation = samurai::make_MRAdapt(u);
+        MRadaptation(1e-4, 1.);
+        return mesh;
+    }
+
+    const char* preconditioner_name(int64_t pc)
+    {
+        return pc == 0 ? "samurai_gmg" : (pc == 1 ? "gamg" : "hypre");
+    }
+}
+
+static void PETSC_heat_solve(benchmark::State& state)
+{
+    auto pc = state.range(1);
+    if (pc == 2)
+    {
+        PetscBool has_hypre = PETSC_FALSE;
+        PetscHasExternalPackage("hypre", &has_hypre);
+        if (!has_hypre)
+        {
+            state.SkipWithError("PETSc is built without Hypre");
+            return;
+        }
+    }
+
+    auto mesh = adapted_mesh(static_cast<std::size_t>(state.range(0)));
+    auto u    = samurai::make_field<double, 1>("u", mesh);
+    samurai::make_bc<samurai::Neumann>(u, 0.);
+    samurai::for_each_cell(mesh,
+                           [&](const auto& cell)
+                           {
+                               auto x  = cell.center(0);
+                               auto y  = cell.center(1);
+                               u[cell] = std::exp(-20 * (x * x + y * y));
+                           });
+    auto unp1 = samurai::make_field<double, 1>("unp1", mesh);
+    samurai::make_bc<samurai::Neumann>(unp1, 0.);
+
+    double dt       = 1e-2;
+    auto diff       = samurai::make_diffusion<decltype(u)>();
+    auto id         = samurai::make_identity<decltype(u)>();
+    auto back_euler = id + dt * diff;
+
+    PetscOptionsSetValue(NULL, "-ksp_type", "cg");
+    PetscOptionsSetValue(NULL, "-ksp_rtol", "1e-8");
+    PetscOptionsSetValue(NULL, "-pc_type", preconditioner_name(pc));
+
+    int iterations = 0;
+    for (auto _ : state)
+    {
+        auto solver = samurai::petsc::make_solver(back_euler);
+        unp1.fill(0);
+        solver.solve(unp1, u);
+        iterations = solver.iterations();
+    }
+
+    PetscOptionsClearValue(NULL, "-pc_type");
+    PetscOptionsClearValue(NULL, "-ksp_rtol");
+    PetscOptionsClearValue(NULL, "-ksp_type");
+
+    state.SetLabel(preconditioner_name(pc));
+    state.counters["cells"]      = static_cast<double>(mesh.nb_cells());
+    state.counters["iterations"] = iterations;
+}
+
+BENCHMARK(PETSC_heat_solve)->ArgsProduct({{6, 8, 10}, {0, 1, 2}})->Unit(benchmark::kMillisecond);
@@ -0,0 +1,278 @@
+#include <cmath>
+
+#include <benchmark/benchmark.h>
+
+#include <xtensor/xmasked_view.hpp>
+
+#include <samurai/field.hpp>
+#include <samurai/field_expression.hpp>
+#include <samurai/operators_base.hpp>
+#include <samurai/schemes/weno.hpp>
+#include <samurai/uniform_mesh.hpp>
+
+// Transport of a level set by the velocity field of demos/Weno/weno5.cpp on a uniform 2D mesh:
+// the WENO5 (Jiang-Shu and WENO-Z weights) operators of the library against the masked views
+// of the operator which the demo used before them, kept here as the baseline.
+
+template <class TInterval>
+class demo_weno5_op : public samurai::field_operator_base<TInterval>,
+                      public samurai::field_expression<demo_weno5_op<TInterval>>
+{
+  public:
+
+    INIT_OPERATOR(demo_weno5_op)
+
+    template <class T, class Field, class Vel>
+    inline auto vel_x_pos(T& dphi, const Field& phi, const Vel& vel) const
+    {
+        double inv_dx = 1. / dx();
+        double eps    = 1e-6;
+        auto mask     = vel(0, level, i, j) >= 0;
+
+        auto phi_m3 = xt::eval(xt::masked_view(phi(level, i - 3, j), mask));
+        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i - 2, j), mask));
+        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i - 1, j), mask));
+        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
+        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i + 1, j), mask));
+        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i + 2, j), mask));
+
+        auto q1 = (phi_m2 - phi_m3) * inv_dx;
+        auto q2 = (phi_m1 - phi_m2) * inv_dx;
+        auto q3 = (phi_ - phi_m1) * inv_dx;
+        auto q4 = (phi_p1 - phi_) * inv_dx;
+        auto q5 = (phi_p2 - phi_p1) * inv_dx;
+
+        auto dphi0 = 1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3;
+        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
+        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
+
+        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
+        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
+        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
+
+        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
+        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
+        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
+
+        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
+        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
+        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
+
+        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
+        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
+    }
+
+    template <class T, class Field, class Vel>
+    inline auto vel_x_neg(T& dphi, const Field& phi, const Vel& vel) const
+    {
+        double inv_dx = 1. / dx();
+        double eps    = 1e-6;
+        auto mask     = vel(0, level, i, j) < 0;
+
+        auto phi_p3 = xt::eval(xt::masked_view(phi(level, i + 3, j), mask));
+        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i + 2, j), mask));
+        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i + 1, j), mask));
+        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
+        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i - 1, j), mask));
+        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i - 2, j), mask));
+
+        auto q1 = (phi_p3 - phi_p2) * inv_dx;
+        auto q2 = (phi_p2 - phi_p1) * inv_dx;
+        auto q3 = (phi_p1 - phi_) * inv_dx;
+        auto q4 = (phi_ - phi_m1) * inv_dx;
+        auto q5 = (phi_m1 - phi_m2) * inv_dx;
+
+        auto dphi0 = xt::eval(1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3);
+        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
+        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
+
+        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
+        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
+        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
+
+        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
+        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
+        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
+
+        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
+        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
+        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
+
+        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
+        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
+    }
+
+    template <class T, class Field, class Vel>
+    inline auto vel_y_pos(T& dphi, const Field& phi, const Vel& vel) const
+    {
+        double inv_dx = 1. / dx();
+        double eps    = 1e-6;
+        auto mask     = vel(1, level, i, j) >= 0;
+
+        auto phi_m3 = xt::eval(xt::masked_view(phi(level, i, j - 3), mask));
+        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i, j - 2), mask));
+        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i, j - 1), mask));
+        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
+        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i, j + 1), mask));
+        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i, j + 2), mask));
+
+        auto q1 = (phi_m2 - phi_m3) * inv_dx;
+        auto q2 = (phi_m1 - phi_m2) * inv_dx;
+        auto q3 = (phi_ - phi_m1) * inv_dx;
+        auto q4 = (phi_p1 - phi_) * inv_dx;
+        auto q5 = (phi_p2 - phi_p1) * inv_dx;
+
+        auto dphi0 = 1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3;
+        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
+        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
+
+        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
+        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
+        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
+
+        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
+        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
+        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
+
+        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
+        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
+        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
+
+        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
+        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
+    }
+
+    template <class T, class Field, class Vel>
+    inline auto vel_y_neg(T& dphi, const Field& phi, const Vel& vel) const
+    {
+        double inv_dx = 1. / dx();
+        double eps    = 1e-6;
+        auto mask     = vel(1, level, i, j) < 0;
+
+        auto phi_p3 = xt::eval(xt::masked_view(phi(level, i, j + 3), mask));
+        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i, j + 2), mask));
+        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i, j + 1), mask));
+        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
+        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i, j - 1), mask));
+        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i, j - 2), mask));
+
+        auto q1 = (phi_p3 - phi_p2) * inv_dx;
+        auto q2 = (phi_p2 - phi_p1) * inv_dx;
+        auto q3 = (phi_p1 - phi_) * inv_dx;
+        auto q4 = (phi_ - phi_m1) * inv_dx;
+        auto q5 = (phi_m1 - phi_m2) * inv_dx;
+
+        auto dphi0 = 1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3;
+        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
+        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
+
+        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
+        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
+        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
+
+        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
+        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
+        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
+
+        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
+        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
+        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
+
+        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
+        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
+    }
+
+    template <class Field, class Vel>
+    inline auto operator()(samurai::Dim<2>, const Field& phi, const Vel& vel) const
+    {
+        xt::xtensor<double, 1> dphi_x = xt::zeros<double>({i.size()});
+        xt::xtensor<double, 1> dphi_y = xt::zeros<double>({i.size()});
+        vel_x_pos(dphi_x, phi, vel);
+        vel_x_neg(dphi_x, phi, vel);
+        vel_y_pos(dphi_y, phi, vel);
+        vel_y_neg(dphi_y, phi, vel);
+        return vel(0, level, i, j) * dphi_x + vel(1, level, i, j) * dphi_y;
+    }
+};
+
+template <class... CT>
+inline auto demo_weno5(CT&&... e)
+{
+    return samurai::make_field_operator_function<demo_weno5_op>(std::forward<CT>(e)...);
+}
+
+class WenoFixture : public ::benchmark::Fixture
+{
+  public:
+
+    static constexpr std::size_t dim = 2;
+    using config                     = samurai::UniformConfig<dim, 3>;
+    using mesh_t                     = samurai::UniformMesh<config>;
+    using mesh_id_t                  = typename mesh_t::mesh_id_t;
+
+    template <class Operator>
+    void bench(benchmark::State& state, Operator&& op)
+    {
+        auto level = static_cast<std::size_t>(state.range(0));
+        samurai::Box<double, dim> box{
+            {0, 0},
+            {1, 1}
+        };
+        mesh_t mesh{box, level};
+
+        auto phi     = samurai::make_field<double, 1>("phi", mesh);
+        auto vel     = samurai::make_field<double, 2>("vel", mesh);
+        auto phi_np1 = samurai::make_field<double, 1>("phi_np1", mesh);
+        samurai::for_each_cell(mesh[mesh_id_t::cells_and_ghosts],
+                               [&](auto& cell)
+                               {
+                                   auto x       = cell.center(0);
+                                   auto y       = cell.center(1);
+                                   phi[cell]    = std::sqrt((x - 0.5) * (x - 0.5) + (y - 0.75) * (y - 0.75)) - 0.15;
+                                   vel[cell][0] = -std::pow(std::sin(M_PI * x), 2.) * std::sin(2. * M_PI * y);
+                                   vel[cell][1] = std::pow(std::sin(M_PI * y), 2.) * std::sin(2. * M_PI * x);
+                               });
+
+        double dt = 0.5 / (1 << level);
+        for (auto _ : state)
+        {
+            phi_np1 = phi - dt * op(phi, vel);
+            benchmark::DoNotOptimize(phi_np1.array().data());
+        }
+        state.counters["nb cells"] = static_cast<double>(mesh.nb_cells(mesh_id_t::cells));
+        state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * mesh.nb_cells(mesh_id_t::cells)));
+    }
+};
+
+BENCHMARK_DEFINE_F(WenoFixture, Weno5_demo)(benchmark::State& state)
+{
+    bench(state,
+          [](const auto& phi, const auto& vel)
+          {
+              return demo_weno5(phi, vel);
+          });
+}
+
+BENCHMARK_REGISTER_F(WenoFixture, Weno5_demo)->DenseRange(6, 10, 2);
+
+BENCHMARK_DEFINE_F(WenoFixture, Weno5_library)(benchmark::State& state)
+{
+    bench(state,
+          [](const auto& phi, const auto& vel)
+          {
+              return samurai::weno5(phi, vel);
+          });
+}
+
+BENCHMARK_REGISTER_F(WenoFixture, Weno5_library)->DenseRange(6, 10, 2);
+
+BENCHMARK_DEFINE_F(WenoFixture, Weno5Z_library)(benchmark::State& state)
+{
+    bench(state,
+          [](const auto& phi, const auto& vel)
+          {
+              return samurai::weno5z(phi, vel);
+          });
+}
+
+BENCHMARK_REGISTER_F(WenoFixture, Weno5Z_library)->DenseRange(6, 10, 2);
@@ -0,0 +1,12 @@
+#include <benchmark/benchmark.h>
+
+#include <petsc.h>
+
+int main(int argc, char** argv)
+{
+    benchmark::Initialize(&argc, argv);
+    PetscInitialize(&argc, &argv, nullptr, nullptr);
+    benchmark::RunSpecifiedBenchmarks();
+    PetscFinalize();
+    return 0;
+}
@@ -0,0 +1,198 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+#include "CLI/CLI.hpp"
+#include <array>
+
+#include <mpi.h>
+
+#include <xtensor/xfixed.hpp>
+#include <xtensor/xmath.hpp>
+
+#include <samurai/algorithm.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/hdf5.hpp>
+#include <samurai/mpi.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/stencil_field.hpp>
+
+#include <filesystem>
+namespace fs = std::filesystem;
+
+// Advection of a disk on a multiresolution mesh distributed among the MPI processes:
+//
+//     mpirun -np 4 ./finite-volume-advection-2d-mpi
+//
+// Every process saves its local mesh (owned and halo cells) in its own file.
+
+template <class Mesh>
+auto init(Mesh& mesh)
+{
+    auto u = samurai::make_field<double, 1>("u", mesh);
+
+    samurai::for_each_cell(
+        mesh,
+        [&](auto& cell)
+        {
+            auto center           = cell.center();
+            const double radius   = .2;
+            const double x_center = 0.3;
+            const double y_center = 0.3;
+            if (((center[0] - x_center) * (center[0] - x_center) + (center[1] - y_center) * (center[1] - y_center)) <= radius * radius)
+            {
+                u[cell] = 1;
+            }
+            else
+            {
+                u[cell] = 0;
+            }
+        });
+
+    return u;
+}
+
+template <class DistributedMesh, class Field>
+double total_mass(const DistributedMesh& dmesh, const Field& u)
+{
+    double mass = 0.;
+    samurai::for_each_interval(dmesh.owned_cells(),
+                               [&](std::size_t level, const auto& i, const auto& index)
+                               {
+                                   const double dx = samurai::cell_length(level);
+                                   mass += dx * dx * xt::sum(u(level, i, index))();
+                               });
+
+    double global_mass = 0.;
+    MPI_Allreduce(&mass, &global_mass, 1, MPI_DOUBLE, MPI_SUM, dmesh.comm());
+    return global_mass;
+}
+
+template <class Field>
+void save(const fs::path& path, const std::string& filename, const Field& u, const std::string& suffix = "")
+{
+    auto mesh   = u.mesh();
+    auto level_ = samurai::make_field<std::size_t, 1>("level", mesh);
+
+    if (!fs::exists(path))
+    {
+        fs::create_directory(path);
+    }
+
+    samurai::for_each_cell(mesh,
+                           [&](const auto& cell)
+                           {
+                               level_[cell] = cell.level;
+                           });
+
+    samurai::save(path, fmt::format("{}{}", filename, suffix), mesh, u, level_);
+}
+
+int main(int argc, char* argv[])
+{
+    MPI_Init(&argc, &argv);
+
+    constexpr size_t dim = 2;
+    using Config         = samurai::MRConfig<dim>;
+    using mesh_t         = samurai::MRMesh<Config>;
+
+    // Simulation parameters
+    xt::xtensor_fixed<double, xt::xshape<dim>> min_corner = {0., 0.};
+    xt::xtensor_fixed<double, xt::xshape<dim>> max_corner = {1., 1.};
+    std::array<double, dim> a{
+        {1, 1}
+    };
+    double Tf  = .1;
+    double cfl = 0.5;
+
+    // Multiresolution parameters
+    std::size_t min_level = 4;
+    std::size_t max_level = 10;
+    double mr_epsilon     = 2.e-4; // Threshold used by multiresolution
+    double mr_regularity  = 1.;    // Regularity guess for multiresolution
+
+    // Output parameters
+    fs::path path        = fs::current_path();
+    std::string filename = "FV_advection_2d_mpi";
+    std::size_t nfiles   = 1;
+
+    CLI::App app{"Finite volume example for the advection equation in 2d "
+                 "using multiresolution on several MPI processes"};
+    app.add_option("--min-corner", min_corner, "The min corner of the box")->capture_default_str()->group("Simulation parameters");
+    app.add_option("--max-corner", max_corner, "The max corner of the box")->capture_default_str()->group("Simulation parameters");
+    app.add_option("--velocity", a, "The velocity of the advection equation")->capture_default_str()->group("Simulation parameters");
+    app.add_option("--cfl", cfl, "The CFL")->capture_default_str()->group("Simulation parameters");
+    app.add_option("--Tf", Tf, "Final time")->capture_default_str()->group("Simulation parameters");
+    app.add_option("--min-level", min_level, "Minimum level of the multiresolution (partitioning level)")
+        ->capture_default_str()
+        ->group("Multiresolution");
+    app.add_option("--max-level", max_level, "Maximum level of the multiresolution")->capture_default_str()->group("Multiresolution");
+    app.add_option("--mr-eps", mr_epsilon, "The epsilon used by the multiresolution to adapt the mesh")
+        ->capture_default_str()
+        ->group("Multiresolution");
+    app.add_option("--mr-reg",
+                   mr_regularity,
+                   "The regularity criteria used by the multiresolution to "
+                   "adapt the mesh")
+        ->capture_default_str()
+        ->group("Multiresolution");
+    app.add_option("--path", path, "Output path")->capture_default_str()->group("Ouput");
+    app.add_option("--filename", filename, "File name prefix")->capture_default_str()->group("Ouput");
+    app.add_option("--nfiles", nfiles, "Number of output files")->capture_default_str()->group("Ouput");
+    CLI11_PARSE(app, argc, argv);
+
+    const samurai::Box<double, dim> box(min_corner, max_corner);
+    samurai::mpi::DistributedMesh<mesh_t> dmesh(mesh_t{box, min_level, max_level});
+    auto& mesh = dmesh.mesh();
+    filename   = fmt::format("{}_rank_{}", filename, dmesh.rank());
+
+    double dt            = cfl / (1 << max_level);
+    const double dt_save = Tf / static_cast<double>(nfiles);
+    double t             = 0.;
+
+    auto u = init(mesh);
+    samurai::make_bc<samurai::Dirichlet>(u, 0.);
+    auto unp1 = samurai::make_field<double, 1>("unp1", mesh);
+
+    auto MRadaptation = samurai::mpi::make_MRAdapt(dmesh, u);
+    MRadaptation(mr_epsilon, mr_regularity);
+    save(path, filename, u, "_init");
+
+    std::size_t nsave = 1;
+    std::size_t nt    = 0;
+
+    while (t != Tf)
+    {
+        MRadaptation(mr_epsilon, mr_regularity);
+
+        t += dt;
+        if (t > Tf)
+        {
+            dt += Tf - t;
+            t = Tf;
+        }
+
+        double mass         = total_mass(dmesh, u);
+        std::size_t n_cells = dmesh.nb_cells();
+        if (dmesh.rank() == 0)
+        {
+            std::cout << fmt::format("iteration {}: t = {}, dt = {}, cells = {}, mass = {}", nt, t, dt, n_cells, mass) << std::endl;
+        }
+        nt++;
+
+        samurai::mpi::update_ghost_mr(dmesh, u);
+        unp1.resize();
+        unp1 = u - dt * samurai::upwind(a, u);
+
+        std::swap(u.array(), unp1.array());
+
+        if (t >= static_cast<double>(nsave + 1) * dt_save || t == Tf)
+        {
+            const std::string suffix = (nfiles != 1) ? fmt::format("_ite_{}", nsave++) : "";
+            save(path, filename, u, suffix);
+        }
+    }
+
+    MPI_Finalize();
+    return 0;
+}
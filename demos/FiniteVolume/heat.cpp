@@ -75,8 +75,9 @@ int main(int argc, char* argv[])
     // Time integration
     double Tf     = 1.;
     double dt     = Tf / 100;
-    bool implicit = false;
-    double cfl    = 0.95;
+    bool implicit    = false;
+    bool matrix_free = false;
+    double cfl       = 0.95;
 
     // Multiresolution parameters
     std::size_t min_level = 0;
@@ -95,6 +96,8 @@ int main(int argc, char* argv[])
     app.add_option("--init-sol", init_sol, "Initial solution: dirac/crenel")->capture_default_str()->group("Simulation parameters");
     app.add_option("--diff-coeff", diff_coeff, "Diffusion coefficient")->capture_default_str()->group("Simulation parameters");
     app.add_flag("--implicit", implicit, "Implicit scheme instead of explicit")->group("Simulation parameters");
+    app.add_flag("--matrix-free", matrix_free, "Matrix-free implicit operator (Jacobi preconditioner by default)")
+        ->group("Simulation parameters");
     app.add_option("--Tf", Tf, "Final time")->capture_default_str()->group("Simulation parameters");
     app.add_option("--dt", dt, "Time step")->capture_default_str()->group("Simulation parameters");
     app.add_option("--cfl", cfl, "The CFL")->capture_default_str()->group("Simulation parameters");
@@ -182,6 +185,11 @@ int main(int argc, char* argv[])
         dt        = cfl * (dx * dx) / (pow(2, dim) * diff_coeff);
     }
 
+    // The solver is kept through the time iterations: the matrix structure is reused while the mesh is unchanged
+    auto back_euler = id + dt * diff;
+    auto solver     = samurai::petsc::make_solver(back_euler);
+    solver.set_matrix_free(matrix_free);
+
     auto MRadaptation = samurai::make_MRAdapt(u);
     MRadaptation(mr_epsilon, mr_regularity);
 
@@ -208,8 +216,9 @@ int main(int argc, char* argv[])
 
         if (implicit)
         {
-            auto back_euler = id + dt * diff;
-            samurai::petsc::solve(back_euler, unp1, u); // solves the linear equation   [Id - dt*Lap](unp1) = u
+            back_euler = id + dt * diff; // dt may change at the last iteration
+            solver.update_coefficients();
+            solver.solve(unp1, u); // solves the linear equation   [Id - dt*Lap](unp1) = u
         }
         else
         {
@@ -248,6 +257,7 @@ int main(int argc, char* argv[])
         std::cout << "python <<path to samurai>>/python/read_mesh.py " << filename << "_ite_ --field u level --start 1 --end " << nsave
                   << std::endl;
     }
+    solver.destroy_petsc_objects();
     PetscFinalize();
 
     return 0;
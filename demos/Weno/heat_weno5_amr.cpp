@@ -456,7 +456,7 @@ class weno5_op : public samurai::field_operator_base<TInterval>,
 };
 
 template <class... CT>
-inline auto weno5(CT&&... e)
+inline auto amr_weno5(CT&&... e)
 {
     return samurai::make_field_operator_function<weno5_op>(std::forward<CT>(e)...);
 }
@@ -813,7 +813,7 @@ int main()
         field_np1.fill(0.);
 
         /* Covection */
-        field_np1 = field - dt * weno5(field, vel);
+        field_np1 = field - dt * amr_weno5(field, vel);
 
         /* Diffusion */
         field_np1 = field_np1 + dt * lap_exp(field, visc);
@@ -4,14 +4,11 @@
 #include <samurai/field.hpp>
 #include <samurai/hdf5.hpp>
 #include <samurai/mesh.hpp>
+#include <samurai/schemes/weno.hpp>
 #include <samurai/static_algorithm.hpp>
 
-#include <samurai/field_expression.hpp>
-#include <samurai/operators_base.hpp>
-
 #include <fmt/format.h>
 #include <xtensor/xfixed.hpp>
-#include <xtensor/xmasked_view.hpp>
 
 enum class AMR_Id
 {
@@ -165,193 +162,6 @@ void update_bc(Field& field)
     }
 }
 
-template <class TInterval>
-class weno5_op : public samurai::field_operator_base<TInterval>,
-                 public samurai::field_expression<weno5_op<TInterval>>
-{
-  public:
-
-    INIT_OPERATOR(weno5_op)
-
-    template <class T, class Field, class Vel>
-    inline auto vel_x_pos(T& dphi, const Field& phi, const Vel& vel) const
-    {
-        double inv_dx = 1. / dx();
-        double eps    = 1e-6;
-        auto mask     = vel(0, level, i, j) >= 0;
-
-        auto phi_m3 = xt::eval(xt::masked_view(phi(level, i - 3, j), mask));
-        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i - 2, j), mask));
-        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i - 1, j), mask));
-        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
-        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i + 1, j), mask));
-        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i + 2, j), mask));
-
-        auto q1 = (phi_m2 - phi_m3) * inv_dx;
-        auto q2 = (phi_m1 - phi_m2) * inv_dx;
-        auto q3 = (phi_ - phi_m1) * inv_dx;
-        auto q4 = (phi_p1 - phi_) * inv_dx;
-        auto q5 = (phi_p2 - phi_p1) * inv_dx;
-
-        auto dphi0 = 1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3;
-        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
-        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
-
-        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
-        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
-        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
-
-        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
-        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
-        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
-
-        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
-        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
-        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
-
-        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
-        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
-    }
-
-    template <class T, class Field, class Vel>
-    inline auto vel_x_neg(T& dphi, const Field& phi, const Vel& vel) const
-    {
-        double inv_dx = 1. / dx();
-        double eps    = 1e-6;
-        auto mask     = vel(0, level, i, j) < 0;
-
-        auto phi_p3 = xt::eval(xt::masked_view(phi(level, i + 3, j), mask));
-        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i + 2, j), mask));
-        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i + 1, j), mask));
-        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
-        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i - 1, j), mask));
-        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i - 2, j), mask));
-
-        auto q1 = (phi_p3 - phi_p2) * inv_dx;
-        auto q2 = (phi_p2 - phi_p1) * inv_dx;
-        auto q3 = (phi_p1 - phi_) * inv_dx;
-        auto q4 = (phi_ - phi_m1) * inv_dx;
-        auto q5 = (phi_m1 - phi_m2) * inv_dx;
-
-        auto dphi0 = xt::eval(1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3);
-        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
-        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
-
-        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
-        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
-        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
-
-        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
-        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
-        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
-
-        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
-        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
-        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
-
-        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
-        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
-    }
-
-    template <class T, class Field, class Vel>
-    inline auto vel_y_pos(T& dphi, const Field& phi, const Vel& vel) const
-    {
-        double inv_dx = 1. / dx();
-        double eps    = 1e-6;
-        auto mask     = vel(1, level, i, j) >= 0;
-
-        auto phi_m3 = xt::eval(xt::masked_view(phi(level, i, j - 3), mask));
-        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i, j - 2), mask));
-        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i, j - 1), mask));
-        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
-        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i, j + 1), mask));
-        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i, j + 2), mask));
-
-        auto q1 = (phi_m2 - phi_m3) * inv_dx;
-        auto q2 = (phi_m1 - phi_m2) * inv_dx;
-        auto q3 = (phi_ - phi_m1) * inv_dx;
-        auto q4 = (phi_p1 - phi_) * inv_dx;
-        auto q5 = (phi_p2 - phi_p1) * inv_dx;
-
-        auto dphi0 = 1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3;
-        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
-        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
-
-        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
-        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
-        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
-
-        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
-        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
-        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
-
-        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
-        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
-        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
-
-        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
-        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
-    }
-
-    template <class T, class Field, class Vel>
-    inline auto vel_y_neg(T& dphi, const Field& phi, const Vel& vel) const
-    {
-        double inv_dx = 1. / dx();
-        double eps    = 1e-6;
-        auto mask     = vel(1, level, i, j) < 0;
-
-        auto phi_p3 = xt::eval(xt::masked_view(phi(level, i, j + 3), mask));
-        auto phi_p2 = xt::eval(xt::masked_view(phi(level, i, j + 2), mask));
-        auto phi_p1 = xt::eval(xt::masked_view(phi(level, i, j + 1), mask));
-        auto phi_   = xt::eval(xt::masked_view(phi(level, i, j), mask));
-        auto phi_m1 = xt::eval(xt::masked_view(phi(level, i, j - 1), mask));
-        auto phi_m2 = xt::eval(xt::masked_view(phi(level, i, j - 2), mask));
-
-        auto q1 = (phi_p3 - phi_p2) * inv_dx;
-        auto q2 = (phi_p2 - phi_p1) * inv_dx;
-        auto q3 = (phi_p1 - phi_) * inv_dx;
-        auto q4 = (phi_ - phi_m1) * inv_dx;
-        auto q5 = (phi_m1 - phi_m2) * inv_dx;
-
-        auto dphi0 = 1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3;
-        auto dphi1 = -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4;
-        auto dphi2 = 1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5;
-
-        auto IS0 = 13. / 12 * xt::pow(q1 - 2. * q2 + q3, 2) + 1. / 4 * xt::pow(q1 - 4 * q2 + 3 * q3, 2);
-        auto IS1 = 13. / 12 * xt::pow(q2 - 2. * q3 + q4, 2) + 1. / 4 * xt::pow(q2 - q4, 2);
-        auto IS2 = 13. / 12 * xt::pow(q3 - 2. * q4 + q5, 2) + 1. / 4 * xt::pow(3 * q3 - 4 * q4 + q5, 2);
-
-        auto alpha0 = 0.1 * xt::pow((eps + IS0), -2);
-        auto alpha1 = 0.6 * xt::pow((eps + IS1), -2);
-        auto alpha2 = 0.3 * xt::pow((eps + IS2), -2);
-
-        auto omega0 = alpha0 / (alpha0 + alpha1 + alpha2);
-        auto omega1 = alpha1 / (alpha0 + alpha1 + alpha2);
-        auto omega2 = alpha2 / (alpha0 + alpha1 + alpha2);
-
-        auto tmp                    = xt::eval(xt::masked_view(dphi, mask));
-        xt::masked_view(dphi, mask) = tmp + omega0 * dphi0 + omega1 * dphi1 + omega2 * dphi2;
-    }
-
-    template <class Field, class Vel>
-    inline auto operator()(samurai::Dim<2> d, const Field& phi, const Vel& vel) const
-    {
-        xt::xtensor<double, 1> dphi_x = xt::zeros<double>({i.size()});
-        xt::xtensor<double, 1> dphi_y = xt::zeros<double>({i.size()});
-        vel_x_pos(dphi_x, phi, vel);
-        vel_x_neg(dphi_x, phi, vel);
-        vel_y_pos(dphi_y, phi, vel);
-        vel_y_neg(dphi_y, phi, vel);
-        return vel(0, level, i, j) * dphi_x + vel(1, level, i, j) * dphi_y;
-    }
-};
-
-template <class... CT>
-inline auto weno5(CT&&... e)
-{
-    return samurai::make_field_operator_function<weno5_op>(std::forward<CT>(e)...);
-}
-
 int main()
 {
     constexpr std::size_t dim = 2;
@@ -372,7 +182,7 @@ int main()
     for (std::size_t ite = 0; ite < max_ite; ++ite)
     {
         update_bc(field);
-        field_np1 = field - dt * weno5(field, vel);
+        field_np1 = field - dt * samurai::weno5(field, vel);
         std::swap(field.array(), field_np1.array());
         samurai::save(fmt::format("weno_{}", ite), mesh, field);
     }
@@ -427,7 +427,7 @@ class weno5_op : public samurai::field_operator_base<TInterval>,
 };
 
 template <class... CT>
-inline auto weno5(CT&&... e)
+inline auto amr_weno5(CT&&... e)
 {
     return samurai::make_field_operator_function<weno5_op>(std::forward<CT>(e)...);
 }
@@ -483,7 +483,7 @@ int main()
         auto field_np1 = samurai::make_field<double, 1>("sol", mesh);
         field_np1.fill(0.);
 
-        field_np1 = field - dt * weno5(field, vel);
+        field_np1 = field - dt * amr_weno5(field, vel);
 
         std::swap(field.array(), field_np1.array());
 
@@ -33,7 +33,7 @@ static char help[] = "Solution of the Poisson problem in the domain [0,1]^d.\n"
                      "--path         <string>        Output path\n"
                      "--filename     <string>        Solution file name\n"
                      "\n"
-                     "-------- Samurai Multigrid ('-pc_type mg' to activate)\n"
+                     "-------- Samurai Multigrid ('-pc_type samurai_gmg' to activate)\n"
                      "\n"
                      "--samg_smooth       <enum>     Smoother used in the samurai multigrid:\n"
                      "                                   sgs   - symmetric Gauss-Seidel\n"
@@ -54,8 +54,8 @@ static char help[] = "Solution of the Poisson problem in the domain [0,1]^d.\n"
                      "\n"
                      "-------- Useful Petsc options\n"
                      "\n"
-                     "-pc_type [mg|gamg|hypre...]    Sets the preconditioner ('mg' for the "
-                     "samurai multigrid)\n"
+                     "-pc_type [samurai_gmg|mg|gamg|hypre...]\n"
+                     "                               Sets the preconditioner\n"
                      "-ksp_monitor ascii             Prints the residual at each iteration\n"
                      "-ksp_view ascii                View the solver's parametrization\n"
                      "-ksp_rtol          <double>    Sets the solver tolerance\n"
@@ -108,6 +108,47 @@ namespace samurai
         }
     }
 
+    /**
+     * @brief Updates the ghosts of the levels >= min_level, and the projections on the level min_level - 1.
+     * The cells of the coarser levels must not have changed since the last update_ghost_mr(): it is used by the local time stepping,
+     * where only the finest levels are advanced at most substeps.
+     */
+    template <class Field, class... Fields>
+    void update_ghost_mr_from_level(std::size_t min_level, Field& field, Fields&... other_fields)
+    {
+        using mesh_id_t                  = typename Field::mesh_t::mesh_id_t;
+        constexpr std::size_t pred_order = Field::mesh_t::config::prediction_order;
+
+        if (min_level == 0)
+        {
+            update_ghost_mr(field, other_fields...);
+            return;
+        }
+
+        auto& mesh            = field.mesh();
+        std::size_t max_level = mesh.max_level();
+
+        for (std::size_t level = max_level; level >= min_level; --level)
+        {
+            auto set_at_levelm1 = intersection(mesh[mesh_id_t::reference][level], mesh[mesh_id_t::proj_cells][level - 1]).on(level - 1);
+            set_at_levelm1.apply_op(variadic_projection(field, other_fields...));
+        }
+
+        update_bc(min_level - 1, field, other_fields...);
+        update_ghost_periodic(min_level - 1, field, other_fields...);
+        for (std::size_t level = min_level; level <= max_level; ++level)
+        {
+            auto expr = intersection(difference(mesh[mesh_id_t::all_cells][level],
+                                                union_(mesh[mesh_id_t::cells][level], mesh[mesh_id_t::proj_cells][level])),
+                                     mesh.domain())
+                            .on(level);
+
+            expr.apply_op(variadic_prediction<pred_order, false>(field, other_fields...));
+            update_bc(level, field, other_fields...);
+            update_ghost_periodic(level, field, other_fields...);
+        }
+    }
+
     inline void update_ghost_mr()
     {
     }
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <algorithm>
+#include <cmath>
 #include <functional>
 #include <memory>
 #include <type_traits>
@@ -15,6 +17,7 @@
 #include <xtensor/xview.hpp>
 
 #include "dispatch.hpp"
+#include "numeric/field_row.hpp"
 #include "samurai_config.hpp"
 #include "static_algorithm.hpp"
 #include "stencil.hpp"
@@ -75,8 +78,43 @@ namespace samurai
         {
             data = value;
         }
+
+        template <class T, std::size_t size>
+        T get_component(const xt::xtensor_fixed<T, xt::xshape<size>>& data, std::size_t c)
+        {
+            return data[c];
+        }
+
+        template <class T>
+        T get_component(const T& data, std::size_t)
+        {
+            return data;
+        }
     }
 
+    /**
+     * Ghosts of the interval i of the row index at the level, outside the boundary of outward normal direction,
+     * given to the function boundary conditions: coords[d][x] is the coordinate d of the point of the boundary
+     * associated to the x-th ghost.
+     */
+    template <std::size_t dim, class TInterval>
+    struct BcPoints
+    {
+        using index_t     = xt::xtensor_fixed<typename TInterval::value_t, xt::xshape<dim - 1>>;
+        using direction_t = xt::xtensor_fixed<int, xt::xshape<dim>>;
+
+        std::size_t level;
+        direction_t direction;
+        TInterval i;
+        index_t index;
+        std::array<const double*, dim> coords;
+
+        std::size_t size() const
+        {
+            return i.size();
+        }
+    };
+
     ////////////////////////
     // BcValue definition //
     ////////////////////////
@@ -87,6 +125,9 @@ namespace samurai
         using value_t                    = detail::return_type_t<typename Field::value_type, Field::size>;
         using coords_t                   = xt::xtensor_fixed<double, xt::xshape<dim>>;
         using cell_t                     = typename Field::cell_t;
+        using points_t                   = BcPoints<dim, typename Field::interval_t>;
+        using direction_t                = typename points_t::direction_t;
+        using values_t                   = detail::field_row<typename Field::value_type>;
 
         virtual ~BcValue()                 = default;
         BcValue(const BcValue&)            = delete;
@@ -98,9 +139,15 @@ namespace samurai
         virtual std::unique_ptr<BcValue> clone() const                  = 0;
         virtual BCVType type() const                                    = 0;
 
+        virtual value_t get_ghost_value(const cell_t& ghost, const direction_t& direction, const coords_t& coords) const;
+        virtual void get_values(const points_t& points, const values_t& values) const;
+
       protected:
 
         BcValue() = default;
+
+        template <class Func>
+        static void get_values_pointwise(const points_t& points, const values_t& values, const Func& value_at);
     };
 
     template <class Field>
@@ -136,11 +183,49 @@ namespace samurai
         using value_t    = typename base_t::value_t;
         using coords_t   = typename base_t::coords_t;
         using cell_t     = typename base_t::cell_t;
+        using points_t   = typename base_t::points_t;
+        using values_t   = typename base_t::values_t;
         using function_t = std::function<value_t(const cell_t&, const coords_t&)>;
 
         FunctionBc(const function_t& f);
 
         value_t get_value(const cell_t& cell_in, const coords_t& coords) const override;
+        void get_values(const points_t& points, const values_t& values) const override;
+        std::unique_ptr<base_t> clone() const override;
+        BCVType type() const override;
+
+      private:
+
+        function_t m_func;
+    };
+
+    /**
+     * Function boundary condition evaluated on all the ghosts of an interval at once:
+     *
+     *   f(const BcPoints<dim, interval_t>& points, const detail::field_row<value_type>& values)
+     *
+     * must set values(x, c), the component c of the value at the point x, for 0 <= x < points.size().
+     * A single evaluation is given the ghost as a one-point interval, with its outward direction.
+     */
+    template <class Field>
+    class BatchFunctionBc : public BcValue<Field>
+    {
+      public:
+
+        using base_t      = BcValue<Field>;
+        using value_t     = typename base_t::value_t;
+        using coords_t    = typename base_t::coords_t;
+        using cell_t      = typename base_t::cell_t;
+        using points_t    = typename base_t::points_t;
+        using direction_t = typename base_t::direction_t;
+        using values_t    = typename base_t::values_t;
+        using function_t  = std::function<void(const points_t&, const values_t&)>;
+
+        BatchFunctionBc(const function_t& f);
+
+        value_t get_value(const cell_t& ghost, const coords_t& coords) const override;
+        value_t get_ghost_value(const cell_t& ghost, const direction_t& direction, const coords_t& coords) const override;
+        void get_values(const points_t& points, const values_t& values) const override;
         std::unique_ptr<base_t> clone() const override;
         BCVType type() const override;
 
@@ -153,6 +238,70 @@ namespace samurai
     // BcValue implementation //
     ////////////////////////////
 
+    /**
+     * @brief Value at the boundary point of a ghost, given with its outward direction.
+     * By default, get_value() of the cell next to the ghost in the direction, as for get_values().
+     */
+    template <class Field>
+    auto BcValue<Field>::get_ghost_value(const cell_t& ghost, const direction_t& direction, const coords_t& coords) const -> value_t
+    {
+        cell_t cell_in = ghost;
+        for (std::size_t d = 0; d < dim; ++d)
+        {
+            cell_in.indices[d] += direction[d];
+        }
+        return get_value(cell_in, coords);
+    }
+
+    /**
+     * @brief Values at the points of an interval, point by point.
+     */
+    template <class Field>
+    void BcValue<Field>::get_values(const points_t& points, const values_t& values) const
+    {
+        get_values_pointwise(points,
+                             values,
+                             [this](const cell_t& cell_in, const coords_t& coords)
+                             {
+                                 return get_value(cell_in, coords);
+                             });
+    }
+
+    /**
+     * @brief values(x, c) = value_at(cell_in, coords)[c] for the points x of the interval,
+     * where cell_in is the cell next to the ghost x in the direction.
+     */
+    template <class Field>
+    template <class Func>
+    void BcValue<Field>::get_values_pointwise(const points_t& points, const values_t& values, const Func& value_at)
+    {
+        coords_t coords;
+        cell_t cell_in;
+
+        cell_in.level      = points.level;
+        cell_in.indices[0] = points.i.start + points.direction[0];
+        cell_in.index      = points.i.index;
+        for (std::size_t d = 1; d < dim; ++d)
+        {
+            cell_in.indices[d] = points.index[d - 1] + points.direction[d];
+        }
+
+        for (std::size_t x = 0; x < points.size(); ++x)
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                coords[d] = points.coords[d][x];
+            }
+            auto v = value_at(cell_in, coords);
+            for (std::size_t c = 0; c < Field::size; ++c)
+            {
+                values(static_cast<std::ptrdiff_t>(x), c) = detail::get_component(v, c);
+            }
+            ++cell_in.indices[0];
+            ++cell_in.index;
+        }
+    }
+
     template <class Field>
     template <class... CT>
     ConstantBc<Field>::ConstantBc(const CT... v)
@@ -196,6 +345,15 @@ namespace samurai
         return m_func(cell_in, coords);
     }
 
+    /**
+     * @brief Same as BcValue::get_values, with direct calls to the function.
+     */
+    template <class Field>
+    void FunctionBc<Field>::get_values(const points_t& points, const values_t& values) const
+    {
+        base_t::get_values_pointwise(points, values, m_func);
+    }
+
     template <class Field>
     auto FunctionBc<Field>::clone() const -> std::unique_ptr<base_t>
     {
@@ -208,6 +366,86 @@ namespace samurai
         return BCVType::function;
     }
 
+    template <class Field>
+    BatchFunctionBc<Field>::BatchFunctionBc(const function_t& f)
+        : m_func(f)
+    {
+    }
+
+    /**
+     * @brief Value at the boundary point coords of the ghost, which lies on the inner face of the ghost:
+     * the outward direction is the one of the face.
+     */
+    template <class Field>
+    auto BatchFunctionBc<Field>::get_value(const cell_t& ghost, const coords_t& coords) const -> value_t
+    {
+        auto center = ghost.center();
+
+        std::size_t axis = 0;
+        for (std::size_t d = 1; d < base_t::dim; ++d)
+        {
+            if (std::abs(coords[d] - center[d]) > std::abs(coords[axis] - center[axis]))
+            {
+                axis = d;
+            }
+        }
+        direction_t direction;
+        direction.fill(0);
+        direction[axis] = coords[axis] < center[axis] ? 1 : -1;
+
+        return get_ghost_value(ghost, direction, coords);
+    }
+
+    template <class Field>
+    auto BatchFunctionBc<Field>::get_ghost_value(const cell_t& ghost, const direction_t& direction, const coords_t& coords) const
+        -> value_t
+    {
+        points_t points;
+        points.level     = ghost.level;
+        points.direction = direction;
+        points.i         = {ghost.indices[0], ghost.indices[0] + 1, ghost.index - ghost.indices[0]};
+        for (std::size_t d = 0; d < base_t::dim; ++d)
+        {
+            if (d > 0)
+            {
+                points.index[d - 1] = ghost.indices[d];
+            }
+            points.coords[d] = &coords[d];
+        }
+
+        std::array<typename Field::value_type, Field::size> v;
+        m_func(points, values_t{v.data(), static_cast<std::ptrdiff_t>(Field::size), 1});
+
+        value_t value;
+        if constexpr (Field::size == 1)
+        {
+            value = v[0];
+        }
+        else
+        {
+            std::copy(v.begin(), v.end(), value.begin());
+        }
+        return value;
+    }
+
+    template <class Field>
+    inline void BatchFunctionBc<Field>::get_values(const points_t& points, const values_t& values) const
+    {
+        m_func(points, values);
+    }
+
+    template <class Field>
+    auto BatchFunctionBc<Field>::clone() const -> std::unique_ptr<base_t>
+    {
+        return std::make_unique<BatchFunctionBc>(m_func);
+    }
+
+    template <class Field>
+    inline BCVType BatchFunctionBc<Field>::type() const
+    {
+        return BCVType::function;
+    }
+
     /////////////////////////
     // BcRegion definition //
     /////////////////////////
@@ -505,6 +743,31 @@ namespace samurai
         return OnDirection<dim, TInterval, 1>({d});
     }
 
+    /**
+     * Ghosts of a boundary region on one level, stored flat. The g-th entry is the interval intervals[g] of the row indices[g]
+     * of ghosts, filled from the cells shifted by -(2 ig + 1) * direction (ig being the ghost layer), where direction is
+     * directions[g]. The ghosts and their mirror cells start at the storage indices ghost_starts[g]
+     * and source_starts[g], valid as long as the generation of the mesh is unchanged.
+     */
+    template <std::size_t dim, class TInterval>
+    struct BcGhostList
+    {
+        using value_t     = typename TInterval::value_t;
+        using index_t     = xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>;
+        using direction_t = xt::xtensor_fixed<int, xt::xshape<dim>>;
+
+        std::vector<TInterval> intervals;
+        std::vector<index_t> indices;
+        std::vector<direction_t> directions;
+        std::vector<std::ptrdiff_t> ghost_starts;
+        std::vector<std::ptrdiff_t> source_starts;
+
+        std::size_t size() const
+        {
+            return intervals.size();
+        }
+    };
+
     ///////////////////
     // Bc definition //
     ///////////////////
@@ -522,10 +785,13 @@ namespace samurai
         using value_t      = typename bcvalue_t::value_t;
         using coords_t     = typename bcvalue_t::coords_t;
         using cell_t       = typename bcvalue_t::cell_t;
+        using points_t     = typename bcvalue_t::points_t;
+        using direction_t  = typename bcvalue_t::direction_t;
 
-        using bcregion_t = BcRegion<dim, interval_t>;
-        using lca_t      = typename bcregion_t::lca_t;
-        using region_t   = typename bcregion_t::region_t;
+        using bcregion_t   = BcRegion<dim, interval_t>;
+        using lca_t        = typename bcregion_t::lca_t;
+        using region_t     = typename bcregion_t::region_t;
+        using ghost_list_t = BcGhostList<dim, interval_t>;
 
         virtual ~Bc() = default;
 
@@ -548,6 +814,9 @@ namespace samurai
 
         auto get_region() const;
 
+        template <class Mesh>
+        const ghost_list_t& ghosts(const Mesh& mesh, std::size_t level);
+
         template <class Direction>
         void update_values(const Direction& d,
                            std::size_t level,
@@ -556,15 +825,28 @@ namespace samurai
 
         value_t constant_value();
         value_t value(const cell_t& cell_in, const coords_t& coords) const;
-        const auto& value() const;
+        value_t value(const cell_t& ghost, const direction_t& direction, const coords_t& coords) const;
+        auto value() const;
         BCVType get_value_type() const;
 
+        virtual void apply(std::size_t level, Field& field);
+        virtual void apply(Field& field);
+
       private:
 
         bcvalue_impl p_bcvalue;
         const lca_t& m_domain; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
         region_t m_region;
-        xt::xtensor<typename Field::value_type, detail::return_type<typename Field::value_type, size>::dim> m_value;
+
+        // Values of the last interval given to update_values (value of the cell x, component c at x * size + c),
+        // and coordinates of its boundary points; the buffers are kept from one interval to the next
+        std::vector<typename Field::value_type> m_value;
+        std::array<std::vector<double>, dim> m_coords;
+
+        // Ghosts of the region by level, built on the mesh of generation m_ghosts_generation (0: none)
+        std::size_t m_ghosts_generation = 0;
+        std::vector<ghost_list_t> m_ghosts;
+        std::vector<bool> m_ghosts_built;
     };
 
     ///////////////////
@@ -603,8 +885,9 @@ namespace samurai
         }
         bcvalue_impl bcvalue = bc.p_bcvalue->clone();
         std::swap(p_bcvalue, bcvalue);
-        m_domain = bc.m_domain;
-        m_region = bc.m_region;
+        m_domain            = bc.m_domain;
+        m_region            = bc.m_region;
+        m_ghosts_generation = 0;
         return *this;
     }
 
@@ -612,7 +895,8 @@ namespace samurai
     template <class Region>
     inline auto Bc<Field>::on(const Region& region)
     {
-        m_region = make_region<dim, interval_t>(region).get_region(m_domain);
+        m_region            = make_region<dim, interval_t>(region).get_region(m_domain);
+        m_ghosts_generation = 0;
         return this;
     }
 
@@ -620,7 +904,8 @@ namespace samurai
     template <class... Regions>
     inline auto Bc<Field>::on(const Regions&... regions)
     {
-        m_region = make_region<dim, interval_t>(regions...).get_region(m_domain);
+        m_region            = make_region<dim, interval_t>(regions...).get_region(m_domain);
+        m_ghosts_generation = 0;
         return this;
     }
 
@@ -630,48 +915,118 @@ namespace samurai
         return m_region;
     }
 
+    /**
+     * @brief Ghosts of the region on the level, built at the first call on a given mesh generation.
+     * The ghosts of the directions along which the mesh is periodic are not included.
+     */
     template <class Field>
-    template <class Direction>
-    void Bc<Field>::update_values(const Direction& dir,
-                                  std::size_t level,
-                                  const interval_t& i,
-                                  xt::xtensor_fixed<typename interval_t::value_t, xt::xshape<dim - 1>> index)
+    template <class Mesh>
+    auto Bc<Field>::ghosts(const Mesh& mesh, std::size_t level) -> const ghost_list_t&
     {
-        if (p_bcvalue->type() == BCVType::function)
+        if (m_ghosts_generation != mesh.generation())
+        {
+            m_ghosts.clear();
+            m_ghosts_built.clear();
+            m_ghosts_generation = mesh.generation();
+        }
+        if (level >= m_ghosts.size())
+        {
+            m_ghosts.resize(level + 1);
+            m_ghosts_built.resize(level + 1, false);
+        }
+        if (m_ghosts_built[level])
         {
-            coords_t coords;
-            cell_t cell_in;
+            return m_ghosts[level];
+        }
 
-            const double dx = 1. / (1 << level);
+        using mesh_id_t           = typename Mesh::mesh_id_t;
+        using index_t             = typename ghost_list_t::index_t;
+        constexpr int ghost_width = std::max(static_cast<int>(Mesh::config::max_stencil_width),
+                                             static_cast<int>(Mesh::config::prediction_order));
 
-            cell_in.level = level;
-            auto shift    = dir[0] < 0 ? -dir[0] : -dir[0] + 1;
-            coords[0]     = dx * (i.start + shift);
-            for (std::size_t d = 1; d < dim; ++d)
+        const auto& reference = mesh[mesh_id_t::reference];
+        auto& list            = m_ghosts[level];
+        auto& direction       = m_region.first;
+        auto& lca             = m_region.second;
+        for (std::size_t d = 0; d < direction.size(); ++d)
+        {
+            bool is_periodic = false;
+            for (std::size_t i = 0; i < dim; ++i)
             {
-                shift              = dir[d] < 0 ? -dir[d] : -dir[d] + 1;
-                coords[d]          = dx * (index[d - 1] + shift);
-                cell_in.indices[d] = index[d - 1] + dir[d];
+                if (direction[d](i) != 0 && mesh.is_periodic(i))
+                {
+                    is_periodic = true;
+                    break;
+                }
             }
-
-            if constexpr (size == 1)
+            if (is_periodic)
             {
-                m_value.resize({i.size()});
+                continue;
             }
-            else
+
+            std::size_t delta_l = lca[d].level() - level;
+            for (int ig = 0; ig < ghost_width; ++ig)
             {
-                m_value.resize({i.size(), size});
+                typename ghost_list_t::direction_t mirror = (2 * ig + 1) * direction[d];
+
+                auto boundary_layer     = translate(lca[d], (ig + 1) * (direction[d] << delta_l));
+                auto first_layer_ghosts = intersection(intersection(reference[level], boundary_layer), translate(reference[level], mirror))
+                                              .on(level);
+                first_layer_ghosts(
+                    [&](const auto& i, const auto& index)
+                    {
+                        interval_t source_i = i - mirror[0];
+                        index_t source_index;
+                        for (std::size_t k = 1; k < dim; ++k)
+                        {
+                            source_index[k - 1] = index[k - 1] - mirror[k];
+                        }
+                        const auto& ghost_stored  = mesh.get_interval(level, i, index);
+                        const auto& source_stored = mesh.get_interval(level, source_i, source_index);
+
+                        list.intervals.push_back(i);
+                        list.indices.push_back(index);
+                        list.directions.push_back(direction[d]);
+                        list.ghost_starts.push_back(static_cast<std::ptrdiff_t>(ghost_stored.index + i.start));
+                        list.source_starts.push_back(static_cast<std::ptrdiff_t>(source_stored.index + source_i.start));
+                    });
             }
+        }
+        m_ghosts_built[level] = true;
+        return list;
+    }
 
-            cell_in.indices[0] = i.start + dir[0];
-            cell_in.index      = i.index;
-            for (std::size_t ii = 0; ii < i.size(); ++ii)
+    template <class Field>
+    template <class Direction>
+    void Bc<Field>::update_values(const Direction& dir,
+                                  std::size_t level,
+                                  const interval_t& i,
+                                  xt::xtensor_fixed<typename interval_t::value_t, xt::xshape<dim - 1>> index)
+    {
+        if (p_bcvalue->type() == BCVType::function)
+        {
+            const double dx     = 1. / (1 << level);
+            const std::size_t n = i.size();
+
+            points_t points;
+            points.level     = level;
+            points.direction = dir;
+            points.i         = i;
+            points.index     = index;
+            for (std::size_t d = 0; d < dim; ++d)
             {
-                xt::view(m_value, ii) = p_bcvalue->get_value(cell_in, coords);
-                coords[0] += dx;
-                ++cell_in.indices[0];
-                ++cell_in.index;
+                auto shift = dir[d] < 0 ? -dir[d] : -dir[d] + 1;
+                auto first = dx * ((d == 0 ? i.start : index[d - 1]) + shift);
+                m_coords[d].resize(n);
+                for (std::size_t x = 0; x < n; ++x)
+                {
+                    m_coords[d][x] = (d == 0) ? first + dx * static_cast<double>(x) : first;
+                }
+                points.coords[d] = m_coords[d].data();
             }
+
+            m_value.resize(n * size);
+            p_bcvalue->get_values(points, {m_value.data(), static_cast<std::ptrdiff_t>(size), 1});
         }
     }
 
@@ -681,10 +1036,13 @@ namespace samurai
         return p_bcvalue->get_value({}, {});
     }
 
+    /**
+     * @brief Values computed by the last update_values: value()(x, c) is the component c of the value of the ghost x.
+     */
     template <class Field>
-    inline const auto& Bc<Field>::value() const
+    inline auto Bc<Field>::value() const
     {
-        return m_value;
+        return detail::field_row<const typename Field::value_type>{m_value.data(), static_cast<std::ptrdiff_t>(size), 1};
     }
 
     template <class Field>
@@ -693,6 +1051,15 @@ namespace samurai
         return p_bcvalue->get_value(cell_in, coords);
     }
 
+    /**
+     * @brief Value at the boundary point coords of the ghost, whose outward direction is given.
+     */
+    template <class Field>
+    inline auto Bc<Field>::value(const cell_t& ghost, const direction_t& direction, const coords_t& coords) const -> value_t
+    {
+        return p_bcvalue->get_ghost_value(ghost, direction, coords);
+    }
+
     template <class Field>
     inline BCVType Bc<Field>::get_value_type() const
     {
@@ -731,6 +1098,13 @@ namespace samurai
         return field.attach_bc(bc_type<Field>(mesh, FunctionBc<Field>(func)));
     }
 
+    template <template <class> class bc_type, class Field>
+    auto make_batch_bc(Field& field, typename BatchFunctionBc<Field>::function_t func)
+    {
+        auto& mesh = detail::get_mesh(field.mesh());
+        return field.attach_bc(bc_type<Field>(mesh, BatchFunctionBc<Field>(func)));
+    }
+
     template <template <class> class bc_type, class Field>
     auto make_bc(Field& field)
     {
@@ -764,6 +1138,9 @@ namespace samurai
         {
             return std::make_unique<Dirichlet>(*this);
         }
+
+        void apply(std::size_t level, Field& field) override;
+        void apply(Field& field) override;
     };
 
     template <class Field>
@@ -776,185 +1153,79 @@ namespace samurai
         {
             return std::make_unique<Neumann>(*this);
         }
+
+        void apply(std::size_t level, Field& field) override;
+        void apply(Field& field) override;
     };
 
-    template <class Field>
-    void apply_bc_impl(Dirichlet<Field>& bc, std::size_t level, Field& field)
+    namespace detail
     {
-        static constexpr std::size_t dim = Field::dim;
-        constexpr int ghost_width        = std::max(static_cast<int>(Field::mesh_t::config::max_stencil_width),
-                                             static_cast<int>(Field::mesh_t::config::prediction_order));
-
-        using mesh_id_t = typename Field::mesh_t::mesh_id_t;
-        auto& mesh      = field.mesh()[mesh_id_t::reference];
-
-        auto region     = bc.get_region();
-        auto& direction = region.first;
-        auto& lca       = region.second;
-        for (std::size_t d = 0; d < direction.size(); ++d)
+        /**
+         * @brief Fills the ghosts of the bc on the level with a * value + b * mirror, where mirror is the value of the cell
+         * symmetric to the ghost with respect to the boundary. The loops run along the flat list of the ghost intervals (see Bc::ghosts).
+         */
+        template <class Field>
+        void apply_mirror_bc(Bc<Field>& bc, std::size_t level, Field& field, double a, double b)
         {
-            bool is_periodic = false;
-            for (std::size_t i = 0; i < dim; ++i)
+            using value_type           = typename Field::value_type;
+            constexpr std::size_t size = Field::size;
+            const auto& ghosts         = bc.ghosts(field.mesh(), level);
+            auto cells                 = make_field_cells(field);
+            const bool is_constant     = bc.get_value_type() == BCVType::constant;
+            const auto coeff_b         = static_cast<value_type>(b);
+
+            std::array<value_type, size> constant{};
+            if (is_constant)
             {
-                if (direction[d](i) != 0 && field.mesh().is_periodic(i))
+                auto v = bc.constant_value();
+                for (std::size_t c = 0; c < size; ++c)
                 {
-                    is_periodic = true;
-                    break;
+                    constant[c] = static_cast<value_type>(a * detail::get_component(v, c));
                 }
             }
-            if (!is_periodic)
+
+            for (std::size_t g = 0; g < ghosts.size(); ++g)
             {
-                std::size_t delta_l = lca[d].level() - level;
-                for (int ig = 0; ig < ghost_width; ++ig)
+                const auto n      = static_cast<std::ptrdiff_t>(ghosts.intervals[g].size());
+                const auto ghost  = ghosts.ghost_starts[g];
+                const auto source = ghosts.source_starts[g];
+                if (is_constant)
                 {
-                    auto first_layer_ghosts = intersection(intersection(mesh[level], translate(lca[d], (ig + 1) * (direction[d] << delta_l))),
-                                                           translate(mesh[level], (2 * ig + 1) * direction[d]))
-                                                  .on(level);
-                    first_layer_ghosts(
-                        [&](const auto& i, const auto& index)
+                    for (std::size_t c = 0; c < size; ++c)
+                    {
+                        for (std::ptrdiff_t x = 0; x < n; ++x)
                         {
-                            if (bc.get_value_type() == BCVType::constant)
-                            {
-                                if constexpr (dim == 1)
-                                {
-                                    field(level, i) = 2 * bc.constant_value() - field(level, i - (2 * ig + 1) * direction[d][0]);
-                                }
-                                else if constexpr (dim == 2)
-                                {
-                                    auto j             = index[0];
-                                    field(level, i, j) = 2 * bc.constant_value()
-                                                       - field(level, i - (2 * ig + 1) * direction[d][0], j - (2 * ig + 1) * direction[d][1]);
-                                }
-                                else if constexpr (dim == 3)
-                                {
-                                    auto j                = index[0];
-                                    auto k                = index[1];
-                                    field(level, i, j, k) = 2 * bc.constant_value()
-                                                          - field(level,
-                                                                  i - (2 * ig + 1) * direction[d][0],
-                                                                  j - (2 * ig + 1) * direction[d][1],
-                                                                  k - (2 * ig + 1) * direction[d][2]);
-                                }
-                            }
-                            else if (bc.get_value_type() == BCVType::function)
-                            {
-                                bc.update_values(direction[d], level, i, index);
-
-                                if constexpr (dim == 1)
-                                {
-                                    field(level, i) = 2 * bc.value() - field(level, i - (2 * ig + 1) * direction[d][0]);
-                                }
-                                else if constexpr (dim == 2)
-                                {
-                                    auto j             = index[0];
-                                    field(level, i, j) = 2 * bc.value()
-                                                       - field(level, i - (2 * ig + 1) * direction[d][0], j - (2 * ig + 1) * direction[d][1]);
-                                }
-                                else if constexpr (dim == 3)
-                                {
-                                    auto j                = index[0];
-                                    auto k                = index[1];
-                                    field(level, i, j, k) = 2 * bc.value()
-                                                          - field(level,
-                                                                  i - (2 * ig + 1) * direction[d][0],
-                                                                  j - (2 * ig + 1) * direction[d][1],
-                                                                  k - (2 * ig + 1) * direction[d][2]);
-                                }
-                            }
-                        });
+                            cells(ghost + x, c) = constant[c] + coeff_b * cells(source + x, c);
+                        }
+                    }
+                }
+                else
+                {
+                    bc.update_values(ghosts.directions[g], level, ghosts.intervals[g], ghosts.indices[g]);
+                    auto values = bc.value();
+                    for (std::size_t c = 0; c < size; ++c)
+                    {
+                        for (std::ptrdiff_t x = 0; x < n; ++x)
+                        {
+                            cells(ghost + x, c) = static_cast<value_type>(a * values(x, c)) + coeff_b * cells(source + x, c);
+                        }
+                    }
                 }
             }
         }
     }
 
     template <class Field>
-    void apply_bc_impl(Neumann<Field>& bc, std::size_t level, Field& field)
+    void apply_bc_impl(Dirichlet<Field>& bc, std::size_t level, Field& field)
     {
-        static constexpr std::size_t dim = Field::dim;
-        constexpr int ghost_width        = std::max(static_cast<int>(Field::mesh_t::config::max_stencil_width),
-                                             static_cast<int>(Field::mesh_t::config::prediction_order));
-
-        using mesh_id_t = typename Field::mesh_t::mesh_id_t;
-        auto& mesh      = field.mesh()[mesh_id_t::reference];
+        detail::apply_mirror_bc(bc, level, field, 2., -1.);
+    }
 
-        auto region     = bc.get_region();
-        auto& direction = region.first;
-        auto& lca       = region.second;
-        for (std::size_t d = 0; d < direction.size(); ++d)
-        {
-            bool is_periodic = false;
-            for (std::size_t i = 0; i < dim; ++i)
-            {
-                if (direction[d](i) != 0 && field.mesh().is_periodic(i))
-                {
-                    is_periodic = true;
-                    break;
-                }
-            }
-            if (!is_periodic)
-            {
-                std::size_t delta_l = lca[d].level() - level;
-                for (int ig = 0; ig < ghost_width; ++ig)
-                {
-                    auto first_layer_ghosts = intersection(intersection(mesh[level], translate(lca[d], (ig + 1) * (direction[d] << delta_l))),
-                                                           translate(mesh[level], (2 * ig + 1) * direction[d]))
-                                                  .on(level);
-                    first_layer_ghosts(
-                        [&](const auto& i, const auto& index)
-                        {
-                            const double dx = 1. / (1 << level);
-                            if (bc.get_value_type() == BCVType::constant)
-                            {
-                                if constexpr (dim == 1)
-                                {
-                                    field(level, i) = dx * bc.constant_value() + field(level, i - (2 * ig + 1) * direction[d][0]);
-                                }
-                                else if constexpr (dim == 2)
-                                {
-                                    auto j             = index[0];
-                                    field(level, i, j) = dx * bc.constant_value()
-                                                       + field(level, i - (2 * ig + 1) * direction[d][0], j - (2 * ig + 1) * direction[d][1]);
-                                }
-                                else if constexpr (dim == 3)
-                                {
-                                    auto j                = index[0];
-                                    auto k                = index[1];
-                                    field(level, i, j, k) = dx * bc.constant_value()
-                                                          + field(level,
-                                                                  i - (2 * ig + 1) * direction[d][0],
-                                                                  j - (2 * ig + 1) * direction[d][1],
-                                                                  k - (2 * ig + 1) * direction[d][2]);
-                                }
-                            }
-                            else if (bc.get_value_type() == BCVType::function)
-                            {
-                                bc.update_values(direction[d], level, i, index);
-
-                                if constexpr (dim == 1)
-                                {
-                                    field(level, i) = dx * bc.value() + field(level, i - (2 * ig + 1) * direction[d][0]);
-                                }
-                                else if constexpr (dim == 2)
-                                {
-                                    auto j             = index[0];
-                                    field(level, i, j) = dx * bc.value()
-                                                       + field(level, i - (2 * ig + 1) * direction[d][0], j - (2 * ig + 1) * direction[d][1]);
-                                }
-                                else if constexpr (dim == 3)
-                                {
-                                    auto j                = index[0];
-                                    auto k                = index[1];
-                                    field(level, i, j, k) = dx * bc.value()
-                                                          + field(level,
-                                                                  i - (2 * ig + 1) * direction[d][0],
-                                                                  j - (2 * ig + 1) * direction[d][1],
-                                                                  k - (2 * ig + 1) * direction[d][2]);
-                                }
-                            }
-                        });
-                }
-            }
-        }
+    template <class Field>
+    void apply_bc_impl(Neumann<Field>& bc, std::size_t level, Field& field)
+    {
+        const double dx = 1. / (1 << level);
+        detail::apply_mirror_bc(bc, level, field, dx, 1.);
     }
 
     struct select_bc_functor
@@ -984,6 +1255,7 @@ namespace samurai
         }
     };
 
+    // Run-time selection of the bc types that do not override Bc::apply
     template <class Field>
     using select_bc_dispatcher = unit_static_dispatcher<select_bc_functor, Bc<Field>, BC_TYPES::types<Field>>;
 
@@ -999,12 +1271,51 @@ namespace samurai
         }
     }
 
+    /**
+     * @brief By default, the type of the bc is found among BC_TYPES at run time (user-defined bc types).
+     */
+    template <class Field>
+    void Bc<Field>::apply(std::size_t level, Field& field)
+    {
+        select_bc_dispatcher<Field>::dispatch(*this, level, field);
+    }
+
+    template <class Field>
+    void Bc<Field>::apply(Field& field)
+    {
+        select_bc_dispatcher<Field>::dispatch(*this, field);
+    }
+
+    template <class Field>
+    void Dirichlet<Field>::apply(std::size_t level, Field& field)
+    {
+        apply_bc_impl(*this, level, field);
+    }
+
+    template <class Field>
+    void Dirichlet<Field>::apply(Field& field)
+    {
+        apply_bc_impl(*this, field);
+    }
+
+    template <class Field>
+    void Neumann<Field>::apply(std::size_t level, Field& field)
+    {
+        apply_bc_impl(*this, level, field);
+    }
+
+    template <class Field>
+    void Neumann<Field>::apply(Field& field)
+    {
+        apply_bc_impl(*this, field);
+    }
+
     template <class Field>
     void update_bc(std::size_t level, Field& field)
     {
         for (auto& bc : field.get_bc())
         {
-            select_bc_dispatcher<Field>::dispatch(*bc.get(), level, field);
+            bc->apply(level, field);
         }
     }
 
@@ -1020,7 +1331,7 @@ namespace samurai
     {
         for (auto& bc : field.get_bc())
         {
-            select_bc_dispatcher<Field>::dispatch(*bc.get(), field);
+            bc->apply(field);
         }
     }
 
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <cstddef>
 
 #include <xtensor/xfixed.hpp>
 #include <xtensor/xio.hpp>
@@ -14,7 +15,7 @@ namespace samurai
     template <typename LevelType, std::enable_if_t<std::is_integral<LevelType>::value, bool> = true>
     inline double cell_length(LevelType level)
     {
-        return 1. / (1 << level);
+        return 1. / static_cast<double>(std::size_t{1} << level);
     }
 
     /** @class Cell
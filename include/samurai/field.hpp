@@ -8,6 +8,7 @@
 #include <array>
 #include <memory>
 #include <stdexcept>
+#include <tuple>
 
 #include <fmt/format.h>
 
@@ -20,7 +21,9 @@
 #include "cell_array.hpp"
 #include "field_expression.hpp"
 #include "mesh_holder.hpp"
+#include "numeric/field_row.hpp"
 #include "numeric/gauss_legendre.hpp"
+#include "parallel.hpp"
 
 namespace samurai
 {
@@ -382,6 +385,9 @@ namespace samurai
         template <class E>
         Field& operator=(const field_expression<E>& e);
 
+        template <class Policy, class E>
+        void assign(Policy policy, const field_expression<E>& e);
+
         void fill(value_type v);
 
         const data_type& array() const;
@@ -585,18 +591,86 @@ namespace samurai
         return *this;
     }
 
+    namespace detail
+    {
+        template <class T>
+        struct is_field : std::false_type
+        {
+        };
+
+        template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+        struct is_field<Field<mesh_t, value_t, size_, SOA>> : std::true_type
+        {
+        };
+
+        /**
+         * @brief Whether the evaluation of the expression on an interval reads the data of the field stored at data
+         * outside of this interval, i.e. whether this field is an operand of a stencil operator.
+         *
+         * Writing to this field while the expression is evaluated on other intervals is then a data race.
+         * Field expressions which are neither fields nor field functions are assumed to read any cell.
+         */
+        template <class E>
+        bool reads_neighbours_of(const E& e, const void* data, bool in_stencil = false)
+        {
+            using expr_t = std::decay_t<E>;
+            if constexpr (is_field<expr_t>::value)
+            {
+                return in_stencil && static_cast<const void*>(e.array().data()) == data;
+            }
+            else if constexpr (is_field_function<expr_t>::value)
+            {
+                bool stencil = in_stencil || is_field_operator_function<expr_t>::value;
+                return std::apply(
+                    [&](const auto&... args)
+                    {
+                        return (false || ... || reads_neighbours_of(args, data, stencil));
+                    },
+                    e.arguments());
+            }
+            else
+            {
+                return is_field_expression<expr_t>::value;
+            }
+        }
+    } // namespace detail
+
+    /**
+     * The expression is evaluated on the cells, interval by interval, with the default execution policy:
+     * the evaluation of the expression must not modify shared data.
+     */
     template <class mesh_t, class value_t, std::size_t size_, bool SOA>
     template <class E>
     inline auto Field<mesh_t, value_t, size_, SOA>::operator=(const field_expression<E>& e) -> Field&
     {
-        for_each_interval(this->mesh(),
-                          [&](std::size_t level, const auto& i, const auto& index)
-                          {
-                              (*this)(level, i, index) = e.derived_cast()(level, i, index);
-                          });
+        assign(execution::par, e);
         return *this;
     }
 
+    /**
+     * If the field is an operand of a stencil operator of the expression (e.g. u = u + dt * upwind(a, u)),
+     * the cells are updated in place sequentially, whatever the policy: a parallel update would race with
+     * the reads of the neighbouring cells. The interval lists of the meshes are cached per mesh generation.
+     */
+    template <class mesh_t, class value_t, std::size_t size_, bool SOA>
+    template <class Policy, class E>
+    inline void Field<mesh_t, value_t, size_, SOA>::assign(Policy policy, const field_expression<E>& e)
+    {
+        auto assign_interval = [&](std::size_t level, const auto& i, const auto& index)
+        {
+            (*this)(level, i, index) = e.derived_cast()(level, i, index);
+        };
+
+        if (detail::reads_neighbours_of(e.derived_cast(), m_data.data()))
+        {
+            parallel_for_each_interval(execution::seq, this->mesh(), assign_interval);
+        }
+        else
+        {
+            parallel_for_each_interval(policy, this->mesh(), assign_interval, execution::chunk_size);
+        }
+    }
+
     template <class mesh_t, class value_t, std::size_t size_, bool SOA>
     template <class... T>
     inline auto
@@ -777,7 +851,10 @@ namespace samurai
     }
 
     /**
-     * @brief Creates a field.
+     * @brief Creates a field with the means of f on the cells.
+     * f is a function of a single point, evaluated point by point, or a function of a batch of points marked by batch(),
+     * evaluated at once on all the quadrature nodes of a row of cells (see GaussLegendre::quadrature()).
+     * The rows are distributed with the default execution policy: f must not modify shared data.
      * @param name Name of the returned Field.
      * @param f Continuous function.
      * @param gl Gauss Legendre polynomial
@@ -788,12 +865,36 @@ namespace samurai
         auto field = make_field<value_t, size, SOA, mesh_t>(name, mesh);
         field.fill(0);
 
-        for_each_cell(mesh,
-                      [&](const auto& cell)
-                      {
-                          const double& h = cell.length;
-                          field[cell]     = gl.quadrature<size>(cell, f) / pow(h, mesh_t::dim);
-                      });
+        // Rows of at most max_chunk cells, so that the batches of nodes stay of the size of the chunks of the assignments
+        const std::size_t max_chunk = std::max<std::size_t>(execution::chunk_size / gl.nb_nodes(mesh_t::dim), 1);
+
+        auto f_batch = detail::as_batch<size, mesh_t::dim>(f);
+        parallel_for_each_interval(
+            execution::par,
+            mesh,
+            [&](std::size_t level, const auto& i, const auto& index)
+            {
+                using interval_t = std::decay_t<decltype(i)>;
+                using index_t    = typename interval_t::value_t;
+
+                double cell_volume = pow(cell_length(level), mesh_t::dim);
+                auto row           = detail::make_field_row(field, level, i, index);
+                for (index_t start = i.start; start < i.end; start += static_cast<index_t>(max_chunk))
+                {
+                    interval_t chunk{start, std::min(i.end, start + static_cast<index_t>(max_chunk)), i.index};
+                    auto integrals = gl.template quadrature<size>(level, chunk, index, f_batch);
+                    auto offset    = static_cast<std::ptrdiff_t>(start - i.start);
+                    for (std::size_t c = 0; c < chunk.size(); ++c)
+                    {
+                        for (std::size_t k = 0; k < size; ++k)
+                        {
+                            auto integral                                   = integrals.data()[c * size + k];
+                            row(offset + static_cast<std::ptrdiff_t>(c), k) = static_cast<value_t>(integral / cell_volume);
+                        }
+                    }
+                }
+            },
+            max_chunk);
         return field;
     }
 
@@ -898,8 +999,70 @@ namespace samurai
             return m_fields;
         }
 
+        /**
+         * @brief Assigns one expression to each field, in a single loop over the cells (see Field::operator=).
+         */
+        template <class... E>
+        void assign(const field_expression<E>&... expressions)
+        {
+            assign(execution::par, expressions...);
+        }
+
+        /**
+         * @brief Same with the given execution policy: the loop is sequential if one of the fields is an operand
+         * of a stencil operator of one of the expressions (see Field::assign).
+         */
+        template <class Policy, class... E, class = std::enable_if_t<!is_field_expression<Policy>::value>>
+        void assign(Policy policy, const field_expression<E>&... expressions)
+        {
+            static_assert(sizeof...(E) == 1 + sizeof...(TFields), "one expression per field is expected");
+
+            auto exprs           = std::forward_as_tuple(expressions.derived_cast()...);
+            auto assign_interval = [&](std::size_t level, const auto& i, const auto& index)
+            {
+                std::apply(
+                    [&](auto&... field)
+                    {
+                        std::apply(
+                            [&](const auto&... e)
+                            {
+                                ((field(level, i, index) = e(level, i, index)), ...);
+                            },
+                            exprs);
+                    },
+                    m_fields);
+            };
+
+            bool aliased = std::apply(
+                [&](const auto&... field)
+                {
+                    return std::apply(
+                        [&](const auto&... e)
+                        {
+                            return (false || ... || reads_neighbours_of_any(e, field.array().data()...));
+                        },
+                        exprs);
+                },
+                m_fields);
+
+            if (aliased)
+            {
+                parallel_for_each_interval(execution::seq, mesh(), assign_interval);
+            }
+            else
+            {
+                parallel_for_each_interval(policy, mesh(), assign_interval, execution::chunk_size);
+            }
+        }
+
       private:
 
+        template <class E, class... T>
+        static bool reads_neighbours_of_any(const E& e, const T*... data)
+        {
+            return (false || ... || detail::reads_neighbours_of(e, data));
+        }
+
         tuple_type m_fields;
     };
 } // namespace samurai
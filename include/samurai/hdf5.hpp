@@ -4,11 +4,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
+#include <cmath>
 #include <fstream>
 #include <functional>
+#include <limits>
+#include <optional>
+#include <stdexcept>
 #include <string>
 #include <type_traits>
+#include <vector>
 
 #include <filesystem>
 namespace fs = std::filesystem;
@@ -26,7 +32,10 @@ namespace fs = std::filesystem;
 #include <fmt/core.h>
 
 #include "algorithm.hpp"
+#include "box.hpp"
 #include "cell.hpp"
+#include "cell_array.hpp"
+#include "subset/subset_op.hpp"
 #include "utils.hpp"
 
 namespace samurai
@@ -71,20 +80,62 @@ namespace samurai
         };
     }
 
+    /**
+     * @brief Writes one component of a field restricted to a submesh into a 1D dataset.
+     *
+     * The cell indices of a submesh point into the field storage: each interval is a
+     * (possibly strided) range of field.array(). The ranges are gathered into a contiguous
+     * buffer, in the order of the traversal, which is written with a single H5Dwrite.
+     *
+     * @param dataset The dataset of size submesh.nb_cells() to fill.
+     * @param item The component of the field to write.
+     */
     template <class Field, class SubMesh>
-    auto extract_data(const Field& field, const SubMesh& submesh)
+    void write_field_item(HighFive::DataSet& dataset, const Field& field, const SubMesh& submesh, std::size_t item)
     {
-        std::array<std::size_t, 2> shape = {submesh.nb_cells(), field.size};
-        xt::xtensor<typename Field::value_type, 2> data(shape);
-        std::size_t index = 0;
-        for_each_cell(submesh,
-                      [&](auto cell)
-                      {
-                          xt::view(data, index) = field[cell.index];
-                          index++;
-                      });
+        using value_t = typename Field::value_type;
+
+        const auto& data = field.array();
+
+        // position of the value (cell, item) in the storage: item_offset + cell * cell_stride
+        std::size_t cell_stride = 1;
+        std::size_t item_offset = 0;
+        if constexpr (Field::size > 1)
+        {
+            if constexpr (Field::is_soa)
+            {
+                item_offset = item * data.shape()[1];
+            }
+            else
+            {
+                cell_stride = Field::size;
+                item_offset = item;
+            }
+        }
+
+        std::vector<value_t> buffer;
+        buffer.reserve(submesh.nb_cells());
+        const value_t* values = data.data() + item_offset;
+        for_each_interval(submesh,
+                          [&](std::size_t, const auto& i, const auto&)
+                          {
+                              auto first = static_cast<std::size_t>(i.index + i.start) * cell_stride;
+                              auto last  = static_cast<std::size_t>(i.index + i.end) * cell_stride;
+                              for (std::size_t k = first; k < last; k += cell_stride)
+                              {
+                                  buffer.push_back(values[k]);
+                              }
+                          });
+
+        if (buffer.empty())
+        {
+            return;
+        }
 
-        return data;
+        if (H5Dwrite(dataset.getId(), HighFive::AtomicType<value_t>().getId(), H5S_ALL, H5S_ALL, H5P_DEFAULT, buffer.data()) < 0)
+        {
+            throw std::runtime_error(fmt::format("HDF5 error while writing the dataset {}", dataset.getPath()));
+        }
     }
 
     template <class Mesh>
@@ -143,8 +194,37 @@ namespace samurai
         return std::make_pair(coords, connectivity);
     }
 
+    /**
+     * @brief Restriction of the output to a part of the mesh.
+     *
+     * Only the cells belonging to the levels [min_level, max_level], intersecting
+     * the region (if any) and selected by the subset function (if any) are saved.
+     * The subset function receives the cells of a level and returns the cells to
+     * keep, typically built from a subset expression:
+     *
+     *     options.subset = [&](const auto& lca)
+     *     {
+     *         return lca_t(intersection(lca, my_set).on(lca.level()));
+     *     };
+     */
+    template <std::size_t dim, class TInterval>
+    struct Hdf5Restriction
+    {
+        using lca_t = LevelCellArray<dim, TInterval>;
+
+        std::size_t min_level = 0;
+        std::size_t max_level = std::numeric_limits<std::size_t>::max();
+        std::optional<Box<double, dim>> region;
+        std::function<lca_t(const lca_t&)> subset;
+
+        bool is_restricted() const
+        {
+            return min_level > 0 || max_level != std::numeric_limits<std::size_t>::max() || region.has_value() || subset;
+        }
+    };
+
     template <class D>
-    struct Hdf5Options
+    struct Hdf5Options : public Hdf5Restriction<D::dim, typename D::interval_t>
     {
         Hdf5Options(bool level = false, bool mesh_id = false)
             : by_level(level)
@@ -160,7 +240,7 @@ namespace samurai
     class UniformMesh;
 
     template <class Config>
-    struct Hdf5Options<UniformMesh<Config>>
+    struct Hdf5Options<UniformMesh<Config>> : public Hdf5Restriction<Config::dim, typename Config::interval_t>
     {
         Hdf5Options(bool mesh_id = false)
             : by_mesh_id(mesh_id)
@@ -170,6 +250,70 @@ namespace samurai
         bool by_mesh_id;
     };
 
+    namespace detail
+    {
+        /**
+         * Returns the cells of lca kept by the restriction.
+         *
+         * The interval indices are copied from lca so that they still point
+         * into the storage of the fields defined on the original mesh.
+         */
+        template <std::size_t dim, class TInterval>
+        auto restrict_output(const LevelCellArray<dim, TInterval>& lca, const Hdf5Restriction<dim, TInterval>& restriction)
+        {
+            using lca_t   = LevelCellArray<dim, TInterval>;
+            using value_t = typename TInterval::value_t;
+            using box_t   = Box<value_t, dim>;
+
+            std::size_t level = lca.level();
+            if (lca.empty() || level < restriction.min_level || level > restriction.max_level)
+            {
+                return lca_t(level);
+            }
+
+            lca_t restricted = lca;
+            if (restriction.region)
+            {
+                // cells of the level intersecting the region
+                const double dx = cell_length(level);
+                typename box_t::point_t min_corner;
+                typename box_t::point_t max_corner;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    min_corner[d] = static_cast<value_t>(std::floor(restriction.region->min_corner()[d] / dx));
+                    max_corner[d] = static_cast<value_t>(std::ceil(restriction.region->max_corner()[d] / dx));
+                }
+                lca_t region_cells(level, box_t{min_corner, max_corner});
+                restricted = intersection(restricted, region_cells);
+            }
+            if (restriction.subset)
+            {
+                // the cells returned by the user must belong to lca
+                lca_t subset_cells = restriction.subset(restricted);
+                restricted         = intersection(subset_cells, lca);
+            }
+
+            auto expr = intersection(restricted, lca);
+            expr.apply_interval_index(
+                [&](const auto& interval_index)
+                {
+                    restricted[0][interval_index[0]].index = lca[0][interval_index[1]].index;
+                });
+            return restricted;
+        }
+
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        auto restrict_output(const CellArray<dim, TInterval, max_size>& ca, const Hdf5Restriction<dim, TInterval>& restriction)
+        {
+            CellArray<dim, TInterval, max_size> restricted;
+            for (std::size_t level = 0; level <= max_size; ++level)
+            {
+                restricted[level] = restrict_output(ca[level], restriction);
+            }
+            return restricted;
+        }
+    } // namespace detail
+
     template <class D>
     class Hdf5
     {
@@ -236,6 +380,9 @@ namespace samurai
         template <class Submesh>
         void save_fields(pugi::xml_node& grid, const std::string& prefix, const Submesh& submesh);
 
+        template <class Submesh>
+        void save_on_restricted_mesh(pugi::xml_node& grid_parent, const std::string& prefix, const Submesh& submesh, const std::string& mesh_name);
+
         template <class Submesh, std::size_t... I>
         void save_fields_impl(pugi::xml_node& grid, const std::string& prefix, const Submesh& submesh, std::index_sequence<I...>);
 
@@ -287,6 +434,23 @@ namespace samurai
         (void)std::initializer_list<int>{(this->save_field(grid, prefix, submesh, std::get<I>(m_fields)), 0)...};
     }
 
+    template <class D, class Mesh, class... T>
+    template <class Submesh>
+    inline void SaveBase<D, Mesh, T...>::save_on_restricted_mesh(pugi::xml_node& grid_parent,
+                                                                 const std::string& prefix,
+                                                                 const Submesh& submesh,
+                                                                 const std::string& mesh_name)
+    {
+        if (m_options.is_restricted())
+        {
+            this->save_on_mesh(grid_parent, prefix, detail::restrict_output(submesh, m_options), mesh_name);
+        }
+        else
+        {
+            this->save_on_mesh(grid_parent, prefix, submesh, mesh_name);
+        }
+    }
+
     template <class D, class Mesh, class... T>
     inline void SaveBase<D, Mesh, T...>::save()
     {
@@ -358,7 +522,8 @@ namespace samurai
             {
                 min_level--;
             }
-            auto max_level = this->mesh().max_level();
+            min_level      = std::max(min_level, this->options().min_level);
+            auto max_level = std::min(this->mesh().max_level(), this->options().max_level);
             for (std::size_t level = min_level; level <= max_level; ++level)
             {
                 auto grid_level                         = this->domain().append_child("Grid");
@@ -375,7 +540,7 @@ namespace samurai
                         {
                             std::string mesh_name = this->derived_cast().get_submesh_name(im);
                             std::string prefix    = fmt::format("/level/{}/mesh/{}", level, mesh_name);
-                            this->save_on_mesh(grid_level, prefix, submesh[level], mesh_name);
+                            this->save_on_restricted_mesh(grid_level, prefix, submesh[level], mesh_name);
                         }
                     }
                 }
@@ -384,7 +549,7 @@ namespace samurai
                     const auto& mesh = this->derived_cast().get_mesh();
 
                     std::string prefix = fmt::format("/level/{}/mesh", level);
-                    this->save_on_mesh(grid_level, prefix, mesh[level], "mesh");
+                    this->save_on_restricted_mesh(grid_level, prefix, mesh[level], "mesh");
                 }
             }
         }
@@ -402,7 +567,7 @@ namespace samurai
                     grid_mesh_id.append_attribute("Name")     = mesh_name.data();
                     grid_mesh_id.append_attribute("GridType") = "Collection";
 
-                    this->save_on_mesh(grid_mesh_id, prefix, submesh, mesh_name);
+                    this->save_on_restricted_mesh(grid_mesh_id, prefix, submesh, mesh_name);
                 }
             }
             else
@@ -410,7 +575,7 @@ namespace samurai
                 const auto& mesh = this->derived_cast().get_mesh();
 
                 std::string prefix = fmt::format("/mesh");
-                this->save_on_mesh(this->domain(), prefix, mesh, "mesh");
+                this->save_on_restricted_mesh(this->domain(), prefix, mesh, "mesh");
             }
         }
     }
@@ -456,7 +621,7 @@ namespace samurai
                 grid_mesh_id.append_attribute("Name")     = mesh_name.data();
                 grid_mesh_id.append_attribute("GridType") = "Collection";
 
-                this->save_on_mesh(grid_mesh_id, prefix, submesh, mesh_name);
+                this->save_on_restricted_mesh(grid_mesh_id, prefix, submesh, mesh_name);
             }
         }
         else
@@ -464,7 +629,7 @@ namespace samurai
             const auto& mesh = this->derived_cast().get_mesh();
 
             std::string prefix = fmt::format("/mesh");
-            this->save_on_mesh(this->domain(), prefix, mesh, "mesh");
+            this->save_on_restricted_mesh(this->domain(), prefix, mesh, "mesh");
         }
     }
 
@@ -530,8 +695,6 @@ namespace samurai
     template <class Submesh, class Field>
     inline void Hdf5<D>::save_field(pugi::xml_node& grid, const std::string& prefix, const Submesh& submesh, const Field& field)
     {
-        auto data = extract_data(field, submesh);
-
         for (std::size_t i = 0; i < field.size; ++i)
         {
             std::string field_name;
@@ -544,7 +707,8 @@ namespace samurai
                 field_name = fmt::format("{}_{}", field.name(), i);
             }
             std::string path = fmt::format("{}/fields/{}", prefix, field_name);
-            H5Easy::dump(h5_file, path, xt::eval(xt::view(data, xt::all(), i)));
+            auto dataset     = h5_file.createDataSet<typename Field::value_type>(path, HighFive::DataSpace({submesh.nb_cells()}));
+            write_field_item(dataset, field, submesh, i);
 
             auto attribute                       = grid.append_child("Attribute");
             attribute.append_attribute("Name")   = field_name.data();
@@ -0,0 +1,9 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+#include "lbm/collision.hpp"
+#include "lbm/lattice.hpp"
+#include "lbm/scheme.hpp"
+#include "lbm/streaming.hpp"
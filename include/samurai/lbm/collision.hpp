@@ -0,0 +1,210 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace samurai
+{
+    namespace lbm
+    {
+        /**
+         * Moments of a block of n consecutive cells: (p, x) is the moment p of the cell x, stored with unit stride along the cells.
+         */
+        template <std::size_t nvel>
+        struct moments_block
+        {
+            std::array<double*, nvel> rows;
+            std::size_t n;
+
+            inline double& operator()(std::size_t p, std::size_t x) const
+            {
+                return rows[p][x];
+            }
+        };
+
+        /**
+         * Function of a block of cells, called with moments_block<nvel> arguments (see block()).
+         */
+        template <class F>
+        struct block_function
+        {
+            F function;
+
+            template <class... Args>
+            inline decltype(auto) operator()(Args&&... args)
+            {
+                return function(std::forward<Args>(args)...);
+            }
+        };
+
+        /**
+         * @brief Marks a collision or an equilibrium as a function of a block of cells (moments_block<nvel> arguments)
+         * instead of a function of the moments of one cell (std::array<double, nvel> arguments).
+         */
+        template <class F>
+        auto block(F&& f)
+        {
+            return block_function<std::decay_t<F>>{std::forward<F>(f)};
+        }
+
+        namespace detail
+        {
+            /**
+             * @brief out[p][x] = sum over alpha of a[p][alpha] * in[alpha][x], for 0 <= x < n.
+             * The size of the matrix is known at compile time and the inner loops run along the cells, where they vectorize.
+             */
+            template <std::size_t nvel, class out_t>
+            void apply_matrix(const std::array<std::array<double, nvel>, nvel>& a,
+                              const std::array<const double*, nvel>& in,
+                              const std::array<out_t*, nvel>& out,
+                              std::size_t n)
+            {
+                for (std::size_t p = 0; p < nvel; ++p)
+                {
+                    out_t* out_p = out[p];
+                    std::fill(out_p, out_p + n, out_t{0});
+                    for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                    {
+                        double coeff = a[p][alpha];
+                        if (coeff != 0)
+                        {
+                            const double* in_alpha = in[alpha];
+                            for (std::size_t x = 0; x < n; ++x)
+                            {
+                                out_p[x] += static_cast<out_t>(coeff * in_alpha[x]);
+                            }
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Whether a collision or an equilibrium processes a block of cells: block_function and mrt.
+             */
+            template <class T>
+            struct is_block : std::false_type
+            {
+            };
+
+            template <class F>
+            struct is_block<block_function<F>> : std::true_type
+            {
+            };
+
+            template <class T>
+            inline constexpr bool is_block_v = is_block<std::decay_t<T>>::value;
+        }
+
+        /**
+         * Multiple relaxation times collision: m_p <- m_p + s_p (m_eq_p - m_p) on a block of cells.
+         * The equilibrium is either computed cell by cell, by
+         *
+         *   equilibrium(const std::array<double, nvel>& m, std::array<double, nvel>& m_eq),
+         *
+         * or on the whole block, by equilibrium(const moments_block<nvel>& m, const moments_block<nvel>& m_eq) wrapped by block().
+         * The relaxation itself runs along the cells. The conserved moments have a relaxation rate 0.
+         */
+        template <std::size_t nvel, class Equilibrium>
+        class mrt
+        {
+          public:
+
+            mrt(const std::array<double, nvel>& rates, Equilibrium equilibrium)
+                : m_rates(rates)
+                , m_equilibrium(std::move(equilibrium))
+            {
+            }
+
+            const std::array<double, nvel>& rates() const
+            {
+                return m_rates;
+            }
+
+            void operator()(const moments_block<nvel>& m)
+            {
+                m_buffer.resize(nvel * m.n);
+                moments_block<nvel> m_eq{{}, m.n};
+                for (std::size_t p = 0; p < nvel; ++p)
+                {
+                    m_eq.rows[p] = m_buffer.data() + p * m.n;
+                }
+
+                if constexpr (detail::is_block_v<Equilibrium>)
+                {
+                    m_equilibrium(m, m_eq);
+                }
+                else
+                {
+                    std::array<double, nvel> m_cell;
+                    std::array<double, nvel> m_eq_cell;
+                    for (std::size_t x = 0; x < m.n; ++x)
+                    {
+                        for (std::size_t p = 0; p < nvel; ++p)
+                        {
+                            m_cell[p] = m(p, x);
+                        }
+                        m_equilibrium(m_cell, m_eq_cell);
+                        for (std::size_t p = 0; p < nvel; ++p)
+                        {
+                            m_eq(p, x) = m_eq_cell[p];
+                        }
+                    }
+                }
+
+                for (std::size_t p = 0; p < nvel; ++p)
+                {
+                    double s = m_rates[p];
+                    if (s != 0)
+                    {
+                        double* m_p          = m.rows[p];
+                        const double* m_eq_p = m_eq.rows[p];
+                        for (std::size_t x = 0; x < m.n; ++x)
+                        {
+                            m_p[x] += s * (m_eq_p[x] - m_p[x]);
+                        }
+                    }
+                }
+            }
+
+          private:
+
+            std::array<double, nvel> m_rates;
+            Equilibrium m_equilibrium;
+            std::vector<double> m_buffer;
+        };
+
+        namespace detail
+        {
+            template <std::size_t nvel, class Equilibrium>
+            struct is_block<mrt<nvel, Equilibrium>> : std::true_type
+            {
+            };
+        }
+
+        template <std::size_t nvel, class Equilibrium>
+        auto make_mrt(const std::array<double, nvel>& rates, Equilibrium&& equilibrium)
+        {
+            return mrt<nvel, std::decay_t<Equilibrium>>(rates, std::forward<Equilibrium>(equilibrium));
+        }
+
+        /**
+         * @brief Single relaxation time collision f <- f + omega (f_eq - f), written on the moments:
+         * the equilibrium must return the conserved moments unchanged.
+         */
+        template <std::size_t nvel, class Equilibrium>
+        auto make_bgk(double omega, Equilibrium&& equilibrium)
+        {
+            std::array<double, nvel> rates;
+            rates.fill(omega);
+            return make_mrt<nvel>(rates, std::forward<Equilibrium>(equilibrium));
+        }
+    } // end namespace lbm
+} // end namespace samurai
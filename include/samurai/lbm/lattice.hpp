@@ -0,0 +1,243 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <stdexcept>
+#include <utility>
+
+#include <fmt/format.h>
+
+namespace samurai
+{
+    namespace lbm
+    {
+        /**
+         * Lattice of a lattice Boltzmann scheme: the integer velocities c_alpha (in cells per time step at the finest level)
+         * and the matrix M of the moments m = M f, with its inverse.
+         */
+        template <std::size_t dim_, std::size_t nvel_>
+        class lattice
+        {
+          public:
+
+            static constexpr std::size_t dim  = dim_;
+            static constexpr std::size_t nvel = nvel_;
+
+            using velocity_t = std::array<int, dim>;
+            using matrix_t   = std::array<std::array<double, nvel>, nvel>;
+
+            lattice(const std::array<velocity_t, nvel>& velocities, const matrix_t& moments)
+                : m_velocities(velocities)
+                , m_moments(moments)
+                , m_inverse(inverse(moments))
+            {
+            }
+
+            const velocity_t& velocity(std::size_t alpha) const
+            {
+                return m_velocities[alpha];
+            }
+
+            const std::array<velocity_t, nvel>& velocities() const
+            {
+                return m_velocities;
+            }
+
+            /**
+             * @brief The matrix M: moment p = sum over alpha of M[p][alpha] * f_alpha.
+             */
+            const matrix_t& moments() const
+            {
+                return m_moments;
+            }
+
+            const matrix_t& inverse_moments() const
+            {
+                return m_inverse;
+            }
+
+          private:
+
+            /**
+             * @brief Gauss-Jordan elimination with partial pivoting.
+             */
+            static matrix_t inverse(matrix_t a)
+            {
+                matrix_t inv{};
+                for (std::size_t p = 0; p < nvel; ++p)
+                {
+                    inv[p][p] = 1;
+                }
+
+                for (std::size_t col = 0; col < nvel; ++col)
+                {
+                    std::size_t pivot = col;
+                    for (std::size_t row = col + 1; row < nvel; ++row)
+                    {
+                        if (std::abs(a[row][col]) > std::abs(a[pivot][col]))
+                        {
+                            pivot = row;
+                        }
+                    }
+                    if (std::abs(a[pivot][col]) < 1e-14)
+                    {
+                        throw std::invalid_argument(fmt::format("LBM ERROR: the matrix of the moments is singular (column {})", col));
+                    }
+                    std::swap(a[col], a[pivot]);
+                    std::swap(inv[col], inv[pivot]);
+
+                    double inv_pivot = 1. / a[col][col];
+                    for (std::size_t c = 0; c < nvel; ++c)
+                    {
+                        a[col][c] *= inv_pivot;
+                        inv[col][c] *= inv_pivot;
+                    }
+                    for (std::size_t row = 0; row < nvel; ++row)
+                    {
+                        double factor = a[row][col];
+                        if (row != col && factor != 0)
+                        {
+                            for (std::size_t c = 0; c < nvel; ++c)
+                            {
+                                a[row][c] -= factor * a[col][c];
+                                inv[row][c] -= factor * inv[col][c];
+                            }
+                        }
+                    }
+                }
+                return inv;
+            }
+
+            std::array<velocity_t, nvel> m_velocities;
+            matrix_t m_moments;
+            matrix_t m_inverse;
+        };
+
+        /**
+         * @brief Lattice with polynomial moments: the moment p is the sum over alpha of prod_d (lambda c_alpha[d])^exponents[p][d] f_alpha.
+         */
+        template <std::size_t dim, std::size_t nvel>
+        auto make_lattice(const std::array<std::array<int, dim>, nvel>& velocities,
+                          const std::array<std::array<int, dim>, nvel>& exponents,
+                          double lambda)
+        {
+            typename lattice<dim, nvel>::matrix_t moments;
+            for (std::size_t p = 0; p < nvel; ++p)
+            {
+                for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                {
+                    double m = 1;
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        m *= std::pow(lambda * velocities[alpha][d], exponents[p][d]);
+                    }
+                    moments[p][alpha] = m;
+                }
+            }
+            return lattice<dim, nvel>(velocities, moments);
+        }
+
+        /**
+         * @brief Lattice of n independent copies of a lattice, with block-diagonal moments (D2Q4444 = stack<4>(D2Q4(lambda))).
+         * The velocities of the copy b are alpha + b * nvel.
+         */
+        template <std::size_t n, std::size_t dim, std::size_t nvel>
+        auto stack(const lattice<dim, nvel>& l)
+        {
+            std::array<std::array<int, dim>, n * nvel> velocities;
+            typename lattice<dim, n * nvel>::matrix_t moments{};
+            for (std::size_t b = 0; b < n; ++b)
+            {
+                for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                {
+                    velocities[b * nvel + alpha] = l.velocity(alpha);
+                    for (std::size_t p = 0; p < nvel; ++p)
+                    {
+                        moments[b * nvel + p][b * nvel + alpha] = l.moments()[p][alpha];
+                    }
+                }
+            }
+            return lattice<dim, n * nvel>(velocities, moments);
+        }
+
+        /**
+         * @brief Moments: density, lambda * momentum.
+         */
+        inline auto D1Q2(double lambda)
+        {
+            return make_lattice<1, 2>({{{1}, {-1}}}, {{{0}, {1}}}, lambda);
+        }
+
+        /**
+         * @brief Moments: 1, lambda c, (lambda c)^2.
+         */
+        inline auto D1Q3(double lambda)
+        {
+            return make_lattice<1, 3>({{{0}, {1}, {-1}}}, {{{0}, {1}, {2}}}, lambda);
+        }
+
+        /**
+         * @brief Moments: (lambda c)^p, 0 <= p < 5.
+         */
+        inline auto D1Q5(double lambda)
+        {
+            return make_lattice<1, 5>({{{0}, {1}, {-1}, {2}, {-2}}}, {{{0}, {1}, {2}, {3}, {4}}}, lambda);
+        }
+
+        /**
+         * @brief Velocities (1, 0), (0, 1), (-1, 0), (0, -1). Moments: 1, lambda cx, lambda cy, lambda^2 (cx^2 - cy^2).
+         */
+        inline auto D2Q4(double lambda)
+        {
+            lattice<2, 4>::matrix_t moments;
+            std::array<std::array<int, 2>, 4> velocities{
+                {{1, 0}, {0, 1}, {-1, 0}, {0, -1}}
+            };
+            for (std::size_t alpha = 0; alpha < 4; ++alpha)
+            {
+                double cx = lambda * velocities[alpha][0];
+                double cy = lambda * velocities[alpha][1];
+
+                moments[0][alpha] = 1;
+                moments[1][alpha] = cx;
+                moments[2][alpha] = cy;
+                moments[3][alpha] = cx * cx - cy * cy;
+            }
+            return lattice<2, 4>(velocities, moments);
+        }
+
+        /**
+         * @brief Velocities (0, 0), (1, 0), (0, 1), (-1, 0), (0, -1), (1, 1), (-1, 1), (-1, -1), (1, -1).
+         * Moments: 1, cx, cy, |c|^2, cx^2 - cy^2, cx cy, cx |c|^2, cy |c|^2, |c|^4, with c scaled by lambda.
+         */
+        inline auto D2Q9(double lambda)
+        {
+            lattice<2, 9>::matrix_t moments;
+            std::array<std::array<int, 2>, 9> velocities{
+                {{0, 0}, {1, 0}, {0, 1}, {-1, 0}, {0, -1}, {1, 1}, {-1, 1}, {-1, -1}, {1, -1}}
+            };
+            for (std::size_t alpha = 0; alpha < 9; ++alpha)
+            {
+                double cx = lambda * velocities[alpha][0];
+                double cy = lambda * velocities[alpha][1];
+                double c2 = cx * cx + cy * cy;
+
+                moments[0][alpha] = 1;
+                moments[1][alpha] = cx;
+                moments[2][alpha] = cy;
+                moments[3][alpha] = c2;
+                moments[4][alpha] = cx * cx - cy * cy;
+                moments[5][alpha] = cx * cy;
+                moments[6][alpha] = cx * c2;
+                moments[7][alpha] = cy * c2;
+                moments[8][alpha] = c2 * c2;
+            }
+            return lattice<2, 9>(velocities, moments);
+        }
+    } // end namespace lbm
+} // end namespace samurai
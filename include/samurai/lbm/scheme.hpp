@@ -0,0 +1,319 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <xtensor/xfixed.hpp>
+
+#include "../algorithm.hpp"
+#include "../algorithm/update.hpp"
+#include "../numeric/field_row.hpp"
+#include "collision.hpp"
+#include "lattice.hpp"
+#include "streaming.hpp"
+
+namespace samurai
+{
+    namespace lbm
+    {
+        namespace detail
+        {
+            struct scratch_field_base
+            {
+                virtual ~scratch_field_base() = default;
+            };
+
+            /**
+             * @brief Field of the new values of a step, kept by the scheme between the steps and resized when the mesh is adapted.
+             */
+            template <class Field>
+            struct scratch_field : public scratch_field_base
+            {
+                explicit scratch_field(typename Field::mesh_t& mesh)
+                    : field("new_f", mesh)
+                    , generation(mesh.generation())
+                {
+                }
+
+                Field field;
+                std::size_t generation;
+            };
+        }
+
+        /**
+         * Multiresolution lattice Boltzmann scheme: one time step is a streaming followed by a collision on every leaf of the mesh.
+         *
+         * The streaming of a leaf at level l is computed at the finest level of the mesh, from the prediction of the values
+         * around the leaf (see streaming_stencil): the stencils depend only on max_level - l and on the velocity, and are built once.
+         * The ghosts of the leaves are updated by update_ghost_mr() at the beginning of the step, with the boundary conditions
+         * of the field; the mesh must have ghosts as wide as the stencils.
+         *
+         * The collision is done in the space of the moments m = M f (see lattice). It is either a collision of a block of cells,
+         * called with a moments_block<nvel> (see mrt, make_bgk and block), or a function
+         *
+         *   collision(std::array<double, nvel>& m)
+         *
+         * that relaxes the moments of one cell, in place. The streaming, the change of variables and the collision of an interval
+         * of leaves are fused: the interval is processed by blocks of cells, whose values are read once and written once,
+         * and the loops run along the cells.
+         * The new values are computed in a scratch field owned by the scheme, whose storage is then swapped with the one of f.
+         */
+        template <class Lattice, std::size_t prediction_order = 1>
+        class scheme
+        {
+          public:
+
+            static constexpr std::size_t dim  = Lattice::dim;
+            static constexpr std::size_t nvel = Lattice::nvel;
+
+            explicit scheme(const Lattice& lattice)
+                : m_lattice(lattice)
+            {
+            }
+
+            const Lattice& lattice() const
+            {
+                return m_lattice;
+            }
+
+            /**
+             * @brief Streaming stencils of the velocities on the leaves delta_l levels above the finest level.
+             */
+            template <class value_t>
+            const std::array<streaming_stencil<dim, value_t>, nvel>& stencils(std::size_t delta_l);
+
+            template <class Field, class Collision>
+            void step(Field& f, Collision&& collision);
+
+          private:
+
+            template <class Field>
+            Field& scratch(typename Field::mesh_t& mesh);
+
+            template <class Field, class Collision, class interval_t, class index_t>
+            void stream_and_collide(const Field& f,
+                                    Field& new_f,
+                                    Collision& collision,
+                                    std::size_t level,
+                                    std::size_t delta_l,
+                                    const interval_t& i,
+                                    const index_t& index);
+
+            Lattice m_lattice;
+            std::vector<std::array<streaming_stencil<dim, default_config::value_t>, nvel>> m_stencils;
+            std::vector<bool> m_built;
+            std::unique_ptr<detail::scratch_field_base> m_scratch;
+
+            // Work arrays of a block of cells: advected values and moments, stored by velocity (resp. moment) then by cell
+            static constexpr std::size_t block_size = 256;
+            std::vector<double> m_advected;
+            std::vector<double> m_moments;
+        };
+
+        template <class Lattice, std::size_t prediction_order>
+        template <class value_t>
+        auto scheme<Lattice, prediction_order>::stencils(std::size_t delta_l) -> const std::array<streaming_stencil<dim, value_t>, nvel>&
+        {
+            static_assert(std::is_same_v<value_t, default_config::value_t>, "the streaming stencils use the default interval value type");
+
+            if (delta_l >= m_stencils.size())
+            {
+                m_stencils.resize(delta_l + 1);
+                m_built.resize(delta_l + 1, false);
+            }
+            if (!m_built[delta_l])
+            {
+                for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                {
+                    m_stencils[delta_l][alpha] = make_streaming_stencil<prediction_order, dim, value_t>(delta_l, m_lattice.velocity(alpha));
+                }
+                m_built[delta_l] = true;
+            }
+            return m_stencils[delta_l];
+        }
+
+        template <class Lattice, std::size_t prediction_order>
+        template <class Field>
+        Field& scheme<Lattice, prediction_order>::scratch(typename Field::mesh_t& mesh)
+        {
+            auto* s = dynamic_cast<detail::scratch_field<Field>*>(m_scratch.get());
+            if (s == nullptr || &s->field.mesh() != &mesh)
+            {
+                m_scratch = std::make_unique<detail::scratch_field<Field>>(mesh);
+                s         = static_cast<detail::scratch_field<Field>*>(m_scratch.get());
+            }
+            else if (s->generation != mesh.generation())
+            {
+                s->field.resize();
+                s->generation = mesh.generation();
+            }
+            return s->field;
+        }
+
+        /**
+         * @brief One time step of the scheme on the field f of the distribution functions (f_alpha is the component alpha).
+         */
+        template <class Lattice, std::size_t prediction_order>
+        template <class Field, class Collision>
+        void scheme<Lattice, prediction_order>::step(Field& f, Collision&& collision)
+        {
+            static_assert(Field::size == nvel, "the field must have one component per velocity of the lattice");
+            static_assert(Field::dim == dim, "the field and the lattice must have the same dimension");
+
+            using mesh_id_t  = typename Field::mesh_t::mesh_id_t;
+            using value_t    = typename Field::interval_t::value_t;
+            auto& mesh       = f.mesh();
+            auto max_level   = mesh.max_level();
+            auto ghost_width = static_cast<value_t>(Field::mesh_t::config::ghost_width);
+
+            for (std::size_t level = mesh.min_level(); level <= max_level; ++level)
+            {
+                for (const auto& stencil : stencils<value_t>(max_level - level))
+                {
+                    if (stencil.radius > ghost_width)
+                    {
+                        throw std::runtime_error(
+                            fmt::format("LBM ERROR on level {}: the radius {} of the streaming stencil is larger than the ghost width {}",
+                                        level,
+                                        stencil.radius,
+                                        ghost_width));
+                    }
+                }
+            }
+
+            update_ghost_mr(f);
+
+            auto& new_f = scratch<Field>(mesh);
+            for_each_interval(mesh[mesh_id_t::cells],
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  stream_and_collide(f, new_f, collision, level, max_level - level, i, index);
+                              });
+            std::swap(f.array(), new_f.array());
+        }
+
+        template <class Lattice, std::size_t prediction_order>
+        template <class Field, class Collision, class interval_t, class index_t>
+        void scheme<Lattice, prediction_order>::stream_and_collide(const Field& f,
+                                                                   Field& new_f,
+                                                                   Collision& collision,
+                                                                   std::size_t level,
+                                                                   std::size_t delta_l,
+                                                                   const interval_t& i,
+                                                                   const index_t& index)
+        {
+            using value_t = typename interval_t::value_t;
+
+            const auto& stencils_l = stencils<value_t>(delta_l);
+            auto new_row           = samurai::detail::make_field_row(new_f, level, i, index);
+
+            m_advected.resize(nvel * block_size);
+            m_moments.resize(nvel * block_size);
+            std::array<const double*, nvel> advected;
+            std::array<double*, nvel> advected_out;
+            moments_block<nvel> moments{{}, 0};
+            std::array<const double*, nvel> moments_in;
+            for (std::size_t p = 0; p < nvel; ++p)
+            {
+                advected_out[p] = m_advected.data() + p * block_size;
+                advected[p]     = advected_out[p];
+                moments.rows[p] = m_moments.data() + p * block_size;
+                moments_in[p]   = moments.rows[p];
+            }
+
+            // Blocks of cells of the interval, small enough for the work arrays to stay in cache
+            for (value_t block_start = i.start; block_start < i.end; block_start += static_cast<value_t>(block_size))
+            {
+                interval_t block{block_start, std::min(i.end, block_start + static_cast<value_t>(block_size))};
+                const std::size_t n = block.size();
+                auto first          = static_cast<std::ptrdiff_t>(block_start - i.start);
+
+                // Streaming: advected[alpha][x] = sum of the stencil terms, row by row
+                for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                {
+                    const auto& stencil = stencils_l[alpha];
+                    double* adv         = advected_out[alpha];
+                    std::fill(adv, adv + n, 0.);
+                    for (std::size_t r = 0; r < stencil.rows.size(); ++r)
+                    {
+                        interval_t row_i{block.start - stencil.radius, block.end + stencil.radius};
+                        xt::xtensor_fixed<value_t, xt::xshape<dim - 1>> row_index = index;
+                        for (std::size_t d = 0; d < dim - 1; ++d)
+                        {
+                            row_index[d] += stencil.rows[r][d];
+                        }
+                        auto row = samurai::detail::make_field_row(f, level, row_i, row_index);
+
+                        for (std::size_t s = 0; s < stencil.x_offsets.size(); ++s)
+                        {
+                            double weight = stencil.row_weights[r] * stencil.x_weights[s];
+                            auto shift    = static_cast<std::ptrdiff_t>(stencil.x_offsets[s] + stencil.radius);
+                            for (std::size_t x = 0; x < n; ++x)
+                            {
+                                adv[x] += weight * row(static_cast<std::ptrdiff_t>(x) + shift, alpha);
+                            }
+                        }
+                    }
+                }
+
+                detail::apply_matrix(m_lattice.moments(), advected, moments.rows, n);
+
+                moments.n = n;
+                if constexpr (detail::is_block_v<Collision>)
+                {
+                    collision(std::as_const(moments));
+                }
+                else
+                {
+                    std::array<double, nvel> m_cell;
+                    for (std::size_t x = 0; x < n; ++x)
+                    {
+                        for (std::size_t p = 0; p < nvel; ++p)
+                        {
+                            m_cell[p] = moments(p, x);
+                        }
+                        collision(m_cell);
+                        for (std::size_t p = 0; p < nvel; ++p)
+                        {
+                            moments(p, x) = m_cell[p];
+                        }
+                    }
+                }
+
+                // Back to the distribution functions, directly in the new field when its cells are contiguous (scalar and SOA fields)
+                if (new_row.cell_stride == 1)
+                {
+                    std::array<typename Field::value_type*, nvel> out;
+                    for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                    {
+                        out[alpha] = &new_row(first, alpha);
+                    }
+                    detail::apply_matrix(m_lattice.inverse_moments(), moments_in, out, n);
+                }
+                else
+                {
+                    detail::apply_matrix(m_lattice.inverse_moments(), moments_in, advected_out, n);
+                    for (std::size_t x = 0; x < n; ++x)
+                    {
+                        for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                        {
+                            new_row(first + static_cast<std::ptrdiff_t>(x), alpha) = advected[alpha][x];
+                        }
+                    }
+                }
+            }
+        }
+    } // end namespace lbm
+} // end namespace samurai
@@ -0,0 +1,113 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdlib>
+#include <iterator>
+#include <map>
+#include <vector>
+
+#include "../reconstruction.hpp"
+#include "../samurai_config.hpp"
+
+namespace samurai
+{
+    namespace lbm
+    {
+        /**
+         * Streaming of a velocity c on a leaf at delta_l levels above the finest level of the mesh.
+         * The leaf is virtually split into its 2^(dim delta_l) descendants at the finest level, which are predicted
+         * from the values around the leaf; each descendant takes the value of the finest cell at -c, and the leaf takes
+         * the mean of its descendants. This is a linear combination of the values of the cells around the leaf at its level:
+         *
+         *   f_new(i, index) = sum over r, s of row_weights[r] * x_weights[s] * f(i + x_offsets[s], index + rows[r]),
+         *
+         * where the rows are the transverse offsets of the stencil (a single empty row in 1D).
+         * The prediction and the mean over the descendants being tensor products, so is the stencil.
+         */
+        template <std::size_t dim, class value_t = default_config::value_t>
+        struct streaming_stencil
+        {
+            std::vector<value_t> x_offsets;
+            std::vector<double> x_weights;
+            std::vector<std::array<value_t, dim - 1>> rows;
+            std::vector<double> row_weights;
+            value_t radius = 0;
+        };
+
+        namespace detail
+        {
+            /**
+             * @brief 1D streaming of the velocity c on a cell delta_l levels above the finest one (offsets at the level of the cell).
+             */
+            template <std::size_t order, class value_t>
+            std::map<value_t, double> streaming_stencil_1d(std::size_t delta_l, int c)
+            {
+                const auto& table = get_prediction_table<order, value_t>(delta_l);
+                auto n_fine_cells = value_t{1} << delta_l;
+                double inv_n_fine = 1. / static_cast<double>(n_fine_cells);
+                std::map<value_t, double> coeffs;
+                for (value_t y = 0; y < n_fine_cells; ++y)
+                {
+                    auto [ii, coarse] = samurai::detail::split_fine_index(delta_l, static_cast<value_t>(y - c));
+                    for (std::size_t s = 0; s < table.size(ii); ++s)
+                    {
+                        coeffs[coarse + table.offsets(ii)[s]] += inv_n_fine * table.weights(ii)[s];
+                    }
+                }
+                for (auto it = coeffs.begin(); it != coeffs.end();)
+                {
+                    it = (std::abs(it->second) < 1e-15) ? coeffs.erase(it) : std::next(it);
+                }
+                return coeffs;
+            }
+        }
+
+        template <std::size_t order, std::size_t dim, class value_t = default_config::value_t>
+        streaming_stencil<dim, value_t> make_streaming_stencil(std::size_t delta_l, const std::array<int, dim>& velocity)
+        {
+            streaming_stencil<dim, value_t> stencil;
+
+            for (const auto& [offset, weight] : detail::streaming_stencil_1d<order, value_t>(delta_l, velocity[0]))
+            {
+                stencil.x_offsets.push_back(offset);
+                stencil.x_weights.push_back(weight);
+                stencil.radius = std::max(stencil.radius, static_cast<value_t>(std::abs(offset)));
+            }
+
+            // Tensor product of the transverse 1D stencils
+            stencil.rows.push_back({});
+            stencil.row_weights.push_back(1.);
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                auto coeffs = detail::streaming_stencil_1d<order, value_t>(delta_l, velocity[d]);
+                for (const auto& term : coeffs)
+                {
+                    stencil.radius = std::max(stencil.radius, static_cast<value_t>(std::abs(term.first)));
+                }
+
+                std::vector<std::array<value_t, dim - 1>> rows;
+                std::vector<double> row_weights;
+                for (std::size_t r = 0; r < stencil.rows.size(); ++r)
+                {
+                    for (const auto& [offset, weight] : coeffs)
+                    {
+                        auto row   = stencil.rows[r];
+                        row[d - 1] = offset;
+                        rows.push_back(row);
+                        row_weights.push_back(stencil.row_weights[r] * weight);
+                    }
+                }
+                std::swap(stencil.rows, rows);
+                std::swap(stencil.row_weights, row_weights);
+            }
+            return stencil;
+        }
+    } // end namespace lbm
+} // end namespace samurai
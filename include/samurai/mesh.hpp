@@ -5,6 +5,7 @@
 #pragma once
 
 #include <array>
+#include <atomic>
 
 #include <fmt/format.h>
 
@@ -71,6 +72,7 @@ namespace samurai
         const ca_type& get_union() const;
         bool is_periodic(std::size_t d) const;
         const std::array<bool, dim>& periodicity() const;
+        std::size_t generation() const;
 
         void swap(Mesh_base& mesh) noexcept;
 
@@ -92,6 +94,7 @@ namespace samurai
 
         Mesh_base(const cl_type& cl, std::size_t min_level, std::size_t max_level);
         Mesh_base(const cl_type& cl, std::size_t min_level, std::size_t max_level, const std::array<bool, dim>& periodic);
+        Mesh_base(const cl_type& cl, const lca_type& domain, std::size_t min_level, std::size_t max_level);
         Mesh_base(const samurai::Box<double, dim>& b, std::size_t start_level, std::size_t min_level, std::size_t max_level);
         Mesh_base(const samurai::Box<double, dim>& b,
                   std::size_t start_level,
@@ -112,12 +115,15 @@ namespace samurai
         void update_sub_mesh();
         void renumbering();
 
+        static std::size_t new_generation();
+
         lca_type m_domain;
         std::size_t m_min_level;
         std::size_t m_max_level;
         std::array<bool, dim> m_periodic;
         mesh_t m_cells;
         ca_type m_union;
+        std::size_t m_generation = new_generation(); // identifies the cell structure, follows it through swap()
     };
 
     template <class D, class Config>
@@ -208,6 +214,22 @@ namespace samurai
         renumbering();
     }
 
+    template <class D, class Config>
+    inline Mesh_base<D, Config>::Mesh_base(const cl_type& cl, const lca_type& domain, std::size_t min_level, std::size_t max_level)
+        : m_domain{domain}
+        , m_min_level{min_level}
+        , m_max_level{max_level}
+    {
+        assert(min_level <= max_level);
+        m_periodic.fill(false);
+
+        m_cells[mesh_id_t::cells] = {cl, false};
+
+        construct_union();
+        update_sub_mesh();
+        renumbering();
+    }
+
     template <class D, class Config>
     inline auto Mesh_base<D, Config>::cells() -> mesh_t&
     {
@@ -303,6 +325,26 @@ namespace samurai
         return m_periodic;
     }
 
+    /**
+     * @brief Returns an identifier of the cell structure of the mesh.
+     *
+     * Every newly constructed mesh gets a new generation and swap() exchanges it with the cells,
+     * so that two equal generations mean that the cells (hence the storage indices) are unchanged.
+     * It is used to reuse data built on a mesh (e.g. a matrix structure) as long as the mesh has not been adapted.
+     */
+    template <class D, class Config>
+    inline std::size_t Mesh_base<D, Config>::generation() const
+    {
+        return m_generation;
+    }
+
+    template <class D, class Config>
+    inline std::size_t Mesh_base<D, Config>::new_generation()
+    {
+        static std::atomic<std::size_t> counter{0};
+        return ++counter;
+    }
+
     template <class D, class Config>
     inline void Mesh_base<D, Config>::swap(Mesh_base<D, Config>& mesh) noexcept
     {
@@ -312,6 +354,7 @@ namespace samurai
         swap(m_union, mesh.m_union);
         swap(m_max_level, mesh.m_max_level);
         swap(m_min_level, mesh.m_min_level);
+        swap(m_generation, mesh.m_generation);
     }
 
     template <class D, class Config>
@@ -0,0 +1,8 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+#include "mpi/adapt.hpp"
+#include "mpi/mesh.hpp"
+#include "mpi/partition.hpp"
@@ -0,0 +1,102 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <stdexcept>
+#include <tuple>
+
+#include <mpi.h>
+
+#include "../graduation.hpp"
+#include "../mr/adapt.hpp"
+#include "mesh.hpp"
+
+namespace samurai
+{
+    namespace mpi
+    {
+        /**
+         * Multiresolution adaptation of fields defined on the local mesh of a distributed mesh, then repartition of the leaves
+         * among the processes (see DistributedMesh::repartition). Collective.
+         *
+         * Each iteration of the adaptation runs on the local mesh as on a single process, then the halo is rebuilt from the leaves
+         * and the values of the owners of its cells (see DistributedMesh::update_halo): the next iteration starts from the
+         * decisions of the owners. The adaptation stops once no process changes its mesh and the local decisions agree with
+         * the owners in every halo. The mesh is then checked to be graded across the boundaries of the parts.
+         */
+        template <class Mesh, class... TFields>
+        class Adapt
+        {
+          public:
+
+            Adapt(DistributedMesh<Mesh>& mesh, TFields&... fields);
+
+            void operator()(double eps, double regularity);
+
+          private:
+
+            DistributedMesh<Mesh>& m_mesh;   // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+            std::tuple<TFields&...> m_fields; // NOLINT(cppcoreguidelines-avoid-const-or-ref-data-members)
+            samurai::Adapt<TFields...> m_adapt;
+        };
+
+        template <class Mesh, class... TFields>
+        inline Adapt<Mesh, TFields...>::Adapt(DistributedMesh<Mesh>& mesh, TFields&... fields)
+            : m_mesh(mesh)
+            , m_fields(fields...)
+            , m_adapt(fields...)
+        {
+        }
+
+        template <class Mesh, class... TFields>
+        void Adapt<Mesh, TFields...>::operator()(double eps, double regularity)
+        {
+            std::apply(
+                [&](auto&... fields)
+                {
+                    m_mesh.exchange(fields...);
+                },
+                m_fields);
+
+            m_adapt.adapt(eps,
+                          regularity,
+                          [&](bool unchanged)
+                          {
+                              bool agree = std::apply(
+                                  [&](auto&... fields)
+                                  {
+                                      return m_mesh.update_halo(fields...);
+                                  },
+                                  m_fields);
+                              int converged = (unchanged && agree) ? 1 : 0;
+                              MPI_Allreduce(MPI_IN_PLACE, &converged, 1, MPI_INT, MPI_MIN, m_mesh.comm());
+                              return converged == 1;
+                          });
+
+            // The owned and the halo cells are leaves of the whole mesh: a jump of more than one level between them is
+            // a jump in the whole mesh
+            using mesh_id_t = typename Mesh::mesh_id_t;
+            int graded      = is_graduated(m_mesh.mesh()[mesh_id_t::cells]) ? 1 : 0;
+            MPI_Allreduce(MPI_IN_PLACE, &graded, 1, MPI_INT, MPI_MIN, m_mesh.comm());
+            if (graded == 0)
+            {
+                throw std::runtime_error("MPI ERROR: the adapted mesh is not graded across the parts, increase the halo width");
+            }
+
+            std::apply(
+                [&](auto&... fields)
+                {
+                    m_mesh.repartition(fields...);
+                },
+                m_fields);
+        }
+
+        template <class Mesh, class... TFields>
+        auto make_MRAdapt(DistributedMesh<Mesh>& mesh, TFields&... fields)
+        {
+            return Adapt<Mesh, TFields...>(mesh, fields...);
+        }
+    } // end namespace mpi
+} // end namespace samurai
@@ -0,0 +1,834 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include <mpi.h>
+
+#include "../algorithm.hpp"
+#include "../algorithm/update.hpp"
+#include "../numeric/field_row.hpp"
+#include "../parallel.hpp"
+#include "partition.hpp"
+
+namespace samurai
+{
+    namespace mpi
+    {
+        namespace detail
+        {
+            inline int comm_rank(MPI_Comm comm)
+            {
+                int rank;
+                MPI_Comm_rank(comm, &rank);
+                return rank;
+            }
+
+            inline int comm_size(MPI_Comm comm)
+            {
+                int size;
+                MPI_Comm_size(comm, &size);
+                return size;
+            }
+
+            // First tags of the messages of the halo exchanges and of the migrations of field values: the k-th field of a call
+            // uses the first tag + k, so that the messages of two fields exchanged at the same time cannot be matched together
+            inline constexpr int exchange_tag  = 0x5a00;
+            inline constexpr int migration_tag = 0x4d00;
+
+            template <std::size_t dim, class TInterval>
+            using interval_list = samurai::detail::interval_list<dim, TInterval>;
+
+            /**
+             * @brief Appends the interval to the buffer, as level, start, end, index...
+             */
+            template <class TInterval, class Index>
+            void pack_interval(std::vector<typename TInterval::value_t>& buffer, std::size_t level, const TInterval& i, const Index& index)
+            {
+                using value_t = typename TInterval::value_t;
+
+                buffer.push_back(static_cast<value_t>(level));
+                buffer.push_back(i.start);
+                buffer.push_back(i.end);
+                for (std::size_t d = 0; d < index.size(); ++d)
+                {
+                    buffer.push_back(index[d]);
+                }
+            }
+
+            template <std::size_t dim, class TInterval>
+            auto unpack_intervals(const typename TInterval::value_t* data, std::size_t n_values)
+            {
+                interval_list<dim, TInterval> list;
+                for (std::size_t k = 0; k < n_values; k += dim + 2)
+                {
+                    typename interval_list<dim, TInterval>::index_t index;
+                    for (std::size_t d = 0; d < dim - 1; ++d)
+                    {
+                        index[d] = data[k + 3 + d];
+                    }
+                    list.levels.push_back(static_cast<std::size_t>(data[k]));
+                    list.intervals.push_back({data[k + 1], data[k + 2]});
+                    list.indices.push_back(index);
+                }
+                return list;
+            }
+
+            /**
+             * @brief Lists of the cells of each part of the partition.
+             */
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            auto split_by_part(const CellArray<dim, TInterval, max_size>& cells, const SfcPartition<dim, TInterval>& partition)
+            {
+                std::vector<interval_list<dim, TInterval>> lists(partition.n_parts());
+                for_each_interval(cells,
+                                  [&](std::size_t level, const auto& i, const auto& index)
+                                  {
+                                      partition.for_each_part(level,
+                                                              i,
+                                                              index,
+                                                              [&](std::size_t p, const auto& sub_i)
+                                                              {
+                                                                  lists[p].levels.push_back(level);
+                                                                  lists[p].intervals.push_back(sub_i);
+                                                                  lists[p].indices.push_back(index);
+                                                              });
+                                  });
+                return lists;
+            }
+
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            auto union_cell_list(const CellArray<dim, TInterval, max_size>& a, const CellArray<dim, TInterval, max_size>& b)
+            {
+                CellList<dim, TInterval, max_size> cl;
+                auto add = [&](std::size_t level, const auto& i, const auto& index)
+                {
+                    cl[level][index].add_interval(i);
+                };
+                for_each_interval(a, add);
+                for_each_interval(b, add);
+                return cl;
+            }
+
+            /**
+             * Cells whose values a process exchanges with the other ones: the values of the cells send[k] are sent to the process
+             * ranks[k], and those of the cells recv[k] are received from it, in the order of the lists.
+             */
+            template <std::size_t dim, class TInterval>
+            struct exchange_plan
+            {
+                std::vector<int> ranks;
+                std::vector<interval_list<dim, TInterval>> send;
+                std::vector<interval_list<dim, TInterval>> recv;
+            };
+
+            /**
+             * @brief Sends the intervals lists[q] to the process q, and returns the intervals received from each process (collective).
+             */
+            template <std::size_t dim, class TInterval>
+            auto all_to_all_intervals(MPI_Comm comm, const std::vector<interval_list<dim, TInterval>>& lists)
+            {
+                using value_t   = typename TInterval::value_t;
+                const auto size = lists.size();
+
+                std::vector<value_t> send_buffer;
+                std::vector<int> send_counts(size);
+                std::vector<int> send_displs(size);
+                for (std::size_t q = 0; q < size; ++q)
+                {
+                    auto start = send_buffer.size();
+                    for (std::size_t k = 0; k < lists[q].intervals.size(); ++k)
+                    {
+                        pack_interval(send_buffer, lists[q].levels[k], lists[q].intervals[k], lists[q].indices[k]);
+                    }
+                    send_displs[q] = static_cast<int>(start * sizeof(value_t));
+                    send_counts[q] = static_cast<int>((send_buffer.size() - start) * sizeof(value_t));
+                }
+
+                std::vector<int> recv_counts(size);
+                std::vector<int> recv_displs(size);
+                MPI_Alltoall(send_counts.data(), 1, MPI_INT, recv_counts.data(), 1, MPI_INT, comm);
+                int total = 0;
+                for (std::size_t q = 0; q < size; ++q)
+                {
+                    recv_displs[q] = total;
+                    total += recv_counts[q];
+                }
+                std::vector<value_t> recv_buffer(static_cast<std::size_t>(total) / sizeof(value_t));
+                MPI_Alltoallv(send_buffer.data(),
+                              send_counts.data(),
+                              send_displs.data(),
+                              MPI_BYTE,
+                              recv_buffer.data(),
+                              recv_counts.data(),
+                              recv_displs.data(),
+                              MPI_BYTE,
+                              comm);
+
+                std::vector<interval_list<dim, TInterval>> received;
+                received.reserve(size);
+                for (std::size_t q = 0; q < size; ++q)
+                {
+                    received.push_back(unpack_intervals<dim, TInterval>(recv_buffer.data() + recv_displs[q] / sizeof(value_t),
+                                                                        static_cast<std::size_t>(recv_counts[q]) / sizeof(value_t)));
+                }
+                return received;
+            }
+
+            /**
+             * @brief Plan of the exchange where the process sends the cells send[q] to the process q and receives the cells recv[q]
+             * from it.
+             */
+            template <std::size_t dim, class TInterval>
+            auto make_exchange_plan(std::vector<interval_list<dim, TInterval>> send, std::vector<interval_list<dim, TInterval>> recv)
+            {
+                exchange_plan<dim, TInterval> plan;
+                for (std::size_t q = 0; q < send.size(); ++q)
+                {
+                    if (send[q].intervals.empty() && recv[q].intervals.empty())
+                    {
+                        continue;
+                    }
+                    plan.ranks.push_back(static_cast<int>(q));
+                    plan.send.push_back(std::move(send[q]));
+                    plan.recv.push_back(std::move(recv[q]));
+                }
+                return plan;
+            }
+
+            /**
+             * @brief Plan of the exchange where the process receives the cells needed[q] from the process q.
+             * Collective: the processes tell each other the cells they need.
+             */
+            template <std::size_t dim, class TInterval>
+            auto make_exchange_plan(MPI_Comm comm, std::vector<interval_list<dim, TInterval>> needed)
+            {
+                auto requested = all_to_all_intervals(comm, needed);
+                return make_exchange_plan(std::move(requested), std::move(needed));
+            }
+
+            template <class TCellList, std::size_t dim, class TInterval>
+            void add_intervals(TCellList& cl, const std::vector<interval_list<dim, TInterval>>& lists)
+            {
+                for (const auto& list : lists)
+                {
+                    for (std::size_t k = 0; k < list.intervals.size(); ++k)
+                    {
+                        cl[list.levels[k]][list.indices[k]].add_interval(list.intervals[k]);
+                    }
+                }
+            }
+
+            /**
+             * @brief Partition of the leaves of the trees owned by the processes, computed together (collective).
+             *
+             * The root cells of a process are contiguous along the curve and follow those of the lower ranks: the processes only
+             * exchange the sums of their weights and the first root cell of each part, and never the leaves themselves.
+             */
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            auto make_partition(MPI_Comm comm,
+                                const CellArray<dim, TInterval, max_size>& local_cells,
+                                std::size_t root_level,
+                                std::size_t n_parts)
+            {
+                using value_t = typename TInterval::value_t;
+
+                // The curve starts at the lowest root cell of the whole mesh
+                auto origin = lowest_roots(local_cells, root_level);
+                std::array<long long, dim> lowest;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    lowest[d] = static_cast<long long>(origin[d]);
+                }
+                MPI_Allreduce(MPI_IN_PLACE, lowest.data(), static_cast<int>(dim), MPI_LONG_LONG, MPI_MIN, comm);
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    origin[d] = static_cast<value_t>(lowest[d]);
+                }
+
+                // Number of root cells and of leaves before the process, and in the whole mesh
+                auto roots = root_weights(local_cells, root_level, origin);
+                std::array<std::uint64_t, 2> local{static_cast<std::uint64_t>(roots.size()), 0};
+                for (const auto& root : roots)
+                {
+                    local[1] += root.weight;
+                }
+                std::array<std::uint64_t, 2> before{0, 0};
+                std::array<std::uint64_t, 2> total{0, 0};
+                MPI_Exscan(local.data(), before.data(), 2, MPI_UINT64_T, MPI_SUM, comm);
+                MPI_Allreduce(local.data(), total.data(), 2, MPI_UINT64_T, MPI_SUM, comm);
+                if (comm_rank(comm) == 0)
+                {
+                    before = {0, 0};
+                }
+                if (total[0] < n_parts)
+                {
+                    throw std::runtime_error(
+                        fmt::format("PARTITION ERROR: {} cells on the level {} for {} parts, increase the minimum level",
+                                    total[0],
+                                    root_level,
+                                    n_parts));
+                }
+
+                auto first = balanced_first_roots(roots, before[0], before[1], total[1], total[0], n_parts);
+                MPI_Allreduce(MPI_IN_PLACE, first.data(), static_cast<int>(n_parts), MPI_UINT64_T, MPI_MIN, comm);
+                first = non_empty_parts(std::move(first), total[0]);
+
+                std::vector<std::uint64_t> first_keys(n_parts, 0);
+                for (std::size_t p = 1; p < n_parts; ++p)
+                {
+                    if (first[p] >= before[0] && first[p] < before[0] + roots.size())
+                    {
+                        first_keys[p] = roots[first[p] - before[0]].key;
+                    }
+                }
+                MPI_Allreduce(MPI_IN_PLACE, first_keys.data(), static_cast<int>(n_parts), MPI_UINT64_T, MPI_MAX, comm);
+
+                return SfcPartition<dim, TInterval>(root_level, origin, std::move(first_keys));
+            }
+
+            /**
+             * Nonblocking exchange of the values of a field: the constructor posts the receptions and sends the values of the cells
+             * of the plan, finish() waits for the values and writes them in the destination field. The exchanges in progress at
+             * the same time on a communicator must have different tags.
+             */
+            template <class Field>
+            class field_exchange
+            {
+              public:
+
+                using value_type = typename Field::value_type;
+                using plan_t     = exchange_plan<Field::dim, typename Field::interval_t>;
+
+                field_exchange(MPI_Comm comm, const plan_t& plan, const Field& field, int tag);
+
+                void finish(Field& field);
+
+              private:
+
+                static std::size_t nb_values(const interval_list<Field::dim, typename Field::interval_t>& list);
+
+                const plan_t* m_plan;
+                std::vector<std::vector<value_type>> m_send;
+                std::vector<std::vector<value_type>> m_recv;
+                std::vector<MPI_Request> m_requests;
+            };
+
+            template <class Field>
+            field_exchange<Field>::field_exchange(MPI_Comm comm, const plan_t& plan, const Field& field, int tag)
+                : m_plan(&plan)
+                , m_send(plan.ranks.size())
+                , m_recv(plan.ranks.size())
+            {
+                for (std::size_t k = 0; k < plan.ranks.size(); ++k)
+                {
+                    m_recv[k].resize(nb_values(plan.recv[k]));
+                    if (!m_recv[k].empty())
+                    {
+                        m_requests.emplace_back();
+                        MPI_Irecv(m_recv[k].data(),
+                                  static_cast<int>(m_recv[k].size() * sizeof(value_type)),
+                                  MPI_BYTE,
+                                  plan.ranks[k],
+                                  tag,
+                                  comm,
+                                  &m_requests.back());
+                    }
+                }
+
+                for (std::size_t k = 0; k < plan.ranks.size(); ++k)
+                {
+                    const auto& list = plan.send[k];
+                    auto& buffer     = m_send[k];
+                    buffer.reserve(nb_values(list));
+                    for (std::size_t n = 0; n < list.intervals.size(); ++n)
+                    {
+                        auto row = samurai::detail::make_field_row(field, list.levels[n], list.intervals[n], list.indices[n]);
+                        for (std::ptrdiff_t x = 0; x < static_cast<std::ptrdiff_t>(list.intervals[n].size()); ++x)
+                        {
+                            for (std::size_t c = 0; c < Field::size; ++c)
+                            {
+                                buffer.push_back(row(x, c));
+                            }
+                        }
+                    }
+                    if (!buffer.empty())
+                    {
+                        m_requests.emplace_back();
+                        MPI_Isend(buffer.data(),
+                                  static_cast<int>(buffer.size() * sizeof(value_type)),
+                                  MPI_BYTE,
+                                  plan.ranks[k],
+                                  tag,
+                                  comm,
+                                  &m_requests.back());
+                    }
+                }
+            }
+
+            template <class Field>
+            void field_exchange<Field>::finish(Field& field)
+            {
+                MPI_Waitall(static_cast<int>(m_requests.size()), m_requests.data(), MPI_STATUSES_IGNORE);
+                m_requests.clear();
+
+                for (std::size_t k = 0; k < m_plan->ranks.size(); ++k)
+                {
+                    const auto& list = m_plan->recv[k];
+                    std::size_t pos  = 0;
+                    for (std::size_t n = 0; n < list.intervals.size(); ++n)
+                    {
+                        auto row = samurai::detail::make_field_row(field, list.levels[n], list.intervals[n], list.indices[n]);
+                        for (std::ptrdiff_t x = 0; x < static_cast<std::ptrdiff_t>(list.intervals[n].size()); ++x)
+                        {
+                            for (std::size_t c = 0; c < Field::size; ++c)
+                            {
+                                row(x, c) = m_recv[k][pos++];
+                            }
+                        }
+                    }
+                }
+            }
+
+            template <class Field>
+            std::size_t field_exchange<Field>::nb_values(const interval_list<Field::dim, typename Field::interval_t>& list)
+            {
+                std::size_t n = 0;
+                for (const auto& i : list.intervals)
+                {
+                    n += i.size() * Field::size;
+                }
+                return n;
+            }
+
+            /**
+             * @brief Starts the exchanges of the fields with the plan: the k-th field uses the tag first_tag + k. The exchanges are
+             * posted from left to right (braced initialization), in the same order on every process.
+             */
+            template <class Plan, std::size_t... I, class... Fields>
+            auto
+            start_field_exchanges(MPI_Comm comm, const Plan& plan, int first_tag, std::index_sequence<I...>, const Fields&... fields)
+            {
+                return std::tuple<field_exchange<Fields>...>{
+                    field_exchange<Fields>(comm, plan, fields, first_tag + static_cast<int>(I))...};
+            }
+        }
+
+        /**
+         * Multiresolution mesh distributed among the processes of a communicator.
+         *
+         * The leaves are partitioned along a space-filling curve (see SfcPartition). Every process stores the cells it owns
+         * and a halo of cells of the other processes around them in its local mesh, on which the fields are defined.
+         * The values of the halo cells are received from their owners by exchange() and mpi::update_ghost_mr(), so that the ghosts
+         * of the owned cells, and the schemes applied on them, are computed as on a single process. The local mesh has the domain
+         * of the whole mesh: the boundary conditions apply only on its boundary.
+         *
+         * A process only knows the leaves of its local mesh and the partition (the first root cell of each part): the memory and
+         * the communications scale with the number of local cells. The local mesh must be adapted with mpi::make_MRAdapt,
+         * which repartitions the leaves after the adaptation.
+         * Periodic meshes are not supported.
+         */
+        template <class Mesh>
+        class DistributedMesh
+        {
+          public:
+
+            static constexpr std::size_t dim = Mesh::dim;
+
+            using mesh_t      = Mesh;
+            using mesh_id_t   = typename Mesh::mesh_id_t;
+            using interval_t  = typename Mesh::interval_t;
+            using ca_type     = typename Mesh::ca_type;
+            using cl_type     = typename Mesh::cl_type;
+            using lca_type    = typename Mesh::lca_type;
+            using partition_t = SfcPartition<dim, interval_t>;
+            using plan_t      = detail::exchange_plan<dim, interval_t>;
+
+            // Width of the halo, in cells of the level of the owned cells (or of the halo cells if they are finer)
+            static constexpr int default_halo_width = 2 * static_cast<int>(Mesh::config::ghost_width);
+
+            DistributedMesh(const Mesh& global_mesh, MPI_Comm comm = MPI_COMM_WORLD, int halo_width = default_halo_width);
+
+            Mesh& mesh();
+            const Mesh& mesh() const;
+
+            std::size_t nb_cells() const;
+            const ca_type& owned_cells() const;
+            const ca_type& halo_cells() const;
+            const partition_t& partition() const;
+
+            MPI_Comm comm() const;
+            int rank() const;
+            int size() const;
+
+            template <class Field>
+            auto start_exchange(const Field& field, int tag = detail::exchange_tag) const;
+
+            template <class... Fields>
+            void exchange(Fields&... fields) const;
+
+            template <class... Fields>
+            bool update_halo(Fields&... fields);
+
+            template <class... Fields>
+            void repartition(Fields&... fields);
+
+          private:
+
+            void check_mesh() const;
+            ca_type local_leaves() const;
+            ca_type gather_halo_cells() const;
+
+            template <class Field>
+            void keep_owned(Mesh& new_mesh, Field& field) const;
+
+            template <class Exchange, class Field>
+            static void migrate(Exchange& migration, Mesh& new_mesh, Field& field);
+
+            MPI_Comm m_comm;
+            int m_rank;
+            int m_size;
+            int m_halo_width;
+            std::size_t m_min_level;
+            std::size_t m_max_level;
+            lca_type m_domain;
+            partition_t m_partition;
+            ca_type m_owned;
+            ca_type m_halo;
+            lca_type m_roots; // cells of the root level containing the owned cells
+            Mesh m_mesh;
+            plan_t m_halo_plan;
+            std::size_t m_generation;
+        };
+
+        /**
+         * @brief Distributes the leaves of the mesh, which must be the same on every process of the communicator.
+         */
+        template <class Mesh>
+        DistributedMesh<Mesh>::DistributedMesh(const Mesh& global_mesh, MPI_Comm comm, int halo_width)
+            : m_comm(comm)
+            , m_rank(detail::comm_rank(comm))
+            , m_size(detail::comm_size(comm))
+            , m_halo_width(halo_width)
+            , m_min_level(global_mesh.min_level())
+            , m_max_level(global_mesh.max_level())
+            , m_domain(global_mesh.domain())
+            , m_partition(global_mesh[mesh_id_t::cells], m_min_level, static_cast<std::size_t>(m_size))
+            , m_owned(part_cells(global_mesh[mesh_id_t::cells], m_partition, static_cast<std::size_t>(m_rank)))
+            , m_halo(samurai::mpi::halo_cells(global_mesh[mesh_id_t::cells], m_owned, m_halo_width))
+            , m_roots(neighborhood(m_owned, m_min_level, 0))
+            , m_mesh(detail::union_cell_list(m_owned, m_halo), m_domain, m_min_level, m_max_level)
+            , m_halo_plan(detail::make_exchange_plan(m_comm, detail::split_by_part(m_halo, m_partition)))
+            , m_generation(m_mesh.generation())
+        {
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                if (global_mesh.is_periodic(d))
+                {
+                    throw std::runtime_error("MPI ERROR: the distribution of periodic meshes is not supported");
+                }
+            }
+        }
+
+        template <class Mesh>
+        inline Mesh& DistributedMesh<Mesh>::mesh()
+        {
+            return m_mesh;
+        }
+
+        template <class Mesh>
+        inline const Mesh& DistributedMesh<Mesh>::mesh() const
+        {
+            return m_mesh;
+        }
+
+        /**
+         * @brief Number of leaves of the whole mesh (collective).
+         */
+        template <class Mesh>
+        inline std::size_t DistributedMesh<Mesh>::nb_cells() const
+        {
+            auto local               = static_cast<unsigned long long>(m_owned.nb_cells());
+            unsigned long long total = 0;
+            MPI_Allreduce(&local, &total, 1, MPI_UNSIGNED_LONG_LONG, MPI_SUM, m_comm);
+            return static_cast<std::size_t>(total);
+        }
+
+        /**
+         * @brief Leaves owned by the process, e.g. for the reductions over the whole mesh.
+         */
+        template <class Mesh>
+        inline auto DistributedMesh<Mesh>::owned_cells() const -> const ca_type&
+        {
+            return m_owned;
+        }
+
+        template <class Mesh>
+        inline auto DistributedMesh<Mesh>::halo_cells() const -> const ca_type&
+        {
+            return m_halo;
+        }
+
+        template <class Mesh>
+        inline auto DistributedMesh<Mesh>::partition() const -> const partition_t&
+        {
+            return m_partition;
+        }
+
+        template <class Mesh>
+        inline MPI_Comm DistributedMesh<Mesh>::comm() const
+        {
+            return m_comm;
+        }
+
+        template <class Mesh>
+        inline int DistributedMesh<Mesh>::rank() const
+        {
+            return m_rank;
+        }
+
+        template <class Mesh>
+        inline int DistributedMesh<Mesh>::size() const
+        {
+            return m_size;
+        }
+
+        template <class Mesh>
+        inline void DistributedMesh<Mesh>::check_mesh() const
+        {
+            if (m_mesh.generation() != m_generation)
+            {
+                throw std::runtime_error("MPI ERROR: the local mesh has been adapted outside of mpi::make_MRAdapt");
+            }
+        }
+
+        /**
+         * @brief Starts the exchange of the values of the halo cells of the field; the returned exchange must be finished by
+         * finish(field). The computations on the owned cells far from the halo can be done in the meantime. The exchanges started
+         * at the same time must have different tags.
+         */
+        template <class Mesh>
+        template <class Field>
+        auto DistributedMesh<Mesh>::start_exchange(const Field& field, int tag) const
+        {
+            check_mesh();
+            return detail::field_exchange<Field>(m_comm, m_halo_plan, field, tag);
+        }
+
+        /**
+         * @brief Receives the values of the halo cells of the fields from their owners (collective).
+         */
+        template <class Mesh>
+        template <class... Fields>
+        void DistributedMesh<Mesh>::exchange(Fields&... fields) const
+        {
+            check_mesh();
+            auto exchanges = detail::start_field_exchanges(m_comm,
+                                                           m_halo_plan,
+                                                           detail::exchange_tag,
+                                                           std::index_sequence_for<Fields...>{},
+                                                           fields...);
+            std::apply(
+                [&](auto&... e)
+                {
+                    (e.finish(fields), ...);
+                },
+                exchanges);
+        }
+
+        /**
+         * @brief Leaves of the local mesh in the trees owned by the process.
+         */
+        template <class Mesh>
+        auto DistributedMesh<Mesh>::local_leaves() const -> ca_type
+        {
+            cl_type cl;
+            for (std::size_t level = m_min_level; level <= m_max_level; ++level)
+            {
+                auto set = intersection(m_mesh[mesh_id_t::cells][level], m_roots).on(level);
+                set(
+                    [&](const auto& i, const auto& index)
+                    {
+                        cl[level][index].add_interval(i);
+                    });
+            }
+            return ca_type(cl);
+        }
+
+        /**
+         * @brief Leaves of the other processes in the neighborhood of the owned cells (collective).
+         *
+         * Every process sends to the owners of the root cells around its own trees the leaves it owns near these root cells:
+         * the exchanged cells scale with the boundaries of the parts.
+         */
+        template <class Mesh>
+        auto DistributedMesh<Mesh>::gather_halo_cells() const -> ca_type
+        {
+            using list_t = detail::interval_list<dim, interval_t>;
+
+            // Root cells of the other parts around the owned cells, by part
+            std::vector<cl_type> near_roots(static_cast<std::size_t>(m_size));
+            auto around = neighborhood(m_owned, m_min_level, m_halo_width);
+            auto set    = intersection(difference(around, m_roots), m_domain).on(m_min_level);
+            set(
+                [&](const auto& i, const auto& index)
+                {
+                    m_partition.for_each_part(m_min_level,
+                                              i,
+                                              index,
+                                              [&](std::size_t p, const auto& sub_i)
+                                              {
+                                                  near_roots[p][m_min_level][index].add_interval(sub_i);
+                                              });
+                });
+
+            std::vector<list_t> send(near_roots.size());
+            for (std::size_t p = 0; p < near_roots.size(); ++p)
+            {
+                ca_type roots(near_roots[p]);
+                if (roots[m_min_level].empty())
+                {
+                    continue;
+                }
+                for (std::size_t level = m_min_level; level <= m_max_level; ++level)
+                {
+                    if (m_owned[level].empty())
+                    {
+                        continue;
+                    }
+                    auto near       = neighborhood(roots, level, m_halo_width);
+                    auto near_owned = intersection(m_owned[level], near);
+                    near_owned(
+                        [&](const auto& i, const auto& index)
+                        {
+                            send[p].levels.push_back(level);
+                            send[p].intervals.push_back(i);
+                            send[p].indices.push_back(index);
+                        });
+                }
+            }
+
+            cl_type cl;
+            detail::add_intervals(cl, detail::all_to_all_intervals(m_comm, send));
+            return samurai::mpi::halo_cells(ca_type(cl), m_owned, m_halo_width);
+        }
+
+        /**
+         * @brief Rebuilds the halo after an adaptation of the local mesh, in which the trees of the owned cells stay on the process
+         * (collective): the leaves of the owners replace those of the local adaptation in the halo, and the values of the fields
+         * on the halo cells are received from them.
+         *
+         * Returns whether the local adaptation had the same leaves as their owners in the halo.
+         */
+        template <class Mesh>
+        template <class... Fields>
+        bool DistributedMesh<Mesh>::update_halo(Fields&... fields)
+        {
+            m_owned = local_leaves();
+            m_halo  = gather_halo_cells();
+
+            bool agree = true;
+            for (std::size_t level = m_min_level; level <= m_max_level; ++level)
+            {
+                auto set = difference(m_halo[level], m_mesh[mesh_id_t::cells][level]);
+                set(
+                    [&](const auto&, const auto&)
+                    {
+                        agree = false;
+                    });
+            }
+
+            Mesh new_mesh(detail::union_cell_list(m_owned, m_halo), m_domain, m_min_level, m_max_level);
+            (keep_owned(new_mesh, fields), ...);
+
+            m_mesh.swap(new_mesh);
+            m_generation = m_mesh.generation();
+            m_halo_plan  = detail::make_exchange_plan(m_comm, detail::split_by_part(m_halo, m_partition));
+            exchange(fields...);
+            return agree;
+        }
+
+        template <class Mesh>
+        template <class Field>
+        void DistributedMesh<Mesh>::keep_owned(Mesh& new_mesh, Field& field) const
+        {
+            Field new_field(field.name(), new_mesh);
+            for_each_interval(m_owned,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  new_field(level, i, index) = field(level, i, index);
+                              });
+            std::swap(field.array(), new_field.array());
+        }
+
+        /**
+         * @brief Repartitions the leaves after the adaptation of the local mesh, and moves the values of the fields to the new
+         * owners of the cells (collective).
+         *
+         * The new partition is computed from the numbers of leaves of the processes (see detail::make_partition), then each process
+         * sends its leaves and their values to their new owners, and receives the leaves and the values of its new halo.
+         */
+        template <class Mesh>
+        template <class... Fields>
+        void DistributedMesh<Mesh>::repartition(Fields&... fields)
+        {
+            auto leaves = local_leaves();
+            m_partition = detail::make_partition(m_comm, leaves, m_min_level, static_cast<std::size_t>(m_size));
+
+            auto send = detail::split_by_part(leaves, m_partition);
+            auto recv = detail::all_to_all_intervals(m_comm, send);
+            cl_type cl;
+            detail::add_intervals(cl, recv);
+            m_owned = ca_type(cl);
+            m_roots = neighborhood(m_owned, m_min_level, 0);
+            m_halo  = gather_halo_cells();
+
+            Mesh new_mesh(detail::union_cell_list(m_owned, m_halo), m_domain, m_min_level, m_max_level);
+            auto migration_plan = detail::make_exchange_plan(std::move(send), std::move(recv));
+            auto migrations     = detail::start_field_exchanges(m_comm,
+                                                            migration_plan,
+                                                            detail::migration_tag,
+                                                            std::index_sequence_for<Fields...>{},
+                                                            fields...);
+            std::apply(
+                [&](auto&... migration)
+                {
+                    (migrate(migration, new_mesh, fields), ...);
+                },
+                migrations);
+
+            m_mesh.swap(new_mesh);
+            m_generation = m_mesh.generation();
+            m_halo_plan  = detail::make_exchange_plan(m_comm, detail::split_by_part(m_halo, m_partition));
+            exchange(fields...);
+        }
+
+        template <class Mesh>
+        template <class Exchange, class Field>
+        void DistributedMesh<Mesh>::migrate(Exchange& migration, Mesh& new_mesh, Field& field)
+        {
+            Field new_field(field.name(), new_mesh);
+            migration.finish(new_field);
+            std::swap(field.array(), new_field.array());
+        }
+
+        /**
+         * @brief Receives the values of the halo cells, then updates the ghosts of the local mesh.
+         */
+        template <class Mesh, class... Fields>
+        void update_ghost_mr(const DistributedMesh<Mesh>& mesh, Fields&... fields)
+        {
+            mesh.exchange(fields...);
+            samurai::update_ghost_mr(fields...);
+        }
+    } // end namespace mpi
+} // end namespace samurai
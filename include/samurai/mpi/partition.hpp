@@ -0,0 +1,469 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <xtensor/xfixed.hpp>
+
+#include "../algorithm.hpp"
+#include "../cell_array.hpp"
+#include "../cell_list.hpp"
+#include "../level_cell_array.hpp"
+#include "../level_cell_list.hpp"
+#include "../subset/subset_op.hpp"
+
+namespace samurai
+{
+    namespace mpi
+    {
+        namespace detail
+        {
+            /**
+             * @brief Position on the Morton (Z-order) curve of the point of non-negative coordinates x.
+             */
+            template <std::size_t dim>
+            inline std::uint64_t morton_key(const std::array<std::uint64_t, dim>& x)
+            {
+                constexpr std::size_t bits = 64 / dim;
+
+                std::uint64_t key = 0;
+                for (std::size_t b = 0; b < bits; ++b)
+                {
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        key |= ((x[d] >> b) & std::uint64_t{1}) << (b * dim + d);
+                    }
+                }
+                return key;
+            }
+
+            template <std::size_t dim, class value_t, class Index>
+            inline std::uint64_t root_key(const std::array<value_t, dim>& origin, value_t i, const Index& index)
+            {
+                std::array<std::uint64_t, dim> x;
+                x[0] = static_cast<std::uint64_t>(i - origin[0]);
+                for (std::size_t d = 1; d < dim; ++d)
+                {
+                    x[d] = static_cast<std::uint64_t>(index[d - 1] - origin[d]);
+                }
+                return morton_key<dim>(x);
+            }
+
+            /**
+             * @brief Lowest coordinates of the cells of the root level containing the cells (the maximum value if there is none).
+             */
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            auto lowest_roots(const CellArray<dim, TInterval, max_size>& cells, std::size_t root_level)
+            {
+                using value_t = typename TInterval::value_t;
+
+                std::array<value_t, dim> origin;
+                origin.fill(std::numeric_limits<value_t>::max());
+                for_each_interval(cells,
+                                  [&](std::size_t level, const auto& i, const auto& index)
+                                  {
+                                      std::size_t shift = level - root_level;
+                                      origin[0]         = std::min(origin[0], i.start >> shift);
+                                      for (std::size_t d = 1; d < dim; ++d)
+                                      {
+                                          origin[d] = std::min(origin[d], index[d - 1] >> shift);
+                                      }
+                                  });
+                return origin;
+            }
+
+            struct root_weight
+            {
+                std::uint64_t key;
+                std::uint64_t weight;
+            };
+
+            /**
+             * @brief Number of leaves of each root cell containing cells, sorted along the curve.
+             */
+            template <std::size_t dim, class TInterval, std::size_t max_size>
+            auto root_weights(const CellArray<dim, TInterval, max_size>& cells,
+                              std::size_t root_level,
+                              const std::array<typename TInterval::value_t, dim>& origin)
+            {
+                using value_t = typename TInterval::value_t;
+                using index_t = xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>;
+
+                std::vector<root_weight> roots;
+                for_each_interval(cells,
+                                  [&](std::size_t level, const auto& i, const auto& index)
+                                  {
+                                      std::size_t shift = level - root_level;
+                                      index_t root_index;
+                                      for (std::size_t d = 0; d < dim - 1; ++d)
+                                      {
+                                          root_index[d] = index[d] >> shift;
+                                      }
+                                      for (value_t x = i.start >> shift; x <= ((i.end - 1) >> shift); ++x)
+                                      {
+                                          value_t start = std::max(i.start, x << shift);
+                                          value_t end   = std::min(i.end, (x + 1) << shift);
+                                          roots.push_back({root_key<dim>(origin, x, root_index), static_cast<std::uint64_t>(end - start)});
+                                      }
+                                  });
+                std::sort(roots.begin(),
+                          roots.end(),
+                          [](const auto& a, const auto& b)
+                          {
+                              return a.key < b.key;
+                          });
+
+                std::vector<root_weight> merged;
+                for (const auto& root : roots)
+                {
+                    if (merged.empty() || merged.back().key != root.key)
+                    {
+                        merged.push_back(root);
+                    }
+                    else
+                    {
+                        merged.back().weight += root.weight;
+                    }
+                }
+                return merged;
+            }
+
+            /**
+             * @brief Index along the curve of the first root after which p / n_parts of the total weight is reached, for each part p
+             * (n_roots if it is not reached in roots).
+             *
+             * The roots are a contiguous run of the curve, starting at the index first_index with the weight weight_before before it,
+             * so that the processes can each look in their own roots and keep the minimum.
+             */
+            inline std::vector<std::uint64_t> balanced_first_roots(const std::vector<root_weight>& roots,
+                                                                   std::uint64_t first_index,
+                                                                   std::uint64_t weight_before,
+                                                                   std::uint64_t total_weight,
+                                                                   std::uint64_t n_roots,
+                                                                   std::size_t n_parts)
+            {
+                std::vector<std::uint64_t> first(n_parts, n_roots);
+                first[0]      = 0;
+                std::size_t p = 1;
+                for (std::size_t r = 0; r < roots.size(); ++r)
+                {
+                    while (p < n_parts && weight_before * n_parts >= p * total_weight)
+                    {
+                        first[p] = first_index + r;
+                        ++p;
+                    }
+                    weight_before += roots[r].weight;
+                }
+                return first;
+            }
+
+            /**
+             * @brief Moves the first roots of the parts along the curve so that every part has at least one root.
+             */
+            inline std::vector<std::uint64_t> non_empty_parts(std::vector<std::uint64_t> first, std::uint64_t n_roots)
+            {
+                const std::size_t n_parts = first.size();
+                for (std::size_t p = 1; p < n_parts; ++p)
+                {
+                    first[p] = std::min(n_roots - (n_parts - p), std::max(first[p - 1] + 1, first[p]));
+                }
+                return first;
+            }
+        }
+
+        namespace detail
+        {
+            /**
+             * @brief Cells of the level of lca at a distance of at most width cells from its cells: union of unit translations,
+             * repeated width times in each direction.
+             */
+            template <std::size_t dim, class TInterval>
+            auto dilation(const LevelCellArray<dim, TInterval>& lca, int width)
+            {
+                using direction_t = xt::xtensor_fixed<int, xt::xshape<dim>>;
+
+                LevelCellArray<dim, TInterval> dilated = lca;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    direction_t e;
+                    e.fill(0);
+                    e[d] = 1;
+                    for (int k = 0; k < width; ++k)
+                    {
+                        LevelCellList<dim, TInterval> lcl{lca.level()};
+                        auto set = union_(translate(dilated, e), dilated, translate(dilated, -e));
+                        set(
+                            [&](const auto& i, const auto& index)
+                            {
+                                lcl[index].add_interval(i);
+                            });
+                        dilated = LevelCellArray<dim, TInterval>(lcl);
+                    }
+                }
+                return dilated;
+            }
+        }
+
+        /**
+         * Partition of the leaves of a multiresolution mesh into parts of (almost) the same number of leaves,
+         * contiguous along the Morton curve.
+         *
+         * The curve goes through the cells of the root level (the minimum level of the mesh) and a leaf belongs to the part of
+         * its ancestor on the root level: the trees of the leaves are never split, so that the refinement and the coarsening
+         * of the cells do not move them from one part to another.
+         */
+        template <std::size_t dim, class TInterval>
+        class SfcPartition
+        {
+          public:
+
+            using interval_t = TInterval;
+            using value_t    = typename interval_t::value_t;
+            using index_t    = xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>;
+
+            SfcPartition() = default;
+
+            template <std::size_t max_size>
+            SfcPartition(const CellArray<dim, TInterval, max_size>& cells, std::size_t root_level, std::size_t n_parts);
+
+            SfcPartition(std::size_t root_level, const std::array<value_t, dim>& origin, std::vector<std::uint64_t> first_keys);
+
+            std::size_t n_parts() const;
+            std::size_t root_level() const;
+
+            std::size_t part(std::size_t level, value_t i, const index_t& index) const;
+
+            /**
+             * @brief Calls f(part, sub_interval) on the runs of cells of the interval that belong to the same part.
+             */
+            template <class Func>
+            void for_each_part(std::size_t level, const interval_t& i, const index_t& index, Func&& f) const;
+
+          private:
+
+            std::uint64_t root_key(value_t i, const index_t& index) const;
+            std::size_t part_of_key(std::uint64_t key) const;
+
+            std::size_t m_root_level = 0;
+            std::array<value_t, dim> m_origin{};     // lowest coordinates of the root cells
+            std::vector<std::uint64_t> m_first_keys; // key of the first root cell of each part
+        };
+
+        template <std::size_t dim, class TInterval>
+        template <std::size_t max_size>
+        SfcPartition<dim, TInterval>::SfcPartition(const CellArray<dim, TInterval, max_size>& cells,
+                                                   std::size_t root_level,
+                                                   std::size_t n_parts)
+            : m_root_level(root_level)
+            , m_origin(detail::lowest_roots(cells, root_level))
+        {
+            auto roots = detail::root_weights(cells, root_level, m_origin);
+            if (roots.size() < n_parts)
+            {
+                throw std::runtime_error(fmt::format("PARTITION ERROR: {} cells on the level {} for {} parts, increase the minimum level",
+                                                     roots.size(),
+                                                     root_level,
+                                                     n_parts));
+            }
+
+            std::uint64_t total = 0;
+            for (const auto& root : roots)
+            {
+                total += root.weight;
+            }
+
+            // The part p starts when the number of leaves before it reaches p / n_parts of the total; every part has a root cell
+            auto first = detail::non_empty_parts(detail::balanced_first_roots(roots, 0, 0, total, roots.size(), n_parts), roots.size());
+            m_first_keys.assign(n_parts, 0);
+            for (std::size_t p = 1; p < n_parts; ++p)
+            {
+                m_first_keys[p] = roots[first[p]].key;
+            }
+        }
+
+        /**
+         * @brief Partition given by the key of the first root cell of each part, e.g. computed by the processes together.
+         */
+        template <std::size_t dim, class TInterval>
+        SfcPartition<dim, TInterval>::SfcPartition(std::size_t root_level,
+                                                   const std::array<value_t, dim>& origin,
+                                                   std::vector<std::uint64_t> first_keys)
+            : m_root_level(root_level)
+            , m_origin(origin)
+            , m_first_keys(std::move(first_keys))
+        {
+        }
+
+        template <std::size_t dim, class TInterval>
+        inline std::size_t SfcPartition<dim, TInterval>::n_parts() const
+        {
+            return m_first_keys.size();
+        }
+
+        template <std::size_t dim, class TInterval>
+        inline std::size_t SfcPartition<dim, TInterval>::root_level() const
+        {
+            return m_root_level;
+        }
+
+        template <std::size_t dim, class TInterval>
+        inline std::uint64_t SfcPartition<dim, TInterval>::root_key(value_t i, const index_t& index) const
+        {
+            return detail::root_key<dim>(m_origin, i, index);
+        }
+
+        template <std::size_t dim, class TInterval>
+        inline std::size_t SfcPartition<dim, TInterval>::part_of_key(std::uint64_t key) const
+        {
+            auto it = std::upper_bound(m_first_keys.begin(), m_first_keys.end(), key);
+            return static_cast<std::size_t>(it - m_first_keys.begin()) - 1;
+        }
+
+        template <std::size_t dim, class TInterval>
+        inline std::size_t SfcPartition<dim, TInterval>::part(std::size_t level, value_t i, const index_t& index) const
+        {
+            std::size_t shift = level - m_root_level;
+            index_t root_index;
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                root_index[d] = index[d] >> shift;
+            }
+            return part_of_key(root_key(i >> shift, root_index));
+        }
+
+        template <std::size_t dim, class TInterval>
+        template <class Func>
+        void SfcPartition<dim, TInterval>::for_each_part(std::size_t level, const interval_t& i, const index_t& index, Func&& f) const
+        {
+            std::size_t shift = level - m_root_level;
+            index_t root_index;
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                root_index[d] = index[d] >> shift;
+            }
+
+            value_t run_start    = i.start;
+            std::size_t run_part = part_of_key(root_key(i.start >> shift, root_index));
+            for (value_t x = (i.start >> shift) + 1; x <= ((i.end - 1) >> shift); ++x)
+            {
+                std::size_t p = part_of_key(root_key(x, root_index));
+                if (p != run_part)
+                {
+                    f(run_part, interval_t{run_start, x << shift});
+                    run_start = x << shift;
+                    run_part  = p;
+                }
+            }
+            f(run_part, interval_t{run_start, i.end});
+        }
+
+        /**
+         * @brief Cells of the part of the partition.
+         */
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        auto part_cells(const CellArray<dim, TInterval, max_size>& cells, const SfcPartition<dim, TInterval>& partition, std::size_t part)
+        {
+            CellList<dim, TInterval, max_size> cl;
+            for_each_interval(cells,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  partition.for_each_part(level,
+                                                          i,
+                                                          index,
+                                                          [&](std::size_t p, const auto& sub_i)
+                                                          {
+                                                              if (p == part)
+                                                              {
+                                                                  cl[level][index].add_interval(sub_i);
+                                                              }
+                                                          });
+                              });
+            return CellArray<dim, TInterval, max_size>(cl);
+        }
+
+        /**
+         * @brief Cells of the level at a distance of at most width cells from the cells of ca.
+         * The width is counted in cells of the level, or in cells of the cell of ca if it is coarser,
+         * so that the neighborhood of a coarse cell contains all the leaves its ghosts may be computed from.
+         */
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        auto neighborhood(const CellArray<dim, TInterval, max_size>& ca, std::size_t level, int width)
+        {
+            using lca_t = LevelCellArray<dim, TInterval>;
+
+            LevelCellList<dim, TInterval> lcl{level};
+            auto add = [&](std::size_t, const auto& i, const auto& index)
+            {
+                lcl[index].add_interval(i);
+            };
+
+            for (std::size_t l = 0; l <= max_size; ++l)
+            {
+                if (ca[l].empty())
+                {
+                    continue;
+                }
+                if (l <= level)
+                {
+                    auto dilated = detail::dilation(ca[l], width);
+                    auto set     = intersection(dilated, dilated).on(level);
+                    set(
+                        [&](const auto& i, const auto& index)
+                        {
+                            add(level, i, index);
+                        });
+                }
+                else
+                {
+                    // Cells of the level containing the cells of ca, then dilated
+                    LevelCellList<dim, TInterval> projected{level};
+                    auto set = intersection(ca[l], ca[l]).on(level);
+                    set(
+                        [&](const auto& i, const auto& index)
+                        {
+                            projected[index].add_interval(i);
+                        });
+                    for_each_interval(detail::dilation(lca_t(projected), width), add);
+                }
+            }
+            return lca_t(lcl);
+        }
+
+        /**
+         * @brief Halo of the cells owned by a process: the cells that are not owned and lie in the neighborhood of width cells
+         * of the owned cells.
+         */
+        template <std::size_t dim, class TInterval, std::size_t max_size>
+        auto halo_cells(const CellArray<dim, TInterval, max_size>& cells, const CellArray<dim, TInterval, max_size>& owned, int width)
+        {
+            CellList<dim, TInterval, max_size> cl;
+            for (std::size_t level = 0; level <= max_size; ++level)
+            {
+                if (cells[level].empty())
+                {
+                    continue;
+                }
+                auto around = neighborhood(owned, level, width);
+                auto set    = difference(intersection(cells[level], around), owned[level]).on(level);
+                set(
+                    [&](const auto& i, const auto& index)
+                    {
+                        cl[level][index].add_interval(i);
+                    });
+            }
+            return CellArray<dim, TInterval, max_size>(cl);
+        }
+    } // end namespace mpi
+} // end namespace samurai
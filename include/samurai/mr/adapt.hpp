@@ -128,6 +128,9 @@ namespace samurai
         template <class... Fields>
         void operator()(double eps, double regularity, Fields&... other_fields);
 
+        template <class Converged, class... Fields>
+        void adapt(double eps, double regularity, Converged&& converged, Fields&... other_fields);
+
       private:
 
         using inner_fields_type = detail::get_fields_type<TField, TFields...>;
@@ -163,6 +166,24 @@ namespace samurai
     template <class TField, class... TFields>
     template <class... Fields>
     void Adapt<TField, TFields...>::operator()(double eps, double regularity, Fields&... other_fields)
+    {
+        adapt(
+            eps,
+            regularity,
+            [](bool unchanged)
+            {
+                return unchanged;
+            },
+            other_fields...);
+    }
+
+    /**
+     * Same as operator(), where converged(unchanged) is called after each iteration with whether it left the mesh unchanged,
+     * and returns whether the adaptation stops (e.g. once the processes sharing a distributed mesh all agree).
+     */
+    template <class TField, class... TFields>
+    template <class Converged, class... Fields>
+    void Adapt<TField, TFields...>::adapt(double eps, double regularity, Converged&& converged, Fields&... other_fields)
     {
         auto& mesh            = m_fields.mesh();
         std::size_t min_level = mesh.min_level();
@@ -183,7 +204,7 @@ namespace samurai
             m_detail.resize();
             m_tag.resize();
             m_tag.fill(0);
-            if (harten(i, eps, regularity, old_fields, other_fields...))
+            if (converged(harten(i, eps, regularity, old_fields, other_fields...)))
             {
                 break;
             }
@@ -73,6 +73,7 @@ namespace samurai
 
         MRMesh(const cl_type& cl, std::size_t min_level, std::size_t max_level);
         MRMesh(const cl_type& cl, std::size_t min_level, std::size_t max_level, const std::array<bool, dim>& periodic);
+        MRMesh(const cl_type& cl, const lca_type& domain, std::size_t min_level, std::size_t max_level);
         MRMesh(const samurai::Box<double, dim>& b, std::size_t min_level, std::size_t max_level);
         MRMesh(const samurai::Box<double, dim>& b, std::size_t min_level, std::size_t max_level, const std::array<bool, dim>& periodic);
 
@@ -94,6 +95,16 @@ namespace samurai
     {
     }
 
+    /**
+     * Mesh of the cells of the list in a domain that can be larger than their union (e.g. the cells of one process
+     * of a distributed mesh): the boundary conditions and the ghosts are those of the domain.
+     */
+    template <class Config>
+    inline MRMesh<Config>::MRMesh(const cl_type& cl, const lca_type& domain, std::size_t min_level, std::size_t max_level)
+        : base_type(cl, domain, min_level, max_level)
+    {
+    }
+
     template <class Config>
     inline MRMesh<Config>::MRMesh(const samurai::Box<double, dim>& b, std::size_t min_level, std::size_t max_level)
         : base_type(b, max_level, min_level, max_level)
@@ -1,69 +1,275 @@
 #pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#include "../algorithm.hpp"
+#include "../parallel.hpp"
+#include "field_row.hpp"
 #include "gauss_legendre.hpp"
 
 namespace samurai
 {
     /**
-     * Computes the L2-error with respect to an exact solution.
+     * Norms of the error and of the exact solution, with the contribution of each level to the error:
+     * the L1 norms and the squares of the L2 norms of the levels add up to those of the whole mesh.
+     * For vector fields, the pointwise norms are the l1, l2 and l-infinity norms of the components.
+     */
+    struct error_norms
+    {
+        struct norms_t
+        {
+            double L1   = 0;
+            double L2   = 0;
+            double Linf = 0;
+        };
+
+        norms_t error;
+        norms_t solution;
+        std::vector<norms_t> error_by_level; // indexed by the level
+
+        norms_t relative() const
+        {
+            return {error.L1 / solution.L1, error.L2 / solution.L2, error.Linf / solution.Linf};
+        }
+    };
+
+    namespace detail
+    {
+        /**
+         * Compensated (Kahan-Babuska-Neumaier) summation: the rounding error of each addition is accumulated apart.
+         */
+        class compensated_sum
+        {
+          public:
+
+            void add(double x)
+            {
+                double t = m_sum + x;
+                if (std::abs(m_sum) >= std::abs(x))
+                {
+                    m_compensation += (m_sum - t) + x;
+                }
+                else
+                {
+                    m_compensation += (x - t) + m_sum;
+                }
+                m_sum = t;
+            }
+
+            /**
+             * @brief Adds a partial sum, with its compensation.
+             */
+            void add(const compensated_sum& partial)
+            {
+                add(partial.m_sum);
+                add(partial.m_compensation);
+            }
+
+            double value() const
+            {
+                return m_sum + m_compensation;
+            }
+
+          private:
+
+            double m_sum          = 0;
+            double m_compensation = 0;
+        };
+
+        /**
+         * Reduction over the quadrature nodes of the cells of the field, with the parallel loops of the execution policy.
+         * The intervals are grouped in blocks of consecutive intervals of one level, of about execution::chunk_size nodes.
+         * accumulate(partial, weight, v, e) is called with the partial result of the block for each node and component of its cells,
+         * where weight is the quadrature weight, v the exact solution and e the error.
+         * The blocks only depend on the mesh: combining their partial results in the returned order (by increasing level)
+         * gives the same result for any policy and any number of threads.
+         * @return The level and the partial result of each block.
+         */
+        template <class Partial, class Policy, std::size_t polynomial_degree, class Field, class Func, class Accumulate>
+        auto reduce_on_nodes(Policy policy,
+                             const Field& approximate,
+                             Func& exact,
+                             const GaussLegendre<polynomial_degree>& gl,
+                             Accumulate&& accumulate)
+        {
+            static constexpr std::size_t dim  = Field::dim;
+            static constexpr std::size_t size = Field::size;
+
+            const auto& mesh            = approximate.mesh();
+            const std::size_t n_nodes   = gl.nb_nodes(dim);
+            const std::size_t max_chunk = std::max<std::size_t>(execution::chunk_size / n_nodes, 1);
+            auto list                   = get_interval_list(mesh, max_chunk);
+
+            std::vector<std::size_t> block_start;
+            std::size_t block_cells = 0;
+            for (std::size_t k = 0; k < list->intervals.size(); ++k)
+            {
+                if (k == 0 || list->levels[k] != list->levels[k - 1] || block_cells >= max_chunk)
+                {
+                    block_start.push_back(k);
+                    block_cells = 0;
+                }
+                block_cells += list->intervals[k].size();
+            }
+            block_start.push_back(list->intervals.size());
+
+            std::size_t n_blocks = block_start.size() - 1;
+            std::vector<std::pair<std::size_t, Partial>> partials(n_blocks);
+            auto exact_batch = as_batch<size, dim>(exact);
+            parallel_for(policy,
+                         n_blocks,
+                         [&](std::size_t b)
+                         {
+                             auto& [block_level, partial] = partials[b];
+                             block_level                  = list->levels[block_start[b]];
+
+                             xt::xtensor<double, 2> x;
+                             std::vector<double> node_weights;
+                             for (std::size_t k = block_start[b]; k < block_start[b + 1]; ++k)
+                             {
+                                 const auto& i = list->intervals[k];
+                                 gl.nodes(block_level, i, list->indices[k], x, node_weights);
+                                 auto u = make_field_row(approximate, block_level, i, list->indices[k]);
+                                 auto v = xt::eval(exact_batch(x));
+
+                                 // v is read as a flat buffer of n_nodes * n * size values
+                                 std::size_t n = i.size();
+                                 check_batch_values<size>(v, n_nodes * n);
+                                 for (std::size_t node = 0; node < n_nodes; ++node)
+                                 {
+                                     for (std::size_t c = 0; c < n; ++c)
+                                     {
+                                         for (std::size_t q = 0; q < size; ++q)
+                                         {
+                                             double vq = v.data()[(node * n + c) * size + q];
+                                             double eq = vq - static_cast<double>(u(static_cast<std::ptrdiff_t>(c), q));
+                                             accumulate(partial, node_weights[node], vq, eq);
+                                         }
+                                     }
+                                 }
+                             }
+                         });
+            return partials;
+        }
+    }
+
+    /**
+     * Computes the L1, L2 and Linf norms of the error with respect to an exact solution, with the batched quadrature.
+     * exact is a function of a single point, or a function of a batch of points marked by batch() (see GaussLegendre::quadrature()).
+     * The sums are compensated and reduced in a fixed order (see detail::reduce_on_nodes()), so that the result does not depend
+     * on the number of cells, nor on the execution policy. The Linf norm is the maximum over the quadrature points.
+     */
+    template <std::size_t polynomial_degree = 0, class Field, class Func>
+    error_norms compute_error_norms(const Field& approximate, Func&& exact, const GaussLegendre<polynomial_degree>& gl = {})
+    {
+        // Integrals of |e|, e^2, |v|, v^2, where e is the error and v the exact solution
+        enum : std::size_t
+        {
+            error_L1,
+            error_L2,
+            solution_L1,
+            solution_L2,
+            n_integrals
+        };
+        struct partial_norms
+        {
+            std::array<detail::compensated_sum, n_integrals> sums;
+            double error_max    = 0;
+            double solution_max = 0;
+        };
+
+        auto partials = detail::reduce_on_nodes<partial_norms>(execution::par,
+                                                                approximate,
+                                                                exact,
+                                                                gl,
+                                                                [](partial_norms& p, double weight, double v, double e)
+                                                                {
+                                                                    p.sums[error_L1].add(weight * std::abs(e));
+                                                                    p.sums[error_L2].add(weight * e * e);
+                                                                    p.sums[solution_L1].add(weight * std::abs(v));
+                                                                    p.sums[solution_L2].add(weight * v * v);
+                                                                    p.error_max    = std::max(p.error_max, std::abs(e));
+                                                                    p.solution_max = std::max(p.solution_max, std::abs(v));
+                                                                });
+
+        std::size_t max_level = partials.empty() ? 0 : partials.back().first;
+        std::vector<partial_norms> by_level(max_level + 1);
+        for (const auto& [level, p] : partials)
+        {
+            for (std::size_t q = 0; q < n_integrals; ++q)
+            {
+                by_level[level].sums[q].add(p.sums[q]);
+            }
+            by_level[level].error_max    = std::max(by_level[level].error_max, p.error_max);
+            by_level[level].solution_max = std::max(by_level[level].solution_max, p.solution_max);
+        }
+
+        error_norms result;
+        result.error_by_level.resize(max_level + 1);
+        std::array<detail::compensated_sum, n_integrals> total;
+        for (std::size_t level = 0; level <= max_level; ++level)
+        {
+            const auto& sums = by_level[level].sums;
+            for (std::size_t q = 0; q < n_integrals; ++q)
+            {
+                total[q].add(sums[q]);
+            }
+            result.error_by_level[level] = {sums[error_L1].value(), std::sqrt(sums[error_L2].value()), by_level[level].error_max};
+            result.error.Linf            = std::max(result.error.Linf, by_level[level].error_max);
+            result.solution.Linf         = std::max(result.solution.Linf, by_level[level].solution_max);
+        }
+        result.error.L1    = total[error_L1].value();
+        result.error.L2    = std::sqrt(total[error_L2].value());
+        result.solution.L1 = total[solution_L1].value();
+        result.solution.L2 = std::sqrt(total[solution_L2].value());
+        return result;
+    }
+
+    /**
+     * Computes the L2-error with respect to an exact solution, with one quadrature point per cell:
+     *       error^2 = sum over the cells of |exact(cell.center()) - approximate[cell]|^2 * cell.length^dim.
+     * Only the integrals of the L2 norm are computed (see compute_error_norms() for the other norms).
      * @tparam relative_error: if true, compute the relative error instead of the absolute one.
      */
     template <bool relative_error, class Field, class Func>
     double L2_error(Field& approximate, Func&& exact)
     {
-        // In FV, we want only 1 quadrature point.
-        // This is equivalent to
-        //       error += pow(exact(cell.center()) - approximate(cell.index), 2) * cell.length^dim;
-        GaussLegendre<0> gl;
-
-        double error_norm    = 0;
-        double solution_norm = 0;
-        for_each_cell(approximate.mesh(),
-                      [&](const auto& cell)
-                      {
-                          error_norm += gl.quadrature<1>(cell,
-                                                         [&](const auto& point)
-                                                         {
-                                                             auto e = exact(point) - approximate[cell];
-                                                             double norm_square;
-                                                             if constexpr (Field::size == 1)
-                                                             {
-                                                                 norm_square = e * e;
-                                                             }
-                                                             else
+        struct partial_L2
+        {
+            detail::compensated_sum error;
+            detail::compensated_sum solution;
+        };
+
+        auto partials = detail::reduce_on_nodes<partial_L2>(execution::par,
+                                                             approximate,
+                                                             exact,
+                                                             GaussLegendre<0>{},
+                                                             [](partial_L2& p, double weight, [[maybe_unused]] double v, double e)
                                                              {
-                                                                 norm_square = xt::sum(e * e)();
-                                                             }
-                                                             return norm_square;
-                                                         });
-                          if constexpr (relative_error)
-                          {
-                              solution_norm += gl.quadrature<1>(cell,
-                                                                [&](const auto& point)
-                                                                {
-                                                                    auto v = exact(point);
-                                                                    double v_square;
-                                                                    if constexpr (Field::size == 1)
-                                                                    {
-                                                                        v_square = v * v;
-                                                                    }
-                                                                    else
-                                                                    {
-                                                                        v_square = xt::sum(v * v)();
-                                                                    }
-                                                                    return v_square;
-                                                                });
-                          }
-                      });
+                                                                 p.error.add(weight * e * e);
+                                                                 if constexpr (relative_error)
+                                                                 {
+                                                                     p.solution.add(weight * v * v);
+                                                                 }
+                                                             });
 
-        error_norm    = sqrt(error_norm);
-        solution_norm = sqrt(solution_norm);
+        detail::compensated_sum error;
+        detail::compensated_sum solution;
+        for (const auto& [level, p] : partials)
+        {
+            error.add(p.error);
+            solution.add(p.solution);
+        }
         if constexpr (relative_error)
         {
-            return error_norm / solution_norm;
+            return std::sqrt(error.value() / solution.value());
         }
         else
         {
-            return error_norm;
+            return std::sqrt(error.value());
         }
     }
 
@@ -0,0 +1,79 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <cstddef>
+#include <stdexcept>
+#include <type_traits>
+
+#include <fmt/format.h>
+
+namespace samurai
+{
+    namespace detail
+    {
+        /**
+         * Raw access to the values of a row of cells of a field: (x, c) is the component c of the x-th cell of the row.
+         * The cells of a row are contiguous in the storage of the field, so that a loop over x has unit stride
+         * for scalar and SOA fields.
+         */
+        template <class value_t>
+        struct field_row
+        {
+            value_t* data;
+            std::ptrdiff_t cell_stride;
+            std::ptrdiff_t component_stride;
+
+            inline value_t& operator()(std::ptrdiff_t x, std::size_t c) const
+            {
+                return data[x * cell_stride + static_cast<std::ptrdiff_t>(c) * component_stride];
+            }
+        };
+
+        /**
+         * @brief Raw access to all the cells of the field: (x, c) is the component c of the cell of storage index x.
+         */
+        template <class Field>
+        inline auto make_field_cells(Field& f)
+        {
+            using field_t = std::remove_const_t<Field>;
+            using value_t = std::conditional_t<std::is_const_v<Field>, const typename field_t::value_type, typename field_t::value_type>;
+
+            value_t* data = f.array().data();
+            if constexpr (field_t::size == 1)
+            {
+                return field_row<value_t>{data, 1, 0};
+            }
+            else if constexpr (field_t::is_soa)
+            {
+                return field_row<value_t>{data, 1, static_cast<std::ptrdiff_t>(f.array().shape()[1])};
+            }
+            else
+            {
+                constexpr auto size = static_cast<std::ptrdiff_t>(field_t::size);
+                return field_row<value_t>{data, size, 1};
+            }
+        }
+
+        /**
+         * @brief Returns the row of the cells (level, interval, index...) of the field, starting at interval.start.
+         * All the cells of the interval must be stored in the field.
+         */
+        template <class Field, class... Index>
+        inline auto
+        make_field_row(Field& f, std::size_t level, const typename std::remove_const_t<Field>::interval_t& interval, Index... index)
+        {
+            const auto& stored = f.mesh().get_interval(level, interval, index...);
+            if (stored.end < interval.end || stored.start > interval.start)
+            {
+                throw std::out_of_range(fmt::format("FIELD ERROR on level {}: try to find interval {}", level, interval));
+            }
+
+            auto row = make_field_cells(f);
+            row.data += static_cast<std::ptrdiff_t>(stored.index + interval.start) * row.cell_stride;
+            return row;
+        }
+    }
+}
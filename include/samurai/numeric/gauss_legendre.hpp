@@ -1,9 +1,102 @@
 #pragma once
+#include <cstdint>
+#include <stdexcept>
+#include <type_traits>
+#include <vector>
+
+#include <fmt/format.h>
+
+#include <xtensor/xtensor.hpp>
+#include <xtensor/xview.hpp>
+
 #include "../cell.hpp"
 #include "../static_algorithm.hpp"
 
 namespace samurai
 {
+    /**
+     * Function of a batch of points, marked by batch().
+     */
+    template <class Func>
+    struct batch_function
+    {
+        Func function;
+
+        template <class Points>
+        inline decltype(auto) operator()(const Points& x) const
+        {
+            return function(x);
+        }
+    };
+
+    /**
+     * @brief Marks f(x) as a function of a batch of points: x has the shape (dim, n) and f(x) returns the values at the n points,
+     * with shape (n) for a scalar and (n, size) for a vector of the given size (see GaussLegendre::quadrature()).
+     * The functions which are not marked are functions of a single point, evaluated point by point.
+     */
+    template <class Func>
+    auto batch(Func&& f)
+    {
+        return batch_function<std::decay_t<Func>>{std::forward<Func>(f)};
+    }
+
+    namespace detail
+    {
+        template <class Func>
+        struct is_batch : std::false_type
+        {
+        };
+
+        template <class Func>
+        struct is_batch<batch_function<Func>> : std::true_type
+        {
+        };
+
+        template <class Func>
+        inline constexpr bool is_batch_v = is_batch<std::decay_t<Func>>::value;
+
+        // Rank of an array type known at compile time (SIZE_MAX if it is dynamic or unknown)
+        template <class T, class = void>
+        struct static_rank
+        {
+            static constexpr std::size_t value = SIZE_MAX;
+        };
+
+        template <class T>
+        struct static_rank<T, std::void_t<decltype(T::rank)>>
+        {
+            static constexpr std::size_t value = T::rank;
+        };
+
+        /**
+         * @brief Checks that the values returned by a function of a batch of n_points points have the shape (n_points)
+         * if func_result_size == 1, and (n_points, func_result_size) otherwise.
+         * The rank is checked at compile time when it is known, the shape at run time.
+         */
+        template <std::size_t func_result_size, class Values>
+        void check_batch_values(const Values& values, std::size_t n_points)
+        {
+            constexpr std::size_t rank = func_result_size == 1 ? 1 : 2;
+            static_assert(!std::is_arithmetic_v<Values>,
+                          "A function of a batch of points must return the array of its values at the points (see samurai::batch())");
+            static_assert(static_rank<Values>::value == rank || static_rank<Values>::value == SIZE_MAX,
+                          "A function of a batch of points must return an array of shape (n) for a scalar, and (n, size) for a vector");
+
+            bool valid = values.dimension() == rank && values.shape()[0] == n_points;
+            if constexpr (rank == 2)
+            {
+                valid = valid && values.shape()[1] == func_result_size;
+            }
+            if (!valid)
+            {
+                throw std::runtime_error(fmt::format("The function of a batch of {} points returned {} values instead of {}",
+                                                     n_points,
+                                                     values.size(),
+                                                     n_points * func_result_size));
+            }
+        }
+    }
+
     template <std::size_t polynomial_degree = 0>
     class GaussLegendre
     {
@@ -46,6 +139,125 @@ namespace samurai
             }
         }
 
+        /**
+         * @brief Number of quadrature nodes of a cell of dimension dim.
+         */
+        static constexpr std::size_t nb_nodes(std::size_t dim)
+        {
+            std::size_t n = 1;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                n *= n_points;
+            }
+            return n;
+        }
+
+        /**
+         * Quadrature nodes of all the cells of the row (level, i, index), in the array x of shape (dim, nb_nodes(dim) * i.size()),
+         * where x(d, q * i.size() + c) is the coordinate d of the node q of the c-th cell (each node of the cells is contiguous
+         * in the direction x). node_weights[q] is the weight of the node q, scaled by the volume of the cells.
+         * The arrays are resized only if the number of nodes changes, so that they can be reused from one row to the next.
+         */
+        template <class TInterval, class Index>
+        void nodes(std::size_t level,
+                   const TInterval& i,
+                   const Index& index,
+                   xt::xtensor<double, 2>& x,
+                   std::vector<double>& node_weights) const
+        {
+            const std::size_t dim     = index.size() + 1;
+            const double h            = cell_length(level);
+            const double half_h       = h / 2;
+            const std::size_t n       = i.size();
+            const std::size_t n_nodes = nb_nodes(dim);
+            double weight_scaling     = 1;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                weight_scaling *= half_h;
+            }
+
+            // node = q[0] + n_points * (q[1] + n_points * q[2])
+            node_weights.resize(n_nodes);
+            if (x.shape()[0] != dim || x.shape()[1] != n_nodes * n)
+            {
+                x = xt::empty<double>({dim, n_nodes * n});
+            }
+            for (std::size_t node = 0; node < n_nodes; ++node)
+            {
+                double weight  = weight_scaling;
+                std::size_t qd = node;
+                for (std::size_t d = 0; d < dim; ++d)
+                {
+                    std::size_t q = qd % n_points;
+                    qd /= n_points;
+                    weight *= weights[q];
+
+                    double node_offset = half_h * (1 + points[q]);
+                    for (std::size_t c = 0; c < n; ++c)
+                    {
+                        auto cell_index    = (d == 0) ? i.start + static_cast<typename TInterval::value_t>(c) : index[d - 1];
+                        x(d, node * n + c) = h * static_cast<double>(cell_index) + node_offset;
+                    }
+                }
+                node_weights[node] = weight;
+            }
+        }
+
+        /**
+         * Quadrature on all the cells of the row (level, i, index) at once.
+         * The integrand f is evaluated once, on the batch x of all the quadrature nodes of the row (see nodes()),
+         * so that f can be written with vectorized expressions.
+         * f must be marked by batch() and return the values at these points, with shape (nb_nodes(dim) * i.size())
+         * if func_result_size == 1, and (nb_nodes(dim) * i.size(), func_result_size) otherwise: std::runtime_error is thrown
+         * if the shape of the values is wrong. A function of a single point is evaluated point by point through detail::as_batch().
+         * @return The integrals of f on the cells of the row, with shape (i.size()) or (i.size(), func_result_size).
+         */
+        template <std::size_t func_result_size, class TInterval, class Index, class Func>
+        auto quadrature(std::size_t level, const TInterval& i, const Index& index, Func&& f) const
+        {
+            using result_t = std::conditional_t<func_result_size == 1, xt::xtensor<double, 1>, xt::xtensor<double, 2>>;
+
+            const std::size_t n       = i.size();
+            const std::size_t n_nodes = nb_nodes(index.size() + 1);
+
+            xt::xtensor<double, 2> x;
+            std::vector<double> node_weights;
+            nodes(level, i, index, x, node_weights);
+
+            static_assert(detail::is_batch_v<Func>,
+                          "GaussLegendre::quadrature: f must be a function of a batch of points (see samurai::batch())");
+            auto values = xt::eval(f(x));
+            detail::check_batch_values<func_result_size>(values, n_nodes * n);
+
+            result_t result;
+            if constexpr (func_result_size == 1)
+            {
+                result = xt::zeros<double>({n});
+            }
+            else
+            {
+                result = xt::zeros<double>({n, func_result_size});
+            }
+            for (std::size_t node = 0; node < n_nodes; ++node)
+            {
+                for (std::size_t c = 0; c < n; ++c)
+                {
+                    if constexpr (func_result_size == 1)
+                    {
+                        result(c) += node_weights[node] * values(node * n + c);
+                    }
+                    else
+                    {
+                        for (std::size_t k = 0; k < func_result_size; ++k)
+                        {
+                            result(c, k) += node_weights[node] * values(node * n + c, k);
+                        }
+                    }
+                }
+            }
+            return result;
+        }
+
       private:
 
         template <std::size_t dim, class TInterval, class FuncResultType, class Func>
@@ -601,4 +813,69 @@ namespace samurai
             }
         }
     };
+
+    namespace detail
+    {
+        /**
+         * @brief Turns the pointwise function f(point) into a function on the batches of points of GaussLegendre::quadrature().
+         */
+        template <std::size_t func_result_size, std::size_t dim, class Func>
+        auto pointwise_to_batch(Func& f)
+        {
+            return [&f](const auto& x)
+            {
+                using coords_t = xt::xtensor_fixed<double, xt::xshape<dim>>;
+                using values_t = std::conditional_t<func_result_size == 1, xt::xtensor<double, 1>, xt::xtensor<double, 2>>;
+
+                std::size_t n = x.shape()[1];
+                values_t values;
+                if constexpr (func_result_size == 1)
+                {
+                    values = xt::empty<double>({n});
+                }
+                else
+                {
+                    values = xt::empty<double>({n, func_result_size});
+                }
+                coords_t point;
+                for (std::size_t c = 0; c < n; ++c)
+                {
+                    for (std::size_t d = 0; d < dim; ++d)
+                    {
+                        point[d] = x(d, c);
+                    }
+                    if constexpr (func_result_size == 1)
+                    {
+                        values(c) = f(point);
+                    }
+                    else
+                    {
+                        xt::view(values, c) = f(point);
+                    }
+                }
+                return values;
+            };
+        }
+
+        /**
+         * @brief Function on the batches of points of GaussLegendre::quadrature(): f itself if it is marked by batch(),
+         * and otherwise its evaluation point by point.
+         */
+        template <std::size_t func_result_size, std::size_t dim, class Func>
+        auto as_batch(Func& f)
+        {
+            if constexpr (is_batch_v<Func>)
+            {
+                return batch(
+                    [&f](const auto& x)
+                    {
+                        return f(x);
+                    });
+            }
+            else
+            {
+                return batch(pointwise_to_batch<func_result_size, dim>(f));
+            }
+        }
+    }
 }
@@ -11,6 +11,7 @@
 #include <xtensor/xview.hpp>
 
 #include "../operators_base.hpp"
+#include "field_row.hpp"
 
 namespace samurai
 {
@@ -309,6 +310,192 @@ namespace samurai
         return qs(std::integral_constant<std::size_t, 1>{}, level, i, j, k);
     }
 
+    namespace detail
+    {
+        /**
+         * Prediction of a row of fine cells (fine_level, fine_i, fine_index...) from the level below.
+         * The loop runs over the parents X of the row: the quantities of X are computed once,
+         * then written to its two children 2X and 2X+1, which are adjacent in the fine row.
+         * The prediction of the child (a, b, c) of X (a, b, c = 0 or 1 in each direction) is
+         *
+         *   u + sa qs_i + sb qs_j + sc qs_k - sa sb qs_ij - sa sc qs_ik - sb sc qs_jk + sa sb sc qs_ijk,
+         *
+         * where sa = 1 - 2a (resp. sb, sc), and the qs are those of Qs_i, Qs_j, ..., Qs_ijk.
+         * The rows of the fields are accessed directly in their storage, with unit stride for scalar and SOA fields.
+         */
+        template <std::size_t order, class T1, class T2, class interval_t, class... Index>
+        void predict_fine_row(T1& dest, const T2& src, std::size_t fine_level, const interval_t& fine_i, Index... fine_index)
+        {
+            using value_t                    = typename interval_t::value_t;
+            static constexpr std::size_t dim = sizeof...(Index) + 1;
+            static constexpr auto p          = static_cast<value_t>(order);
+            static constexpr std::size_t w   = 2 * order + 1;
+
+            // Indices of the row in the other directions, and signs sb, sc of the fine cells in these directions
+            std::array<value_t, dim - 1> fine_jk{static_cast<value_t>(fine_index)...};
+            [[maybe_unused]] value_t coarse_j = 0;
+            [[maybe_unused]] value_t coarse_k = 0;
+            [[maybe_unused]] double sb        = 1;
+            [[maybe_unused]] double sc        = 1;
+            if constexpr (dim > 1)
+            {
+                coarse_j = fine_jk[0] >> 1;
+                sb       = (fine_jk[0] & 1) ? -1. : 1.;
+            }
+            if constexpr (dim > 2)
+            {
+                coarse_k = fine_jk[1] >> 1;
+                sc       = (fine_jk[1] & 1) ? -1. : 1.;
+            }
+
+            value_t first_parent = fine_i.start >> 1;
+            value_t last_parent  = (fine_i.end - 1) >> 1;
+            interval_t coarse_i{first_parent - p, last_parent + 1 + p};
+
+            // Source rows (j + tj, k + tk) at level - 1, for tj, tk in [-order, order], stored in rows[tk + p][tj + p]
+            static constexpr std::size_t wj = dim > 1 ? w : 1;
+            static constexpr std::size_t wk = dim > 2 ? w : 1;
+            using src_row_t                 = decltype(make_field_row(src, fine_level - 1, coarse_i, fine_index...));
+            std::array<std::array<src_row_t, wj>, wk> rows;
+            for (std::size_t rk = 0; rk < wk; ++rk)
+            {
+                for (std::size_t rj = 0; rj < wj; ++rj)
+                {
+                    [[maybe_unused]] auto tj = static_cast<value_t>(rj) - (dim > 1 ? p : 0);
+                    [[maybe_unused]] auto tk = static_cast<value_t>(rk) - (dim > 2 ? p : 0);
+                    if constexpr (dim == 1)
+                    {
+                        rows[rk][rj] = make_field_row(src, fine_level - 1, coarse_i);
+                    }
+                    else if constexpr (dim == 2)
+                    {
+                        rows[rk][rj] = make_field_row(src, fine_level - 1, coarse_i, coarse_j + tj);
+                    }
+                    else
+                    {
+                        rows[rk][rj] = make_field_row(src, fine_level - 1, coarse_i, coarse_j + tj, coarse_k + tk);
+                    }
+                }
+            }
+            auto fine_row = make_field_row(dest, fine_level, fine_i, fine_index...);
+
+            // Antisymmetric 1D weights of the prediction operator: weights[t + p] = sign(t) * coeffs[|t| - 1]
+            std::array<double, w> weights{};
+            if constexpr (order > 0)
+            {
+                auto coeffs = prediction_coeffs<order>();
+                for (std::size_t s = 1; s <= order; ++s)
+                {
+                    weights[order + s] = coeffs[s - 1];
+                    weights[order - s] = -coeffs[s - 1];
+                }
+            }
+
+            // Applies the 1D prediction operator in the directions (di, dj, dk) to the parent X
+            auto qs = [&](auto di, auto dj, auto dk, std::size_t c, value_t X)
+            {
+                static constexpr std::size_t ni = decltype(di)::value ? w : 1;
+                static constexpr std::size_t nj = decltype(dj)::value ? w : 1;
+                static constexpr std::size_t nk = decltype(dk)::value ? w : 1;
+
+                double result = 0;
+                for (std::size_t a = 0; a < nk; ++a)
+                {
+                    std::size_t rk = decltype(dk)::value ? a : wk / 2;
+                    double wgt_k   = decltype(dk)::value ? weights[a] : 1.;
+                    for (std::size_t b = 0; b < nj; ++b)
+                    {
+                        std::size_t rj = decltype(dj)::value ? b : wj / 2;
+                        double wgt_jk  = wgt_k * (decltype(dj)::value ? weights[b] : 1.);
+                        for (std::size_t e = 0; e < ni; ++e)
+                        {
+                            auto tx    = decltype(di)::value ? static_cast<value_t>(e) - p : 0;
+                            double wgt = wgt_jk * (decltype(di)::value ? weights[e] : 1.);
+                            result += wgt * rows[rk][rj](X + tx - coarse_i.start, c);
+                        }
+                    }
+                }
+                return result;
+            };
+            using yes = std::true_type;
+            using no  = std::false_type;
+
+            constexpr std::size_t n_components = std::remove_const_t<T2>::size;
+            for (std::size_t c = 0; c < n_components; ++c)
+            {
+                for (value_t X = first_parent; X <= last_parent; ++X)
+                {
+                    // Parts of the prediction that are even (a) and odd (b) in the direction x
+                    double a = rows[wk / 2][wj / 2](X - coarse_i.start, c);
+                    double b = 0;
+                    if constexpr (order > 0)
+                    {
+                        if constexpr (dim == 1)
+                        {
+                            b = qs(yes{}, no{}, no{}, c, X);
+                        }
+                        else if constexpr (dim == 2)
+                        {
+                            a += sb * qs(no{}, yes{}, no{}, c, X);
+                            b = qs(yes{}, no{}, no{}, c, X) - sb * qs(yes{}, yes{}, no{}, c, X);
+                        }
+                        else
+                        {
+                            a += sb * qs(no{}, yes{}, no{}, c, X) + sc * qs(no{}, no{}, yes{}, c, X)
+                               - sb * sc * qs(no{}, yes{}, yes{}, c, X);
+                            b = qs(yes{}, no{}, no{}, c, X) - sb * qs(yes{}, yes{}, no{}, c, X) - sc * qs(yes{}, no{}, yes{}, c, X)
+                              + sb * sc * qs(yes{}, yes{}, yes{}, c, X);
+                        }
+                    }
+
+                    value_t even = 2 * X;
+                    if (even >= fine_i.start)
+                    {
+                        fine_row(even - fine_i.start, c) = a + b;
+                    }
+                    if (even + 1 < fine_i.end)
+                    {
+                        fine_row(even + 1 - fine_i.start, c) = a - b;
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Prediction of the 2^dim children of the cells (level, i, index...): one call to predict_fine_row per row of children.
+         */
+        template <std::size_t order, class T1, class T2, class interval_t, class... Index>
+        void predict_children(T1& dest, const T2& src, std::size_t level, const interval_t& i, Index... index)
+        {
+            using value_t = typename interval_t::value_t;
+
+            interval_t fine_i{2 * i.start, 2 * i.end};
+            std::array<value_t, sizeof...(Index)> coarse_jk{static_cast<value_t>(index)...};
+            if constexpr (sizeof...(Index) == 0)
+            {
+                predict_fine_row<order>(dest, src, level + 1, fine_i);
+            }
+            else if constexpr (sizeof...(Index) == 1)
+            {
+                for (value_t fine_j = 2 * coarse_jk[0]; fine_j < 2 * coarse_jk[0] + 2; ++fine_j)
+                {
+                    predict_fine_row<order>(dest, src, level + 1, fine_i, fine_j);
+                }
+            }
+            else
+            {
+                for (value_t fine_k = 2 * coarse_jk[1]; fine_k < 2 * coarse_jk[1] + 2; ++fine_k)
+                {
+                    for (value_t fine_j = 2 * coarse_jk[0]; fine_j < 2 * coarse_jk[0] + 2; ++fine_j)
+                    {
+                        predict_fine_row<order>(dest, src, level + 1, fine_i, fine_j, fine_k);
+                    }
+                }
+            }
+        }
+    }
+
+
     /////////////////////////
     // prediction operator //
     /////////////////////////
@@ -371,11 +558,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, 0>,
                                                      std::integral_constant<bool, true>) const
     {
-        auto ii = i << 1;
-        ii.step = 2;
-
-        dest(level + 1, ii)     = src(level, i);
-        dest(level + 1, ii + 1) = src(level, i);
+        detail::predict_children<0>(dest, src, level, i);
     }
 
     template <class TInterval>
@@ -386,19 +569,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, 0>,
                                                      std::integral_constant<bool, false>) const
     {
-        auto even_i = i.even_elements();
-        if (even_i.is_valid())
-        {
-            auto coarse_even_i  = even_i >> 1;
-            dest(level, even_i) = src(level - 1, coarse_even_i);
-        }
-
-        auto odd_i = i.odd_elements();
-        if (odd_i.is_valid())
-        {
-            auto coarse_odd_i  = odd_i >> 1;
-            dest(level, odd_i) = src(level - 1, coarse_odd_i);
-        }
+        detail::predict_fine_row<0>(dest, src, level, i);
     }
 
     template <class TInterval>
@@ -409,13 +580,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, order>,
                                                      std::integral_constant<bool, true>) const
     {
-        auto ii = i << 1;
-        ii.step = 2;
-
-        auto qs_i = Qs_i<order>(src, level, i);
-
-        dest(level + 1, ii)     = src(level, i) + qs_i;
-        dest(level + 1, ii + 1) = src(level, i) - qs_i;
+        detail::predict_children<order>(dest, src, level, i);
     }
 
     template <class TInterval>
@@ -426,23 +591,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, order>,
                                                      std::integral_constant<bool, false>) const
     {
-        auto qs_i = Qs_i<order>(src, level - 1, i >> 1);
-
-        auto even_i = i.even_elements();
-        if (even_i.is_valid())
-        {
-            auto coarse_even_i  = even_i >> 1;
-            auto dec_even       = (i.start & 1) ? 1 : 0;
-            dest(level, even_i) = src(level - 1, coarse_even_i) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]));
-        }
-
-        auto odd_i = i.odd_elements();
-        if (odd_i.is_valid())
-        {
-            auto coarse_odd_i  = odd_i >> 1;
-            auto dec_odd       = (i.end & 1) ? 1 : 0;
-            dest(level, odd_i) = src(level - 1, coarse_odd_i) - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)));
-        }
+        detail::predict_fine_row<order>(dest, src, level, i);
     }
 
     template <class TInterval>
@@ -453,15 +602,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, 0>,
                                                      std::integral_constant<bool, true>) const
     {
-        auto ii = i << 1;
-        ii.step = 2;
-
-        auto jj = j << 1;
-
-        dest(level + 1, ii, jj)         = src(level, i, j);
-        dest(level + 1, ii + 1, jj)     = src(level, i, j);
-        dest(level + 1, ii, jj + 1)     = src(level, i, j);
-        dest(level + 1, ii + 1, jj + 1) = src(level, i, j);
+        detail::predict_children<0>(dest, src, level, i, j);
     }
 
     template <class TInterval>
@@ -472,38 +613,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, 0>,
                                                      std::integral_constant<bool, false>) const
     {
-        if (j & 1)
-        {
-            auto even_i = i.even_elements();
-            if (even_i.is_valid())
-            {
-                auto coarse_even_i     = even_i >> 1;
-                dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1);
-            }
-
-            auto odd_i = i.odd_elements();
-            if (odd_i.is_valid())
-            {
-                auto coarse_odd_i     = odd_i >> 1;
-                dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1);
-            }
-        }
-        else
-        {
-            auto even_i = i.even_elements();
-            if (even_i.is_valid())
-            {
-                auto coarse_even_i     = even_i >> 1;
-                dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1);
-            }
-
-            auto odd_i = i.odd_elements();
-            if (odd_i.is_valid())
-            {
-                auto coarse_odd_i     = odd_i >> 1;
-                dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1);
-            }
-        }
+        detail::predict_fine_row<0>(dest, src, level, i, j);
     }
 
     template <class TInterval>
@@ -514,19 +624,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, order>,
                                                      std::integral_constant<bool, true>) const
     {
-        auto ii = i << 1;
-        ii.step = 2;
-
-        auto jj = j << 1;
-
-        auto qs_i  = Qs_i<order>(src, level, i, j);
-        auto qs_j  = Qs_j<order>(src, level, i, j);
-        auto qs_ij = Qs_ij<order>(src, level, i, j);
-
-        dest(level + 1, ii, jj)         = src(level, i, j) + qs_i + qs_j - qs_ij;
-        dest(level + 1, ii + 1, jj)     = src(level, i, j) - qs_i + qs_j + qs_ij;
-        dest(level + 1, ii, jj + 1)     = src(level, i, j) + qs_i - qs_j + qs_ij;
-        dest(level + 1, ii + 1, jj + 1) = src(level, i, j) - qs_i - qs_j - qs_ij;
+        detail::predict_children<order>(dest, src, level, i, j);
     }
 
     template <class TInterval>
@@ -537,96 +635,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, order>,
                                                      std::integral_constant<bool, false>) const
     {
-        auto qs_i  = Qs_i<order>(src, level - 1, i >> 1, j >> 1);
-        auto qs_j  = Qs_j<order>(src, level - 1, i >> 1, j >> 1);
-        auto qs_ij = Qs_ij<order>(src, level - 1, i >> 1, j >> 1);
-
-        if (j & 1)
-        {
-            auto even_i = i.even_elements();
-            if (even_i.is_valid())
-            {
-                auto coarse_even_i = even_i >> 1;
-                auto dec_even      = (i.start & 1) ? 1 : 0;
-                if constexpr (T1::is_soa && T1::size > 1)
-                {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1)
-                                           + xt::view(qs_i, xt::all(), xt::range(dec_even, qs_i.shape()[1]))
-                                           - xt::view(qs_j, xt::all(), xt::range(dec_even, qs_j.shape()[1]))
-                                           + xt::view(qs_ij, xt::all(), xt::range(dec_even, qs_ij.shape()[1]));
-                }
-                else
-                {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                           - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                           + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]));
-                }
-            }
-
-            auto odd_i = i.odd_elements();
-            if (odd_i.is_valid())
-            {
-                auto coarse_odd_i = odd_i >> 1;
-                auto dec_odd      = (i.end & 1) ? 1 : 0;
-                if constexpr (T1::is_soa && T1::size > 1)
-                {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::all(), xt::range(0, safe_subs<int>(qs_i.shape()[1], dec_odd)))
-                                          - xt::view(qs_j, xt::all(), xt::range(0, safe_subs<int>(qs_j.shape()[1], dec_odd)))
-                                          - xt::view(qs_ij, xt::all(), xt::range(0, safe_subs<int>(qs_ij.shape()[1], dec_odd)));
-                }
-                else
-                {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                          - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                          - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
-                }
-            }
-        }
-        else
-        {
-            auto even_i = i.even_elements();
-            if (even_i.is_valid())
-            {
-                auto coarse_even_i = even_i >> 1;
-                auto dec_even      = (i.start & 1) ? 1 : 0;
-                if constexpr (T1::is_soa && T1::size > 1)
-                {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1)
-                                           + xt::view(qs_i, xt::all(), xt::range(dec_even, qs_i.shape()[1]))
-                                           + xt::view(qs_j, xt::all(), xt::range(dec_even, qs_j.shape()[1]))
-                                           - xt::view(qs_ij, xt::all(), xt::range(dec_even, qs_ij.shape()[1]));
-                }
-                else
-                {
-                    dest(level, even_i, j) = src(level - 1, coarse_even_i, j >> 1) + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                           + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                           - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]));
-                }
-            }
-
-            auto odd_i = i.odd_elements();
-            if (odd_i.is_valid())
-            {
-                auto coarse_odd_i = odd_i >> 1;
-                auto dec_odd      = (i.end & 1) ? 1 : 0;
-                if constexpr (T1::is_soa && T1::size > 1)
-                {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::all(), xt::range(0, safe_subs<int>(qs_i.shape()[1], dec_odd)))
-                                          + xt::view(qs_j, xt::all(), xt::range(0, safe_subs<int>(qs_j.shape()[1], dec_odd)))
-                                          + xt::view(qs_ij, xt::all(), xt::range(0, safe_subs<int>(qs_ij.shape()[1], dec_odd)));
-                }
-                else
-                {
-                    dest(level, odd_i, j) = src(level - 1, coarse_odd_i, j >> 1)
-                                          - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                          + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                          + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
-                }
-            }
-        }
+        detail::predict_fine_row<order>(dest, src, level, i, j);
     }
 
     template <class TInterval>
@@ -637,20 +646,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, 0>,
                                                      std::integral_constant<bool, true>) const
     {
-        auto ii = i << 1;
-        ii.step = 2;
-
-        auto jj = j << 1;
-        auto kk = k << 1;
-
-        dest(level + 1, ii, jj, kk)             = src(level, i, j, k);
-        dest(level + 1, ii + 1, jj, kk)         = src(level, i, j, k);
-        dest(level + 1, ii, jj + 1, kk)         = src(level, i, j, k);
-        dest(level + 1, ii + 1, jj + 1, kk)     = src(level, i, j, k);
-        dest(level + 1, ii, jj, kk + 1)         = src(level, i, j, k);
-        dest(level + 1, ii + 1, jj, kk + 1)     = src(level, i, j, k);
-        dest(level + 1, ii, jj + 1, kk + 1)     = src(level, i, j, k);
-        dest(level + 1, ii + 1, jj + 1, kk + 1) = src(level, i, j, k);
+        detail::predict_children<0>(dest, src, level, i, j, k);
     }
 
     template <class TInterval>
@@ -661,19 +657,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, 0>,
                                                      std::integral_constant<bool, false>) const
     {
-        auto even_i = i.even_elements();
-        if (even_i.is_valid())
-        {
-            auto coarse_even_i        = even_i >> 1;
-            dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1);
-        }
-
-        auto odd_i = i.odd_elements();
-        if (odd_i.is_valid())
-        {
-            auto coarse_odd_i        = odd_i >> 1;
-            dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1);
-        }
+        detail::predict_fine_row<0>(dest, src, level, i, j, k);
     }
 
     template <class TInterval>
@@ -684,28 +668,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, order>,
                                                      std::integral_constant<bool, true>) const
     {
-        auto ii = i << 1;
-        ii.step = 2;
-
-        auto jj = j << 1;
-        auto kk = k << 1;
-
-        auto qs_i   = Qs_i<order>(src, level, i, j, k);
-        auto qs_j   = Qs_j<order>(src, level, i, j, k);
-        auto qs_k   = Qs_k<order>(src, level, i, j, k);
-        auto qs_ij  = Qs_ij<order>(src, level, i, j, k);
-        auto qs_ik  = Qs_ik<order>(src, level, i, j, k);
-        auto qs_jk  = Qs_jk<order>(src, level, i, j, k);
-        auto qs_ijk = Qs_ijk<order>(src, level, i, j, k);
-
-        dest(level + 1, ii, jj, kk)             = src(level, i, j, k) + qs_i + qs_j + qs_k - qs_ij - qs_ik - qs_jk + qs_ijk;
-        dest(level + 1, ii + 1, jj, kk)         = src(level, i, j, k) - qs_i + qs_j + qs_k + qs_ij + qs_ik - qs_jk - qs_ijk;
-        dest(level + 1, ii, jj + 1, kk)         = src(level, i, j, k) + qs_i - qs_j + qs_k + qs_ij - qs_ik + qs_jk - qs_ijk;
-        dest(level + 1, ii + 1, jj + 1, kk)     = src(level, i, j, k) - qs_i - qs_j + qs_k - qs_ij + qs_ik + qs_jk + qs_ijk;
-        dest(level + 1, ii, jj, kk + 1)         = src(level, i, j, k) + qs_i + qs_j - qs_k - qs_ij + qs_ik + qs_jk - qs_ijk;
-        dest(level + 1, ii + 1, jj, kk + 1)     = src(level, i, j, k) - qs_i + qs_j - qs_k + qs_ij - qs_ik + qs_jk + qs_ijk;
-        dest(level + 1, ii, jj + 1, kk + 1)     = src(level, i, j, k) + qs_i - qs_j - qs_k + qs_ij + qs_ik - qs_jk + qs_ijk;
-        dest(level + 1, ii + 1, jj + 1, kk + 1) = src(level, i, j, k) - qs_i - qs_j - qs_k - qs_ij - qs_ik - qs_jk - qs_ijk;
+        detail::predict_children<order>(dest, src, level, i, j, k);
     }
 
     template <class TInterval>
@@ -716,148 +679,7 @@ namespace samurai
                                                      std::integral_constant<std::size_t, order>,
                                                      std::integral_constant<bool, false>) const
     {
-        auto qs_i   = Qs_i<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-        auto qs_j   = Qs_j<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-        auto qs_k   = Qs_k<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-        auto qs_ij  = Qs_ij<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-        auto qs_ik  = Qs_ik<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-        auto qs_jk  = Qs_jk<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-        auto qs_ijk = Qs_ijk<order>(src, level - 1, i >> 1, j >> 1, k >> 1);
-
-        if (k & 1)
-        {
-            if (j & 1)
-            {
-                auto even_i = i.even_elements();
-                if (even_i.is_valid())
-                {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              - xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              + xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              - xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              + xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
-                }
-
-                auto odd_i = i.odd_elements();
-                if (odd_i.is_valid())
-                {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             - xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
-                    -xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)));
-                    -xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)));
-                    -xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
-                }
-            }
-            else
-            {
-                auto even_i = i.even_elements();
-                if (even_i.is_valid())
-                {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              - xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              + xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              + xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              - xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
-                }
-
-                auto odd_i = i.odd_elements();
-                if (odd_i.is_valid())
-                {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             - xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
-                    -xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)));
-                    +xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)));
-                    +xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
-                }
-            }
-        }
-        else
-        {
-            if (j & 1)
-            {
-                auto even_i = i.even_elements();
-                if (even_i.is_valid())
-                {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              - xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              + xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              + xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              - xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              + xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              - xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
-                }
-
-                auto odd_i = i.odd_elements();
-                if (odd_i.is_valid())
-                {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             - xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             + xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             - xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
-                    +xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)));
-                    +xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)));
-                    +xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
-                }
-            }
-            else
-            {
-                auto even_i = i.even_elements();
-                if (even_i.is_valid())
-                {
-                    auto coarse_even_i        = even_i >> 1;
-                    auto dec_even             = (i.start & 1) ? 1 : 0;
-                    dest(level, even_i, j, k) = src(level - 1, coarse_even_i, j >> 1, k >> 1)
-                                              + xt::view(qs_i, xt::range(dec_even, qs_i.shape()[0]))
-                                              + xt::view(qs_j, xt::range(dec_even, qs_j.shape()[0]))
-                                              + xt::view(qs_k, xt::range(dec_even, qs_k.shape()[0]))
-                                              - xt::view(qs_ij, xt::range(dec_even, qs_ij.shape()[0]))
-                                              - xt::view(qs_ik, xt::range(dec_even, qs_ik.shape()[0]))
-                                              - xt::view(qs_jk, xt::range(dec_even, qs_jk.shape()[0]))
-                                              + xt::view(qs_ijk, xt::range(dec_even, qs_ijk.shape()[0]));
-                }
-
-                auto odd_i = i.odd_elements();
-                if (odd_i.is_valid())
-                {
-                    auto coarse_odd_i        = odd_i >> 1;
-                    auto dec_odd             = (i.end & 1) ? 1 : 0;
-                    dest(level, odd_i, j, k) = src(level - 1, coarse_odd_i, j >> 1, k >> 1)
-                                             - xt::view(qs_i, xt::range(0, safe_subs<int>(qs_i.shape()[0], dec_odd)))
-                                             + xt::view(qs_j, xt::range(0, safe_subs<int>(qs_j.shape()[0], dec_odd)))
-                                             + xt::view(qs_k, xt::range(0, safe_subs<int>(qs_k.shape()[0], dec_odd)))
-                                             + xt::view(qs_ij, xt::range(0, safe_subs<int>(qs_ij.shape()[0], dec_odd)));
-                    +xt::view(qs_ik, xt::range(0, safe_subs<int>(qs_ik.shape()[0], dec_odd)));
-                    -xt::view(qs_jk, xt::range(0, safe_subs<int>(qs_jk.shape()[0], dec_odd)));
-                    -xt::view(qs_ijk, xt::range(0, safe_subs<int>(qs_ijk.shape()[0], dec_odd)));
-                }
-            }
-        }
+        detail::predict_fine_row<order>(dest, src, level, i, j, k);
     }
 
     template <class TInterval>
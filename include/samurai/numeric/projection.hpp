@@ -4,10 +4,71 @@
 
 #pragma once
 
+#include <array>
+#include <type_traits>
+
 #include "../operators_base.hpp"
+#include "field_row.hpp"
 
 namespace samurai
 {
+    namespace detail
+    {
+        /**
+         * @brief Projection of the cells (level, i, index...): mean of their children, read row by row.
+         * The loop over the parents of a row of children reads the two children 2X and 2X+1, which are adjacent in the row.
+         */
+        template <class T1, class T2, class interval_t, class... Index>
+        void project_row(T1& dest, const T2& src, std::size_t level, const interval_t& i, Index... index)
+        {
+            using value_t                             = typename interval_t::value_t;
+            static constexpr std::size_t dim          = sizeof...(Index) + 1;
+            static constexpr std::size_t n_rows       = 1 << (dim - 1);
+            static constexpr std::size_t n_components = std::remove_const_t<T2>::size;
+            static constexpr double coeff             = 1. / (1 << dim);
+
+            // Rows of children at level + 1
+            interval_t fine_i{2 * i.start, 2 * i.end};
+            std::array<value_t, dim - 1> coarse_jk{static_cast<value_t>(index)...};
+            using src_row_t = decltype(make_field_row(src, level + 1, fine_i, index...));
+            std::array<src_row_t, n_rows> rows;
+            for (std::size_t r = 0; r < n_rows; ++r)
+            {
+                if constexpr (dim == 1)
+                {
+                    rows[r] = make_field_row(src, level + 1, fine_i);
+                }
+                else if constexpr (dim == 2)
+                {
+                    rows[r] = make_field_row(src, level + 1, fine_i, 2 * coarse_jk[0] + static_cast<value_t>(r));
+                }
+                else
+                {
+                    rows[r] = make_field_row(src,
+                                             level + 1,
+                                             fine_i,
+                                             2 * coarse_jk[0] + static_cast<value_t>(r & 1),
+                                             2 * coarse_jk[1] + static_cast<value_t>(r >> 1));
+                }
+            }
+            auto row = make_field_row(dest, level, i, index...);
+
+            auto size = static_cast<std::ptrdiff_t>(i.end - i.start);
+            for (std::size_t c = 0; c < n_components; ++c)
+            {
+                for (std::ptrdiff_t x = 0; x < size; ++x)
+                {
+                    double sum = 0;
+                    for (std::size_t r = 0; r < n_rows; ++r)
+                    {
+                        sum += rows[r](2 * x, c) + rows[r](2 * x + 1, c);
+                    }
+                    row(x, c) = coeff * sum;
+                }
+            }
+        }
+    }
+
     /////////////////////////
     // projection operator //
     /////////////////////////
@@ -22,25 +83,19 @@ namespace samurai
         template <class T1, class T2>
         inline void operator()(Dim<1>, T1& dest, const T2& src) const
         {
-            dest(level, i) = .5 * (src(level + 1, 2 * i) + src(level + 1, 2 * i + 1));
+            detail::project_row(dest, src, level, i);
         }
 
         template <class T1, class T2>
         inline void operator()(Dim<2>, T1& dest, const T2& src) const
         {
-            dest(level, i, j) = .25
-                              * (src(level + 1, 2 * i, 2 * j) + src(level + 1, 2 * i, 2 * j + 1) + src(level + 1, 2 * i + 1, 2 * j)
-                                 + src(level + 1, 2 * i + 1, 2 * j + 1));
+            detail::project_row(dest, src, level, i, j);
         }
 
         template <class T1, class T2>
         inline void operator()(Dim<3>, T1& dest, const T2& src) const
         {
-            dest(level, i, j, k) = .125
-                                 * (src(level + 1, 2 * i, 2 * j, 2 * k) + src(level + 1, 2 * i + 1, 2 * j, 2 * k)
-                                    + src(level + 1, 2 * i, 2 * j + 1, 2 * k) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k)
-                                    + src(level + 1, 2 * i, 2 * j, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j, 2 * k + 1)
-                                    + src(level + 1, 2 * i, 2 * j + 1, 2 * k + 1) + src(level + 1, 2 * i + 1, 2 * j + 1, 2 * k + 1));
+            detail::project_row(dest, src, level, i, j, k);
         }
     };
 
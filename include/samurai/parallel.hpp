@@ -0,0 +1,518 @@
+// Copyright 2021 SAMURAI TEAM. All rights reserved.
+// Use of this source code is governed by a BSD-style
+// license that can be found in the LICENSE file.
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#ifdef SAMURAI_WITH_OPENMP
+#include <omp.h>
+#endif
+
+#include <xtensor/xfixed.hpp>
+
+#include "algorithm.hpp"
+
+namespace samurai
+{
+    /**
+     * Execution policies of the parallel loops. The policy used by the kernels of the library is default_policy,
+     * selected at compile time: OpenMP if SAMURAI_WITH_OPENMP is defined, the thread pool if SAMURAI_WITH_THREADS is defined,
+     * sequential otherwise.
+     */
+    namespace execution
+    {
+        struct sequential_policy
+        {
+        };
+
+        struct thread_pool_policy
+        {
+        };
+
+        struct openmp_policy
+        {
+        };
+
+        inline constexpr sequential_policy seq{};
+        inline constexpr thread_pool_policy thread_pool{};
+        inline constexpr openmp_policy openmp{};
+
+#if defined(SAMURAI_WITH_OPENMP)
+        using default_policy = openmp_policy;
+#elif defined(SAMURAI_WITH_THREADS)
+        using default_policy = thread_pool_policy;
+#else
+        using default_policy = sequential_policy;
+#endif
+        inline constexpr default_policy par{};
+
+        // Maximal number of cells of the chunks of intervals given to a thread by the field assignments
+        inline constexpr std::size_t chunk_size = 4096;
+    }
+
+    /**
+     * Pool of std::threads running the loops of the thread_pool policy. The iterations of a loop are split in one range
+     * per thread; a thread takes chunks of its own range and, when it is exhausted, steals chunks from the ranges of the
+     * other threads, so that the load is balanced even if the cost of the iterations varies (intervals of different lengths).
+     *
+     * The number of threads is given by the environment variable SAMURAI_NUM_THREADS, or is the number of hardware threads.
+     * The calling thread takes part in the loop. A loop started from inside a loop runs sequentially.
+     */
+    class ThreadPool
+    {
+      public:
+
+        static ThreadPool& instance()
+        {
+            static ThreadPool pool(default_num_threads());
+            return pool;
+        }
+
+        explicit ThreadPool(std::size_t num_threads)
+        {
+            start(num_threads);
+        }
+
+        ~ThreadPool()
+        {
+            stop();
+        }
+
+        ThreadPool(const ThreadPool&)            = delete;
+        ThreadPool& operator=(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&)                 = delete;
+        ThreadPool& operator=(ThreadPool&&)      = delete;
+
+        /**
+         * @brief Number of threads running the loops, including the calling thread.
+         */
+        std::size_t num_threads() const
+        {
+            return m_workers.size() + 1;
+        }
+
+        void set_num_threads(std::size_t num_threads)
+        {
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+            stop();
+            start(num_threads);
+        }
+
+        /**
+         * @brief Calls f(begin, end) on chunks of at most grain iterations covering [0, n).
+         */
+        template <class Func>
+        void parallel_for(std::size_t n, std::size_t grain, Func&& f)
+        {
+            grain = std::max<std::size_t>(grain, 1);
+            if (n <= grain || m_workers.empty() || t_in_loop)
+            {
+                if (n > 0)
+                {
+                    f(std::size_t{0}, n);
+                }
+                return;
+            }
+
+            std::lock_guard<std::mutex> run_lock(m_run_mutex);
+
+            const std::size_t n_ranges = num_threads();
+            std::vector<range> ranges(n_ranges);
+            for (std::size_t t = 0; t < n_ranges; ++t)
+            {
+                ranges[t].next = t * n / n_ranges;
+                ranges[t].end  = (t + 1) * n / n_ranges;
+            }
+
+            std::exception_ptr error;
+            std::mutex error_mutex;
+            std::function<void(std::size_t)> job = [&](std::size_t thread_id)
+            {
+                t_in_loop = true;
+                try
+                {
+                    for (std::size_t k = 0; k < n_ranges; ++k)
+                    {
+                        auto& r = ranges[(thread_id + k) % n_ranges];
+                        for (std::size_t begin = r.next.fetch_add(grain); begin < r.end; begin = r.next.fetch_add(grain))
+                        {
+                            f(begin, std::min(begin + grain, r.end));
+                        }
+                    }
+                }
+                catch (...)
+                {
+                    std::lock_guard<std::mutex> lock(error_mutex);
+                    if (!error)
+                    {
+                        error = std::current_exception();
+                    }
+                }
+                t_in_loop = false;
+            };
+
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_job     = &job;
+                m_running = m_workers.size();
+                ++m_job_id;
+            }
+            m_start.notify_all();
+            job(0);
+            {
+                std::unique_lock<std::mutex> lock(m_mutex);
+                m_done.wait(lock,
+                            [&]()
+                            {
+                                return m_running == 0;
+                            });
+                m_job = nullptr;
+            }
+
+            if (error)
+            {
+                std::rethrow_exception(error);
+            }
+        }
+
+      private:
+
+        struct range
+        {
+            std::atomic<std::size_t> next{0};
+            std::size_t end = 0;
+        };
+
+        static std::size_t default_num_threads()
+        {
+            if (const char* env = std::getenv("SAMURAI_NUM_THREADS"))
+            {
+                auto n = std::strtoul(env, nullptr, 10);
+                if (n > 0)
+                {
+                    return n;
+                }
+            }
+            return std::max<std::size_t>(std::thread::hardware_concurrency(), 1);
+        }
+
+        void start(std::size_t num_threads)
+        {
+            m_stop             = false;
+            std::size_t job_id = m_job_id;
+            for (std::size_t t = 1; t < std::max<std::size_t>(num_threads, 1); ++t)
+            {
+                m_workers.emplace_back(
+                    [this, t, job_id]()
+                    {
+                        work(t, job_id);
+                    });
+            }
+        }
+
+        void stop()
+        {
+            {
+                std::lock_guard<std::mutex> lock(m_mutex);
+                m_stop = true;
+            }
+            m_start.notify_all();
+            for (auto& worker : m_workers)
+            {
+                worker.join();
+            }
+            m_workers.clear();
+        }
+
+        /**
+         * @brief Runs the jobs posted after job_id, the last job when the worker was created.
+         */
+        void work(std::size_t thread_id, std::size_t job_id)
+        {
+            while (true)
+            {
+                const std::function<void(std::size_t)>* job = nullptr;
+                {
+                    std::unique_lock<std::mutex> lock(m_mutex);
+                    m_start.wait(lock,
+                                 [&]()
+                                 {
+                                     return m_stop || m_job_id != job_id;
+                                 });
+                    if (m_stop)
+                    {
+                        return;
+                    }
+                    job_id = m_job_id;
+                    job    = m_job;
+                }
+
+                (*job)(thread_id);
+
+                std::lock_guard<std::mutex> lock(m_mutex);
+                if (--m_running == 0)
+                {
+                    m_done.notify_one();
+                }
+            }
+        }
+
+        static inline thread_local bool t_in_loop = false;
+
+        std::vector<std::thread> m_workers;
+        std::mutex m_run_mutex; // one loop at a time
+        std::mutex m_mutex;
+        std::condition_variable m_start;
+        std::condition_variable m_done;
+        const std::function<void(std::size_t)>* m_job = nullptr;
+        std::size_t m_job_id                           = 0;
+        std::size_t m_running                          = 0;
+        bool m_stop                                    = false;
+    };
+
+    /**
+     * @brief Calls f(k) for 0 <= k < n; the iterations must be independent.
+     */
+    template <class Func>
+    void parallel_for(execution::sequential_policy, std::size_t n, Func&& f)
+    {
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            f(k);
+        }
+    }
+
+    template <class Func>
+    void parallel_for(execution::thread_pool_policy, std::size_t n, Func&& f)
+    {
+        auto& pool        = ThreadPool::instance();
+        std::size_t grain = std::max<std::size_t>(n / (16 * pool.num_threads()), 1);
+        pool.parallel_for(n,
+                          grain,
+                          [&](std::size_t begin, std::size_t end)
+                          {
+                              for (std::size_t k = begin; k < end; ++k)
+                              {
+                                  f(k);
+                              }
+                          });
+    }
+
+    /**
+     * The iterations must not throw: an exception cannot leave an OpenMP parallel region.
+     */
+    template <class Func>
+    void parallel_for([[maybe_unused]] execution::openmp_policy policy, std::size_t n, Func&& f)
+    {
+#ifdef SAMURAI_WITH_OPENMP
+        const auto n_iterations = static_cast<std::ptrdiff_t>(n);
+#pragma omp parallel for schedule(dynamic, 16)
+        for (std::ptrdiff_t k = 0; k < n_iterations; ++k)
+        {
+            f(static_cast<std::size_t>(k));
+        }
+#else
+        parallel_for(execution::seq, n, std::forward<Func>(f));
+#endif
+    }
+
+    namespace detail
+    {
+        /**
+         * Intervals of a set (mesh, CellArray or LevelCellArray) stored flat, to be distributed among the threads.
+         * The intervals are sorted by level.
+         */
+        template <std::size_t dim, class TInterval>
+        struct interval_list
+        {
+            using index_t = xt::xtensor_fixed<typename TInterval::value_t, xt::xshape<dim - 1>>;
+
+            std::vector<std::size_t> levels;
+            std::vector<TInterval> intervals;
+            std::vector<index_t> indices;
+
+            /**
+             * @brief Range [first, last) of the intervals of the level.
+             */
+            std::pair<std::size_t, std::size_t> level_range(std::size_t level) const
+            {
+                auto first = std::lower_bound(levels.begin(), levels.end(), level);
+                auto last  = std::upper_bound(first, levels.end(), level);
+                return {static_cast<std::size_t>(first - levels.begin()), static_cast<std::size_t>(last - levels.begin())};
+            }
+        };
+
+        /**
+         * @brief Intervals of the set, split into chunks of at most max_chunk cells if max_chunk > 0.
+         */
+        template <class Set>
+        auto make_interval_list(Set& set, std::size_t max_chunk)
+        {
+            using set_t      = std::decay_t<Set>;
+            using interval_t = typename set_t::interval_t;
+            using value_t    = typename interval_t::value_t;
+
+            interval_list<set_t::dim, interval_t> list;
+            for_each_interval(set,
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  auto chunk = (max_chunk > 0) ? static_cast<value_t>(max_chunk) : static_cast<value_t>(i.size());
+                                  for (value_t start = i.start; start < i.end; start += chunk)
+                                  {
+                                      list.levels.push_back(level);
+                                      list.intervals.push_back({start, std::min(i.end, start + chunk), i.index});
+                                      list.indices.push_back(index);
+                                  }
+                              });
+            return list;
+        }
+
+        template <class Set, class = void>
+        struct has_generation : std::false_type
+        {
+        };
+
+        template <class Set>
+        struct has_generation<Set, std::void_t<decltype(std::declval<const Set&>().generation())>> : std::true_type
+        {
+        };
+
+        template <class Set>
+        inline constexpr bool has_generation_v = has_generation<std::decay_t<Set>>::value;
+
+        /**
+         * @brief Interval list of the cells of the mesh, built once per mesh generation and chunk size.
+         * The generations being unique, the lists of several meshes share the cache; the oldest entries are dropped.
+         */
+        template <class Mesh>
+        auto cached_interval_list(const Mesh& mesh, std::size_t max_chunk)
+        {
+            using list_t = decltype(make_interval_list(mesh, max_chunk));
+
+            struct entry
+            {
+                std::size_t generation;
+                std::size_t max_chunk;
+                std::shared_ptr<const list_t> list;
+            };
+
+            static constexpr std::size_t max_entries = 16;
+            static std::mutex mutex;
+            static std::vector<entry> cache;
+
+            std::lock_guard<std::mutex> lock(mutex);
+            auto generation = mesh.generation();
+            for (const auto& e : cache)
+            {
+                if (e.generation == generation && e.max_chunk == max_chunk)
+                {
+                    return e.list;
+                }
+            }
+            if (cache.size() == max_entries)
+            {
+                cache.erase(cache.begin());
+            }
+            cache.push_back({generation, max_chunk, std::make_shared<const list_t>(make_interval_list(mesh, max_chunk))});
+            return cache.back().list;
+        }
+
+        /**
+         * @brief Interval list of the set: cached for a mesh (see cached_interval_list()), built for the other sets.
+         */
+        template <class Set>
+        auto get_interval_list(Set& set, std::size_t max_chunk)
+        {
+            if constexpr (has_generation_v<Set>)
+            {
+                return cached_interval_list(set, max_chunk);
+            }
+            else
+            {
+                return std::make_shared<const decltype(make_interval_list(set, max_chunk))>(make_interval_list(set, max_chunk));
+            }
+        }
+
+        template <class Policy, class List, class Func>
+        void parallel_for_each_interval_in(Policy policy, const List& list, std::size_t first, std::size_t last, Func&& f)
+        {
+            parallel_for(policy,
+                         last - first,
+                         [&](std::size_t k)
+                         {
+                             f(list.levels[first + k], list.intervals[first + k], list.indices[first + k]);
+                         });
+        }
+    }
+
+    /**
+     * @brief for_each_interval(set, f) with the iterations distributed according to the policy.
+     * The calls f(level, i, index) run concurrently: they must write to disjoint data (e.g. the cells of the interval).
+     * If max_chunk > 0, the intervals longer than max_chunk are split into several calls (for the parallel policies),
+     * so that a few long intervals (1D meshes, coarse uniform levels) are also shared among the threads.
+     *
+     * The flat list of the intervals of a mesh is cached per mesh generation, so that it is built once between two adaptations;
+     * for the other sets (CellArray, LevelCellArray, subsets) it is built at each call.
+     */
+    template <class Policy, class Set, class Func>
+    void parallel_for_each_interval([[maybe_unused]] Policy policy, Set&& set, Func&& f, [[maybe_unused]] std::size_t max_chunk = 0)
+    {
+        if constexpr (std::is_same_v<Policy, execution::sequential_policy>)
+        {
+            for_each_interval(std::forward<Set>(set), std::forward<Func>(f));
+        }
+        else
+        {
+            auto list = detail::get_interval_list(set, max_chunk);
+            detail::parallel_for_each_interval_in(policy, *list, 0, list->intervals.size(), f);
+        }
+    }
+
+    template <class Set, class Func>
+    void parallel_for_each_interval(Set&& set, Func&& f)
+    {
+        parallel_for_each_interval(execution::par, std::forward<Set>(set), std::forward<Func>(f));
+    }
+
+    /**
+     * @brief parallel_for_each_interval() on the cells of one level of the mesh, using the cached interval list of the mesh.
+     */
+    template <class Policy, class Mesh, class Func>
+    void parallel_for_each_interval([[maybe_unused]] Policy policy,
+                                    const Mesh& mesh,
+                                    std::size_t level,
+                                    Func&& f,
+                                    [[maybe_unused]] std::size_t max_chunk = 0)
+    {
+        using mesh_id_t = typename Mesh::config::mesh_id_t;
+
+        if constexpr (std::is_same_v<Policy, execution::sequential_policy>)
+        {
+            for_each_interval(mesh[mesh_id_t::cells][level],
+                              [&](std::size_t, const auto& i, const auto& index)
+                              {
+                                  f(level, i, index);
+                              });
+        }
+        else
+        {
+            auto list          = detail::cached_interval_list(mesh, max_chunk);
+            auto [first, last] = list->level_range(level);
+            detail::parallel_for_each_interval_in(policy, *list, first, last, f);
+        }
+    }
+} // end namespace samurai
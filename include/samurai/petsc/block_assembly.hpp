@@ -39,6 +39,7 @@ namespace samurai
                         op.add_1_on_diag_for_useless_ghosts_if(diagonal_block);
                         op.include_bc_if(diagonal_block);
                         op.assemble_proj_pred_if(diagonal_block);
+                        op.set_log_stage("samurai: block (" + std::to_string(row) + "," + std::to_string(col) + ")");
                     });
             }
 
@@ -134,6 +135,18 @@ namespace samurai
                 return undefined;
             }
 
+            auto mesh_generation() const
+            {
+                std::array<std::size_t, rows * cols> generations;
+                std::size_t i = 0;
+                for_each_assembly_op(
+                    [&](auto& op, auto, auto)
+                    {
+                        generations[i++] = op.mesh_generation();
+                    });
+                return generations;
+            }
+
             std::array<std::string, cols> field_names() const
             {
                 std::array<std::string, cols> names;
@@ -187,6 +200,11 @@ namespace samurai
                     [&](auto& op, auto row, auto col)
                     {
                         // std::cout << "create_matrix (" << row << ", " << col << ")" << std::endl;
+                        if (block(row, col))
+                        {
+                            // Releases the block of a previous nested matrix (which holds its own reference)
+                            MatDestroy(&block(row, col));
+                        }
                         op.create_matrix(block(row, col));
                     });
                 MatCreateNest(PETSC_COMM_SELF, rows, PETSC_IGNORE, cols, PETSC_IGNORE, m_blocks.data(), &A);
@@ -204,6 +222,48 @@ namespace samurai
                 MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
             }
 
+            void create_csr_matrix(Mat& A)
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto row, auto col)
+                    {
+                        if (block(row, col))
+                        {
+                            MatDestroy(&block(row, col));
+                        }
+                        op.create_csr_matrix(block(row, col));
+                    });
+                MatCreateNest(PETSC_COMM_SELF, rows, PETSC_IGNORE, cols, PETSC_IGNORE, m_blocks.data(), &A);
+            }
+
+            void reassemble_csr_matrix(Mat& A)
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto row, auto col)
+                    {
+                        Mat old_block = block(row, col);
+                        op.reassemble_csr_matrix(block(row, col));
+                        if (block(row, col) != old_block)
+                        {
+                            // The block has been re-created
+                            MatNestSetSubMat(A, static_cast<PetscInt>(row), static_cast<PetscInt>(col), block(row, col));
+                        }
+                    });
+                MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
+                MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
+            }
+
+            void reassemble_matrix(Mat& A)
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto row, auto col)
+                    {
+                        op.reassemble_matrix(block(row, col));
+                    });
+                MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
+                MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
+            }
+
             void reset()
             {
                 for_each_assembly_op(
@@ -222,19 +282,12 @@ namespace samurai
             template <class... Fields>
             Vec create_rhs_vector(const std::tuple<Fields&...>& sources) const
             {
-                std::array<Vec, rows> b_blocks;
-                std::size_t i = 0;
-                for_each(sources,
-                         [&](auto& s)
-                         {
-                             b_blocks[i] = create_petsc_vector_from(s);
-                             PetscObjectSetName(reinterpret_cast<PetscObject>(b_blocks[i]), s.name().c_str());
-                             i++;
-                         });
-                Vec b;
-                VecCreateNest(PETSC_COMM_SELF, rows, NULL, b_blocks.data(), &b);
-                PetscObjectSetName(reinterpret_cast<PetscObject>(b), "right-hand side");
-                return b;
+                return std::apply(
+                    [](auto&... s)
+                    {
+                        return create_nested_petsc_vector_from("right-hand side", s...);
+                    },
+                    sources);
             }
 
             void enforce_bc(Vec& b) const
@@ -294,6 +347,10 @@ namespace samurai
                     });
                 Vec x;
                 VecCreateNest(PETSC_COMM_SELF, cols, NULL, x_blocks.data(), &x);
+                for (auto& x_block : x_blocks)
+                {
+                    VecDestroy(&x_block); // the nested vector holds its own reference
+                }
                 PetscObjectSetName(reinterpret_cast<PetscObject>(x), "solution");
                 return x;
             }
@@ -301,26 +358,13 @@ namespace samurai
             template <class... Fields>
             Vec create_applicable_vector(const std::tuple<Fields&...>& fields) const
             {
-                std::array<Vec, cols> x_blocks;
-                std::size_t i = 0;
-                for_each(fields,
-                         [&](auto& f)
-                         {
-                             for_each_assembly_op(
-                                 [&](auto&, auto row, auto col)
-                                 {
-                                     if (row == 0 && col == i)
-                                     {
-                                         x_blocks[col] = create_petsc_vector_from(f);
-                                         PetscObjectSetName(reinterpret_cast<PetscObject>(x_blocks[col]), f.name().c_str());
-                                     }
-                                 });
-                             i++;
-                         });
-                Vec x;
-                VecCreateNest(PETSC_COMM_SELF, cols, NULL, x_blocks.data(), &x);
-                PetscObjectSetName(reinterpret_cast<PetscObject>(x), "applicable fields");
-                return x;
+                static_assert(sizeof...(Fields) == cols, "The number of fields must equal the number of columns of the block operator.");
+                return std::apply(
+                    [](auto&... f)
+                    {
+                        return create_nested_petsc_vector_from("applicable fields", f...);
+                    },
+                    fields);
             }
         };
 
@@ -407,6 +451,7 @@ namespace samurai
                 for_each_assembly_op(
                     [&](auto& op, auto, auto)
                     {
+                        auto event = op.log_phase(LogPhase::sparsity_pattern_scheme);
                         op.sparsity_pattern_scheme(nnz);
                     });
             }
@@ -418,6 +463,7 @@ namespace samurai
                     {
                         if (op.include_bc())
                         {
+                            auto event = op.log_phase(LogPhase::sparsity_pattern_boundary);
                             op.sparsity_pattern_boundary(nnz);
                         }
                     });
@@ -430,6 +476,7 @@ namespace samurai
                     {
                         if (op.assemble_proj_pred())
                         {
+                            auto event = op.log_phase(LogPhase::sparsity_pattern_projection);
                             op.sparsity_pattern_projection(nnz);
                         }
                     });
@@ -442,6 +489,7 @@ namespace samurai
                     {
                         if (op.assemble_proj_pred())
                         {
+                            auto event = op.log_phase(LogPhase::sparsity_pattern_prediction);
                             op.sparsity_pattern_prediction(nnz);
                         }
                     });
@@ -454,6 +502,7 @@ namespace samurai
                     {
                         if (op.must_add_1_on_diag_for_useless_ghosts())
                         {
+                            auto event = op.log_phase(LogPhase::sparsity_pattern_useless_ghosts);
                             op.sparsity_pattern_useless_ghosts(nnz);
                         }
                     });
@@ -469,6 +518,7 @@ namespace samurai
                         {
                             op.set_current_insert_mode(insert_mode);
                         }
+                        auto event = op.log_phase(LogPhase::assemble_scheme);
                         op.assemble_scheme(A);
                         insert_mode = op.current_insert_mode();
                     });
@@ -481,6 +531,7 @@ namespace samurai
                     {
                         if (op.include_bc())
                         {
+                            auto event = op.log_phase(LogPhase::assemble_boundary_conditions);
                             op.assemble_boundary_conditions(A);
                         }
                     });
@@ -493,6 +544,7 @@ namespace samurai
                     {
                         if (op.assemble_proj_pred())
                         {
+                            auto event = op.log_phase(LogPhase::assemble_projection);
                             op.assemble_projection(A);
                         }
                     });
@@ -505,6 +557,7 @@ namespace samurai
                     {
                         if (op.assemble_proj_pred())
                         {
+                            auto event = op.log_phase(LogPhase::assemble_prediction);
                             op.assemble_prediction(A);
                         }
                     });
@@ -517,11 +570,57 @@ namespace samurai
                     {
                         if (op.must_add_1_on_diag_for_useless_ghosts())
                         {
+                            auto event = op.log_phase(LogPhase::assemble_useless_ghosts);
                             op.add_1_on_diag_for_useless_ghosts(A);
                         }
                     });
             }
 
+            void apply_scheme(MatrixSweep& sweep) override
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto, auto)
+                    {
+                        op.apply_scheme(sweep);
+                    });
+            }
+
+            void apply_boundary_conditions(MatrixSweep& sweep) override
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto, auto)
+                    {
+                        if (op.include_bc())
+                        {
+                            op.apply_boundary_conditions(sweep);
+                        }
+                    });
+            }
+
+            void apply_projection_prediction(MatrixSweep& sweep) override
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto, auto)
+                    {
+                        if (op.assemble_proj_pred())
+                        {
+                            op.apply_projection_prediction(sweep);
+                        }
+                    });
+            }
+
+            void apply_useless_ghosts(MatrixSweep& sweep) override
+            {
+                for_each_assembly_op(
+                    [&](auto& op, auto, auto)
+                    {
+                        if (op.must_add_1_on_diag_for_useless_ghosts())
+                        {
+                            op.apply_useless_ghosts(sweep);
+                        }
+                    });
+            }
+
             template <class... Fields>
             Vec create_rhs_vector(const std::tuple<Fields&...>& sources) const
             {
@@ -0,0 +1,153 @@
+#pragma once
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include <petsc.h>
+
+#include "matrix_sweep.hpp"
+
+namespace samurai
+{
+    namespace petsc
+    {
+        /**
+         * Builds the CSR arrays (row pointers, column indices, values) of a matrix directly from the sweeps of an assembly,
+         * without inserting the coefficients into a PETSc matrix:
+         *   1. a first sweep counts the coefficients of each row, which sizes the slots of the rows,
+         *   2. a second sweep writes the coefficients into the slots of their rows,
+         *   3. each row is sorted by column, and the duplicates are summed (ADD_VALUES semantics; the rows
+         *      inserted with INSERT_VALUES have been cleared by the sweep before their coefficients are written).
+         */
+        class CsrBuilder
+        {
+          private:
+
+            PetscInt m_rows = 0;
+            std::vector<PetscInt> m_row_ptr;
+            std::vector<PetscInt> m_col_indices;
+            std::vector<PetscScalar> m_values;
+
+          public:
+
+            /**
+             * @brief Builds the CSR arrays of the coefficients passed by apply(MatrixSweep&) to the sweep.
+             */
+            template <class Func>
+            void build(PetscInt rows, Func&& apply)
+            {
+                m_rows      = rows;
+                auto n_rows = static_cast<std::size_t>(rows);
+
+                // 1. Row sizes (upper bounds)
+                std::vector<PetscInt> row_begin(n_rows + 1, 0);
+                {
+                    auto sweep = MatrixSweep::count(row_begin.data() + 1);
+                    apply(sweep);
+                }
+                for (std::size_t r = 0; r < n_rows; ++r)
+                {
+                    row_begin[r + 1] += row_begin[r];
+                }
+
+                // 2. Coefficients in the slots of their rows
+                auto capacity = static_cast<std::size_t>(row_begin[n_rows]);
+                std::vector<PetscInt> row_end(row_begin.begin(), row_begin.end() - 1);
+                m_col_indices.resize(capacity);
+                m_values.resize(capacity);
+                {
+                    auto sweep = MatrixSweep::fill(row_begin.data(), row_end.data(), m_col_indices.data(), m_values.data());
+                    apply(sweep);
+                }
+
+                // 3. Sort, merge the duplicates and compact in place
+                std::vector<std::pair<PetscInt, PetscScalar>> row;
+                m_row_ptr.assign(n_rows + 1, 0);
+                std::size_t nnz = 0;
+                for (std::size_t r = 0; r < n_rows; ++r)
+                {
+                    row.clear();
+                    for (auto k = static_cast<std::size_t>(row_begin[r]); k < static_cast<std::size_t>(row_end[r]); ++k)
+                    {
+                        row.emplace_back(m_col_indices[k], m_values[k]);
+                    }
+                    std::sort(row.begin(),
+                              row.end(),
+                              [](const auto& a, const auto& b)
+                              {
+                                  return a.first < b.first;
+                              });
+                    for (std::size_t k = 0; k < row.size(); ++k)
+                    {
+                        if (k > 0 && row[k].first == row[k - 1].first)
+                        {
+                            m_values[nnz - 1] += row[k].second;
+                        }
+                        else
+                        {
+                            m_col_indices[nnz] = row[k].first;
+                            m_values[nnz]      = row[k].second;
+                            ++nnz;
+                        }
+                    }
+                    m_row_ptr[r + 1] = static_cast<PetscInt>(nnz);
+                }
+                m_col_indices.resize(nnz);
+                m_values.resize(nnz);
+            }
+
+            const auto& row_ptr() const
+            {
+                return m_row_ptr;
+            }
+
+            const auto& col_indices() const
+            {
+                return m_col_indices;
+            }
+
+            const auto& values() const
+            {
+                return m_values;
+            }
+
+            /**
+             * @brief Sets the structure and values of a sequential AIJ matrix (sizes set, not preallocated) and assembles it.
+             */
+            void set_matrix(Mat& A) const
+            {
+                // Copies the arrays and performs the final assembly
+                MatSeqAIJSetPreallocationCSR(A, m_row_ptr.data(), m_col_indices.data(), m_values.data());
+            }
+
+            /**
+             * @brief If A has the built structure, overwrites its values with the built ones.
+             * @return false if the structure of A differs.
+             */
+            bool update_values(Mat& A) const
+            {
+                PetscInt n;
+                const PetscInt* ia;
+                const PetscInt* ja;
+                PetscBool done;
+                MatGetRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ia, &ja, &done);
+                bool same_structure = done && n == m_rows && std::equal(m_row_ptr.begin(), m_row_ptr.end(), ia)
+                                   && std::equal(m_col_indices.begin(), m_col_indices.end(), ja);
+                MatRestoreRowIJ(A, 0, PETSC_FALSE, PETSC_FALSE, &n, &ia, &ja, &done);
+                if (!same_structure)
+                {
+                    return false;
+                }
+
+                PetscScalar* a;
+                MatSeqAIJGetArray(A, &a);
+                std::copy(m_values.begin(), m_values.end(), a);
+                MatSeqAIJRestoreArray(A, &a);
+                MatAssemblyBegin(A, MAT_FINAL_ASSEMBLY);
+                MatAssemblyEnd(A, MAT_FINAL_ASSEMBLY);
+                return true;
+            }
+        };
+
+    } // end namespace petsc
+} // end namespace samurai
@@ -1,4 +1,6 @@
 #pragma once
+#include <limits>
+
 #include "../../boundary.hpp"
 #include "../../numeric/prediction.hpp"
 #include "../../schemes/fv/FV_scheme.hpp"
@@ -9,6 +11,120 @@ namespace samurai
 {
     namespace petsc
     {
+        /**
+         * Linear combinations of cells replacing the projection and prediction ghosts (ghost elimination).
+         * They are stored flat, by ghost number: the terms of the ghost number g are
+         * terms[offsets[g]], ..., terms[offsets[g+1]-1]. The ghost number of a cell is found in O(1)
+         * from its storage index.
+         */
+        template <class index_t>
+        class GhostElimination
+        {
+          public:
+
+            using term_t = std::pair<index_t, double>;
+
+            /**
+             * Terms of the linear combination of a ghost. Empty if the cell is not an eliminated ghost.
+             */
+            class Combination
+            {
+              private:
+
+                const term_t* m_begin = nullptr;
+                const term_t* m_end   = nullptr;
+
+              public:
+
+                Combination() = default;
+
+                Combination(const term_t* begin, const term_t* end)
+                    : m_begin(begin)
+                    , m_end(end)
+                {
+                }
+
+                const term_t* begin() const
+                {
+                    return m_begin;
+                }
+
+                const term_t* end() const
+                {
+                    return m_end;
+                }
+
+                std::size_t size() const
+                {
+                    return static_cast<std::size_t>(m_end - m_begin);
+                }
+
+                bool empty() const
+                {
+                    return m_begin == m_end;
+                }
+            };
+
+          private:
+
+            static constexpr std::size_t not_a_ghost = std::numeric_limits<std::size_t>::max();
+
+            std::vector<std::size_t> m_ghost_number; // indexed by the storage index of the cells
+            std::vector<std::size_t> m_offsets{0};
+            std::vector<term_t> m_terms;
+
+          public:
+
+            GhostElimination() = default;
+
+            explicit GhostElimination(std::size_t n_cells)
+                : m_ghost_number(n_cells, not_a_ghost)
+            {
+            }
+
+            Combination find(index_t cell) const
+            {
+                auto g = m_ghost_number[static_cast<std::size_t>(cell)];
+                if (g == not_a_ghost)
+                {
+                    return {};
+                }
+                return {m_terms.data() + m_offsets[g], m_terms.data() + m_offsets[g + 1]};
+            }
+
+            /**
+             * @brief Adds the linear combination of a ghost, given in terms of cells or of already added ghosts,
+             * which are replaced with their own combination. Does nothing if the ghost has already been added.
+             */
+            template <class LinearCombination>
+            void add(index_t ghost, const LinearCombination& linear_comb)
+            {
+                auto& g = m_ghost_number[static_cast<std::size_t>(ghost)];
+                if (g != not_a_ghost)
+                {
+                    return;
+                }
+                for (const auto& [cell, coeff] : linear_comb)
+                {
+                    auto cell_ghost_number = m_ghost_number[static_cast<std::size_t>(cell)];
+                    if (cell_ghost_number == not_a_ghost) // it's a cell
+                    {
+                        m_terms.emplace_back(cell, coeff);
+                    }
+                    else // it's a ghost
+                    {
+                        for (auto t = m_offsets[cell_ghost_number]; t < m_offsets[cell_ghost_number + 1]; ++t)
+                        {
+                            auto [ghost_cell, ghost_coeff] = m_terms[t]; // copy: m_terms may be reallocated
+                            m_terms.emplace_back(ghost_cell, coeff * ghost_coeff);
+                        }
+                    }
+                }
+                g = m_offsets.size() - 1;
+                m_offsets.push_back(m_terms.size());
+            }
+        };
+
         /**
          * Finite Volume scheme.
          * This is the base class of CellBasedSchemeAssembly and FluxBasedSchemeAssembly.
@@ -61,11 +177,12 @@ namespace samurai
             InsertMode m_current_insert_mode = INSERT_VALUES;
             std::vector<bool> m_is_row_empty;
 
-            // Ghost recursion
+            // Ghost elimination
             using cell_coeff_pair_t     = std::pair<index_t, double>;
             using CellLinearCombination = std::vector<cell_coeff_pair_t>;
-            using recursion_t           = std::map<index_t, CellLinearCombination>;
-            recursion_t m_ghost_recursion;
+            using ghost_elimination_t   = GhostElimination<index_t>;
+            ghost_elimination_t m_ghost_elimination;
+            std::size_t m_ghost_elimination_generation = 0; // generation of the mesh of m_ghost_elimination (0: none)
 
           public:
 
@@ -95,71 +212,60 @@ namespace samurai
 
                 if constexpr (ghost_elimination_enabled)
                 {
-                    m_ghost_recursion = ghost_recursion();
+                    // Computed once per mesh generation
+                    if (m_ghost_elimination_generation != mesh().generation())
+                    {
+                        auto event                     = this->log_phase(LogPhase::ghost_elimination);
+                        m_ghost_elimination            = build_ghost_elimination();
+                        m_ghost_elimination_generation = mesh().generation();
+                    }
                 }
             }
 
-            auto ghost_recursion()
+            const ghost_elimination_t& ghost_elimination() const
+            {
+                return m_ghost_elimination;
+            }
+
+          private:
+
+            /**
+             * @brief Expresses the projection and prediction ghosts in terms of cells in a single pass:
+             *   - the children of a projection ghost are cells of the mesh,
+             *   - a prediction ghost depends on the level below, so that the prediction ghosts
+             *     are processed by increasing level, after the projection ghosts.
+             * Every ghost referenced by a combination has then already been resolved.
+             */
+            ghost_elimination_t build_ghost_elimination()
             {
                 static constexpr PetscInt number_of_children = (1 << dim);
 
-                recursion_t recursion;
+                ghost_elimination_t elimination(mesh().nb_cells());
+                CellLinearCombination linear_comb;
 
                 for_each_projection_ghost_and_children_cells<std::size_t>(
                     mesh(),
                     [&](auto, std::size_t ghost, const std::array<std::size_t, number_of_children>& children)
                     {
-                        CellLinearCombination linear_comb;
+                        linear_comb.clear();
                         for (auto child : children)
                         {
-                            linear_comb.emplace_back(child, 1. / number_of_children);
+                            linear_comb.emplace_back(static_cast<index_t>(child), 1. / number_of_children);
                         }
-                        recursion.insert({ghost, linear_comb});
+                        elimination.add(static_cast<index_t>(ghost), linear_comb);
                     });
 
                 for_each_prediction_ghost(mesh(),
                                           [&](auto& ghost)
                                           {
-                                              recursion.insert({ghost.index, prediction_linear_combination(ghost)});
+                                              elimination.add(ghost.index, prediction_linear_combination(ghost));
                                           });
 
-                bool changes = true;
-                while (changes)
-                {
-                    changes = false;
-                    for (auto& pair : recursion)
-                    {
-                        // auto ghost        = pair.first;
-                        auto& linear_comb = pair.second;
-
-                        CellLinearCombination new_linear_comb;
-
-                        // for (auto& c : linear_comb)
-                        for (auto& [cell, coeff] : linear_comb)
-                        {
-                            auto it = recursion.find(cell);
-                            if (it == recursion.end()) // it's a cell
-                            {
-                                new_linear_comb.emplace_back(cell, coeff);
-                            }
-                            else // it's a ghost
-                            {
-                                auto& ghost_lin_comb = it->second;
-                                for (auto& [cell2, coeff2] : ghost_lin_comb)
-                                {
-                                    new_linear_comb.emplace_back(cell2, coeff * coeff2);
-                                }
-                                changes = true;
-                            }
-                        }
-
-                        linear_comb = new_linear_comb;
-                    }
-                }
-
-                return recursion;
+                return elimination;
             }
 
+          public:
+
             void set_unknown(field_t& unknown)
             {
                 m_unknown = &unknown;
@@ -186,6 +292,14 @@ namespace samurai
                 return unknown().mesh();
             }
 
+            /**
+             * @brief Generation of the mesh of the unknown: the matrix structure is valid as long as it is unchanged.
+             */
+            std::size_t mesh_generation() const
+            {
+                return mesh().generation();
+            }
+
             PetscInt matrix_rows() const override
             {
                 return static_cast<PetscInt>(m_n_cells * output_field_size);
@@ -196,6 +310,16 @@ namespace samurai
                 return static_cast<PetscInt>(m_n_cells * field_size);
             }
 
+            PetscInt row_block_size() const override
+            {
+                return field_t::is_soa ? 1 : static_cast<PetscInt>(output_field_size);
+            }
+
+            PetscInt col_block_size() const override
+            {
+                return field_t::is_soa ? 1 : static_cast<PetscInt>(field_size);
+            }
+
             InsertMode current_insert_mode() const
             {
                 return m_current_insert_mode;
@@ -496,6 +620,80 @@ namespace samurai
                 }
             }
 
+            void apply_boundary_conditions(MatrixSweep& sweep) override
+            {
+                for (auto& bc : unknown().get_bc())
+                {
+                    auto bc_region                  = bc->get_region();
+                    auto& directions                = bc_region.first;
+                    auto& boundary_cells_directions = bc_region.second;
+                    for (std::size_t d = 0; d < directions.size(); ++d)
+                    {
+                        auto& towards_out = directions[d];
+
+                        int number_of_one = xt::sum(xt::abs(towards_out))[0];
+                        if (number_of_one == 1)
+                        {
+                            auto& boundary_cells = boundary_cells_directions[d];
+                            if (dynamic_cast<dirichlet_t*>(bc.get()))
+                            {
+                                auto config = scheme().dirichlet_config(towards_out);
+                                for_each_stencil_on_boundary(mesh(),
+                                                             boundary_cells,
+                                                             config.directional_stencil.stencil,
+                                                             config.equations,
+                                                             [&](auto& cells, auto& equations)
+                                                             {
+                                                                 apply_bc(sweep, cells, equations);
+                                                             });
+                            }
+                            else if (dynamic_cast<neumann_t*>(bc.get()))
+                            {
+                                auto config = scheme().neumann_config(towards_out);
+                                for_each_stencil_on_boundary(mesh(),
+                                                             boundary_cells,
+                                                             config.directional_stencil.stencil,
+                                                             config.equations,
+                                                             [&](auto& cells, auto& equations)
+                                                             {
+                                                                 apply_bc(sweep, cells, equations);
+                                                             });
+                            }
+                        }
+                    }
+                }
+            }
+
+            /**
+             * @brief Matrix-free counterpart of assemble_bc(): the row of the ghost is replaced by the equation.
+             */
+            template <class CellList, class CoeffList>
+            void apply_bc(MatrixSweep& sweep, CellList& cells, std::array<CoeffList, nb_bdry_ghosts>& equations)
+            {
+                for (std::size_t e = 0; e < nb_bdry_ghosts; ++e)
+                {
+                    const auto& eq             = equations[e];
+                    const auto& equation_ghost = cells[eq.ghost_index];
+                    for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                    {
+                        PetscInt equation_row = col_index(equation_ghost, field_i);
+                        sweep.clear_row(equation_row);
+                        for (std::size_t c = 0; c < bdry_stencil_size; ++c)
+                        {
+                            double coeff = scheme().cell_coeff(eq.stencil_coeffs, c, field_i, field_i);
+                            if (coeff != 0)
+                            {
+                                if constexpr (dirichlet_enfcmt != DirichletEnforcement::Elimination)
+                                {
+                                    sweep.add(equation_row, col_index(cells[c], field_i), coeff);
+                                }
+                                set_is_row_not_empty(equation_row);
+                            }
+                        }
+                    }
+                }
+            }
+
           public:
 
             //-------------------------------------------------------------//
@@ -505,6 +703,7 @@ namespace samurai
             virtual void enforce_bc(Vec& b) const
             {
                 // std::cout << "enforce_bc of " << this->name() << std::endl;
+                auto event = this->log_phase(LogPhase::enforce_bc);
                 if (!this->is_block())
                 {
                     PetscInt b_rows;
@@ -582,6 +781,7 @@ namespace samurai
                 {
                     auto eq                    = equations[e];
                     const auto& equation_ghost = cells[eq.ghost_index];
+                    auto bc_values             = bc->value(equation_ghost, towards_out, boundary_point);
                     for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
                     {
                         PetscInt equation_row = row_index(equation_ghost, field_i);
@@ -589,16 +789,7 @@ namespace samurai
                         double coeff = rhs_coeff(eq.rhs_coeffs, field_i, field_i);
                         assert(coeff != 0);
 
-                        double bc_value;
-                        if constexpr (field_size == 1)
-                        {
-                            bc_value = bc->value({}, boundary_point);
-                        }
-                        else
-                        {
-                            bc_value = bc->value({}, boundary_point)(field_i); // TODO: call get_value() only once instead of
-                                                                               // once per field_i
-                        }
+                        double bc_value = samurai::detail::get_component(bc_values, field_i);
 
                         if constexpr (dirichlet_enfcmt == DirichletEnforcement::Elimination)
                         {
@@ -645,6 +836,19 @@ namespace samurai
                 }
             }
 
+            void apply_useless_ghosts(MatrixSweep& sweep) override
+            {
+                for (std::size_t i = 0; i < m_is_row_empty.size(); i++)
+                {
+                    if (m_is_row_empty[i])
+                    {
+                        PetscInt row = m_row_shift + static_cast<PetscInt>(i);
+                        sweep.clear_row(row);
+                        sweep.add(row, m_col_shift + static_cast<PetscInt>(i), 1);
+                    }
+                }
+            }
+
             void add_0_for_useless_ghosts(Vec& b) const
             {
                 for (std::size_t i = 0; i < m_is_row_empty.size(); i++)
@@ -675,7 +879,7 @@ namespace samurai
                                                   if constexpr (ghost_elimination_enabled)
                                                   {
                                                       nnz[static_cast<std::size_t>(row_index(ghost, field_i))] = static_cast<PetscInt>(
-                                                          m_ghost_recursion.at(ghost.index).size());
+                                                          ghost_elimination().find(ghost.index).size());
                                                   }
                                                   else
                                                   {
@@ -702,7 +906,7 @@ namespace samurai
                                                   if constexpr (ghost_elimination_enabled)
                                                   {
                                                       nnz[static_cast<std::size_t>(row_index(ghost, field_i))] = static_cast<PetscInt>(
-                                                          m_ghost_recursion.at(ghost.index).size());
+                                                          ghost_elimination().find(ghost.index).size());
                                                   }
                                                   else
                                                   {
@@ -714,6 +918,7 @@ namespace samurai
 
             virtual void enforce_projection_prediction(Vec& b) const
             {
+                auto event = this->log_phase(LogPhase::enforce_projection_prediction);
                 // Projection
                 for_each_projection_ghost(mesh(),
                                           [&](auto& ghost)
@@ -783,6 +988,58 @@ namespace samurai
                 }
             }
 
+            /**
+             * @brief Matrix-free counterpart of assemble_projection() and assemble_prediction().
+             * With ghost elimination, these rows are not assembled: they are identity rows of the useless ghosts.
+             */
+            void apply_projection_prediction([[maybe_unused]] MatrixSweep& sweep) override
+            {
+                if constexpr (!ghost_elimination_enabled)
+                {
+                    static constexpr PetscInt number_of_children = (1 << dim);
+
+                    for_each_projection_ghost_and_children_cells<PetscInt>(
+                        mesh(),
+                        [&](auto level, PetscInt ghost, const std::array<PetscInt, number_of_children>& children)
+                        {
+                            double h       = cell_length(level);
+                            double scaling = 1. / (h * h);
+                            for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                            {
+                                PetscInt ghost_index = row_index(ghost, field_i);
+                                sweep.clear_row(ghost_index);
+                                sweep.add(ghost_index, col_index(ghost, field_i), scaling);
+                                for (unsigned int i = 0; i < number_of_children; ++i)
+                                {
+                                    sweep.add(ghost_index, col_index(children[i], field_i), -scaling / number_of_children);
+                                }
+                                set_is_row_not_empty(ghost_index);
+                            }
+                        });
+
+                    for_each_prediction_ghost(mesh(),
+                                              [&](auto& ghost)
+                                              {
+                                                  double h         = cell_length(ghost.level);
+                                                  double scaling   = 1. / (h * h);
+                                                  auto linear_comb = prediction_linear_combination(ghost);
+                                                  for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                                                  {
+                                                      PetscInt ghost_index = row_index(ghost, field_i);
+                                                      sweep.clear_row(ghost_index);
+                                                      sweep.add(ghost_index, col_index(ghost, field_i), scaling);
+                                                      for (const auto& [cell_index, coeff] : linear_comb)
+                                                      {
+                                                          sweep.add(ghost_index,
+                                                                      col_index(static_cast<PetscInt>(cell_index), field_i),
+                                                                      -scaling * coeff);
+                                                      }
+                                                      set_is_row_not_empty(ghost_index);
+                                                  }
+                                              });
+                }
+            }
+
             template <class Cell>
             auto prediction_linear_combination(const Cell& ghost)
             {
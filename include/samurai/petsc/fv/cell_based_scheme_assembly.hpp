@@ -365,6 +365,39 @@ namespace samurai
                         }
                     });
             }
+
+            /**
+             * @brief Same coefficients as assemble_scheme(): the zero coefficients are skipped where it skips them,
+             * i.e. outside of the contiguous indices and of the diagonal, except for AOS blocks.
+             */
+            void apply_scheme(MatrixSweep& sweep) override
+            {
+                static constexpr bool insert_blocks  = !(field_size == 1 || field_t::is_soa);
+                static constexpr auto contiguous_end = cfg_t::contiguous_indices_start + cfg_t::contiguous_indices_size;
+
+                for_each_stencil_and_coeffs(
+                    [&](const auto& cells, const auto& coeffs)
+                    {
+                        for (unsigned int field_i = 0; field_i < output_field_size; ++field_i)
+                        {
+                            auto stencil_center_row = static_cast<PetscInt>(row_index(cells[cfg_t::center_index], field_i));
+                            for (unsigned int c = 0; c < scheme_stencil_size; ++c)
+                            {
+                                for (unsigned int field_j = 0; field_j < field_size; ++field_j)
+                                {
+                                    auto col        = static_cast<PetscInt>(col_index(cells[c], field_j));
+                                    double coeff    = scheme().cell_coeff(coeffs, c, field_i, field_j);
+                                    bool contiguous = c >= cfg_t::contiguous_indices_start && c < contiguous_end;
+                                    if (insert_blocks || contiguous || coeff != 0 || stencil_center_row == col)
+                                    {
+                                        sweep.add(stencil_center_row, col, coeff);
+                                    }
+                                }
+                            }
+                            set_is_row_not_empty(stencil_center_row);
+                        }
+                    });
+            }
         };
 
     } // end namespace petsc
@@ -73,15 +73,14 @@ namespace samurai
                                     {
                                         for (std::size_t c = 0; c < stencil_size; ++c)
                                         {
-                                            auto it_ghost = this->m_ghost_recursion.find(comput_cells[c].index);
-                                            if (it_ghost == this->m_ghost_recursion.end())
+                                            auto linear_comb = this->ghost_elimination().find(comput_cells[c].index);
+                                            if (linear_comb.empty()) // it's a cell
                                             {
                                                 nnz[static_cast<std::size_t>(this->row_index(interface_cells[0], field_i))] += field_size;
                                                 nnz[static_cast<std::size_t>(this->row_index(interface_cells[1], field_i))] += field_size;
                                             }
                                             else
                                             {
-                                                auto& linear_comb = it_ghost->second;
                                                 nnz[static_cast<std::size_t>(this->row_index(interface_cells[0], field_i))] += linear_comb.size()
                                                                                                                              * field_size;
                                                 nnz[static_cast<std::size_t>(this->row_index(interface_cells[1], field_i))] += linear_comb.size()
@@ -133,6 +132,32 @@ namespace samurai
                     set_current_insert_mode(ADD_VALUES);
                 }
 
+                for_each_scheme_coefficient(
+                    [&](PetscInt row, PetscInt col, double coeff)
+                    {
+                        MatSetValue(A, row, col, coeff, ADD_VALUES);
+                    });
+            }
+
+            void apply_scheme(MatrixSweep& sweep) override
+            {
+                for_each_scheme_coefficient(
+                    [&](PetscInt row, PetscInt col, double coeff)
+                    {
+                        sweep.add(row, col, coeff);
+                    });
+            }
+
+          private:
+
+            /**
+             * @brief Calls f(row, col, coeff) on every coefficient of the scheme, to be added to the matrix.
+             * The interior and boundary interfaces are swept as by the explicit operator; the projection and prediction
+             * ghosts of the stencils are eliminated.
+             */
+            template <class Func>
+            void for_each_scheme_coefficient(Func&& f)
+            {
                 // Interior interfaces
                 scheme().for_each_interior_interface(
                     mesh(),
@@ -151,45 +176,28 @@ namespace samurai
 
                                     if constexpr (ghost_elimination_enabled)
                                     {
-                                        auto it_ghost = this->m_ghost_recursion.find(comput_cells[c].index);
-                                        if (it_ghost == this->m_ghost_recursion.end())
+                                        auto linear_comb = this->ghost_elimination().find(comput_cells[c].index);
+                                        if (linear_comb.empty()) // it's a cell
                                         {
                                             auto comput_cell_col = col_index(comput_cells[c], field_j);
-                                            // if (left_cell_coeff != 0)
-                                            // {
-                                            MatSetValue(A, left_cell_row, comput_cell_col, left_cell_coeff, ADD_VALUES);
-                                            // }
-                                            // if (right_cell_coeff != 0)
-                                            // {
-                                            MatSetValue(A, right_cell_row, comput_cell_col, right_cell_coeff, ADD_VALUES);
-                                            // }
-                                            // MatSetValue(A, left_cell_row, left_cell_row, 0, ADD_VALUES);
-                                            // MatSetValue(A, right_cell_row, right_cell_row, 0, ADD_VALUES);
+                                            f(left_cell_row, comput_cell_col, left_cell_coeff);
+                                            f(right_cell_row, comput_cell_col, right_cell_coeff);
                                         }
                                         else
                                         {
-                                            auto& linear_comb = it_ghost->second;
                                             for (auto& [cell, coeff] : linear_comb)
                                             {
                                                 auto comput_cell_col = col_index(static_cast<PetscInt>(cell), field_j);
-                                                MatSetValue(A, left_cell_row, comput_cell_col, left_cell_coeff * coeff, ADD_VALUES);
-                                                MatSetValue(A, right_cell_row, comput_cell_col, right_cell_coeff * coeff, ADD_VALUES);
+                                                f(left_cell_row, comput_cell_col, left_cell_coeff * coeff);
+                                                f(right_cell_row, comput_cell_col, right_cell_coeff * coeff);
                                             }
                                         }
                                     }
                                     else
                                     {
                                         auto comput_cell_col = col_index(comput_cells[c], field_j);
-                                        // if (left_cell_coeff != 0)
-                                        // {
-                                        MatSetValue(A, left_cell_row, comput_cell_col, left_cell_coeff, ADD_VALUES);
-                                        // }
-                                        // if (right_cell_coeff != 0)
-                                        // {
-                                        MatSetValue(A, right_cell_row, comput_cell_col, right_cell_coeff, ADD_VALUES);
-                                        // }
-                                        // MatSetValue(A, left_cell_row, left_cell_row, 0, ADD_VALUES);
-                                        // MatSetValue(A, right_cell_row, right_cell_row, 0, ADD_VALUES);
+                                        f(left_cell_row, comput_cell_col, left_cell_coeff);
+                                        f(right_cell_row, comput_cell_col, right_cell_coeff);
                                     }
                                 }
                             }
@@ -212,8 +220,7 @@ namespace samurai
                                                                      double coeff = scheme().cell_coeff(coeffs, c, field_i, field_j);
                                                                      if (coeff != 0)
                                                                      {
-                                                                         auto comput_cell_col = col_index(comput_cells[c], field_j);
-                                                                         MatSetValue(A, cell_row, comput_cell_col, coeff, ADD_VALUES);
+                                                                         f(cell_row, col_index(comput_cells[c], field_j), coeff);
                                                                      }
                                                                  }
                                                              }
@@ -53,6 +53,11 @@ namespace samurai
                 return !m_flux_assembly.unknown_ptr();
             }
 
+            std::size_t mesh_generation() const
+            {
+                return m_flux_assembly.mesh_generation();
+            }
+
             void set_unknown(field_t& unknown)
             {
                 m_flux_assembly.set_unknown(unknown);
@@ -106,6 +111,16 @@ namespace samurai
                 return m_flux_assembly.matrix_cols();
             }
 
+            PetscInt row_block_size() const override
+            {
+                return m_flux_assembly.row_block_size();
+            }
+
+            PetscInt col_block_size() const override
+            {
+                return m_flux_assembly.col_block_size();
+            }
+
             void sparsity_pattern_scheme(std::vector<PetscInt>& nnz) const override
             {
                 // To be safe, allocate for both schemes (nnz is the sum of both)
@@ -164,6 +179,27 @@ namespace samurai
                 m_flux_assembly.add_1_on_diag_for_useless_ghosts(A);
             }
 
+            void apply_scheme(MatrixSweep& sweep) override
+            {
+                m_cell_assembly.apply_scheme(sweep);
+                m_flux_assembly.apply_scheme(sweep);
+            }
+
+            void apply_boundary_conditions(MatrixSweep& sweep) override
+            {
+                m_flux_assembly.apply_boundary_conditions(sweep);
+            }
+
+            void apply_projection_prediction(MatrixSweep& sweep) override
+            {
+                m_flux_assembly.apply_projection_prediction(sweep);
+            }
+
+            void apply_useless_ghosts(MatrixSweep& sweep) override
+            {
+                m_flux_assembly.apply_useless_ghosts(sweep);
+            }
+
             void enforce_bc(Vec& b) const
             {
                 m_flux_assembly.enforce_bc(b);
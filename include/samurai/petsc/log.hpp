@@ -0,0 +1,156 @@
+#pragma once
+#include <array>
+#include <map>
+#include <string>
+
+#include <petsc.h>
+
+namespace samurai
+{
+    namespace petsc
+    {
+        /**
+         * PETSc profiling of the samurai assembly and solve phases (see the option -log_view).
+         * Each phase has one event, registered once for all the assemblies; the stages are registered at their first use, once per name.
+         */
+        enum class LogPhase : std::size_t
+        {
+            create_matrix,
+            sparsity_pattern_scheme,
+            sparsity_pattern_boundary,
+            sparsity_pattern_projection,
+            sparsity_pattern_prediction,
+            sparsity_pattern_useless_ghosts,
+            assemble_scheme,
+            assemble_boundary_conditions,
+            assemble_projection,
+            assemble_prediction,
+            assemble_useless_ghosts,
+            MatAssembly,
+            reassemble_matrix,
+            create_csr_matrix,
+            reassemble_csr_matrix,
+            matrix_free_mult,
+            ghost_elimination,
+            enforce_bc,
+            enforce_projection_prediction,
+            count
+        };
+
+        inline PetscClassId log_class_id()
+        {
+            static PetscClassId class_id = 0;
+            if (class_id == 0)
+            {
+                PetscClassIdRegister("samurai", &class_id);
+            }
+            return class_id;
+        }
+
+        inline PetscLogEvent log_event(LogPhase phase)
+        {
+            static constexpr std::size_t n_phases                    = static_cast<std::size_t>(LogPhase::count);
+            static constexpr std::array<const char*, n_phases> names = {"samurai create_matrix",
+                                                                        "samurai sparsity_pattern_scheme",
+                                                                        "samurai sparsity_pattern_boundary",
+                                                                        "samurai sparsity_pattern_projection",
+                                                                        "samurai sparsity_pattern_prediction",
+                                                                        "samurai sparsity_pattern_useless_ghosts",
+                                                                        "samurai assemble_scheme",
+                                                                        "samurai assemble_boundary_conditions",
+                                                                        "samurai assemble_projection",
+                                                                        "samurai assemble_prediction",
+                                                                        "samurai assemble_useless_ghosts",
+                                                                        "samurai MatAssembly",
+                                                                        "samurai reassemble_matrix",
+                                                                        "samurai create_csr_matrix",
+                                                                        "samurai reassemble_csr_matrix",
+                                                                        "samurai matrix_free_mult",
+                                                                        "samurai ghost_elimination",
+                                                                        "samurai enforce_bc",
+                                                                        "samurai enforce_projection_prediction"};
+            static const auto events = []()
+            {
+                std::array<PetscLogEvent, n_phases> registered_events;
+                for (std::size_t p = 0; p < n_phases; ++p)
+                {
+                    PetscLogEventRegister(names[p], log_class_id(), &registered_events[p]);
+                }
+                return registered_events;
+            }();
+            return events[static_cast<std::size_t>(phase)];
+        }
+
+        inline PetscLogStage log_stage(const std::string& name)
+        {
+            static std::map<std::string, PetscLogStage> stages;
+            auto it = stages.find(name);
+            if (it == stages.end())
+            {
+                PetscLogStage stage;
+                PetscLogStageRegister(name.c_str(), &stage);
+                it = stages.emplace(name, stage).first;
+            }
+            return it->second;
+        }
+
+        /**
+         * Logs the lifetime of the object as the PETSc event of a phase,
+         * inside the stage 'stage_name' if it is not empty.
+         */
+        class LogEvent
+        {
+          private:
+
+            PetscLogEvent m_event;
+            bool m_has_stage;
+
+          public:
+
+            explicit LogEvent(LogPhase phase, const std::string& stage_name = {})
+                : m_event(log_event(phase))
+                , m_has_stage(!stage_name.empty())
+            {
+                if (m_has_stage)
+                {
+                    PetscLogStagePush(log_stage(stage_name));
+                }
+                PetscLogEventBegin(m_event, 0, 0, 0, 0);
+            }
+
+            LogEvent(const LogEvent&)            = delete;
+            LogEvent& operator=(const LogEvent&) = delete;
+
+            ~LogEvent()
+            {
+                PetscLogEventEnd(m_event, 0, 0, 0, 0);
+                if (m_has_stage)
+                {
+                    PetscLogStagePop();
+                }
+            }
+        };
+
+        /**
+         * Pushes a PETSc log stage for the lifetime of the object.
+         */
+        class LogStage
+        {
+          public:
+
+            explicit LogStage(const std::string& name)
+            {
+                PetscLogStagePush(log_stage(name));
+            }
+
+            LogStage(const LogStage&)            = delete;
+            LogStage& operator=(const LogStage&) = delete;
+
+            ~LogStage()
+            {
+                PetscLogStagePop();
+            }
+        };
+
+    } // end namespace petsc
+} // end namespace samurai
@@ -1,6 +1,10 @@
 #pragma once
 #include <petsc.h>
 
+#include "csr_builder.hpp"
+#include "log.hpp"
+#include "matrix_sweep.hpp"
+
 namespace samurai
 {
     namespace petsc
@@ -11,6 +15,7 @@ namespace samurai
 
             bool m_is_deleted  = false;
             std::string m_name = "(unnamed)";
+            std::string m_log_stage; // PETSc stage of the phases of this assembly, none if empty
 
             bool m_include_bc                       = true;
             bool m_assemble_proj_pred               = true;
@@ -34,6 +39,15 @@ namespace samurai
                 m_name = name;
             }
 
+            /**
+             * @brief Logs the phases of this assembly in the PETSc stage 'name' (none by default).
+             * The events of the phases are the same for all the assemblies: the stage tells them apart in -log_view.
+             */
+            void set_log_stage(const std::string& name)
+            {
+                m_log_stage = name;
+            }
+
             bool include_bc() const
             {
                 return m_include_bc;
@@ -96,36 +110,57 @@ namespace samurai
                 return m_col_shift;
             }
 
+            /**
+             * @brief Logs a phase of this assembly as its PETSc event, for the lifetime of the returned object.
+             */
+            LogEvent log_phase(LogPhase phase) const
+            {
+                return LogEvent(phase, m_log_stage);
+            }
+
             /**
              * @brief Performs the memory preallocation of the Petsc matrix.
              * @see assemble_matrix
              */
             virtual void create_matrix(Mat& A)
             {
+                auto event = log_phase(LogPhase::create_matrix);
                 reset();
                 auto m = matrix_rows();
                 auto n = matrix_cols();
 
                 MatCreate(PETSC_COMM_SELF, &A);
                 MatSetSizes(A, m, n, m, n);
+                MatSetBlockSizes(A, row_block_size(), col_block_size());
                 MatSetFromOptions(A);
                 PetscObjectSetName(reinterpret_cast<PetscObject>(A), m_name.c_str());
 
                 // Number of non-zeros per row. 0 by default.
                 std::vector<PetscInt> nnz(static_cast<std::size_t>(m), 0);
 
-                sparsity_pattern_scheme(nnz);
+                {
+                    auto event = log_phase(LogPhase::sparsity_pattern_scheme);
+                    sparsity_pattern_scheme(nnz);
+                }
                 if (m_include_bc)
                 {
+                    auto event = log_phase(LogPhase::sparsity_pattern_boundary);
                     sparsity_pattern_boundary(nnz);
                 }
                 if (m_assemble_proj_pred)
                 {
-                    sparsity_pattern_projection(nnz);
-                    sparsity_pattern_prediction(nnz);
+                    {
+                        auto event = log_phase(LogPhase::sparsity_pattern_projection);
+                        sparsity_pattern_projection(nnz);
+                    }
+                    {
+                        auto event = log_phase(LogPhase::sparsity_pattern_prediction);
+                        sparsity_pattern_prediction(nnz);
+                    }
                 }
                 if (m_add_1_on_diag_for_useless_ghosts)
                 {
+                    auto event = log_phase(LogPhase::sparsity_pattern_useless_ghosts);
                     sparsity_pattern_useless_ghosts(nnz);
                 }
 
@@ -146,23 +181,35 @@ namespace samurai
              */
             virtual void assemble_matrix(Mat& A)
             {
-                assemble_scheme(A);
+                {
+                    auto event = log_phase(LogPhase::assemble_scheme);
+                    assemble_scheme(A);
+                }
                 if (m_include_bc)
                 {
+                    auto event = log_phase(LogPhase::assemble_boundary_conditions);
                     assemble_boundary_conditions(A);
                 }
                 if (m_assemble_proj_pred)
                 {
-                    assemble_projection(A);
-                    assemble_prediction(A);
+                    {
+                        auto event = log_phase(LogPhase::assemble_projection);
+                        assemble_projection(A);
+                    }
+                    {
+                        auto event = log_phase(LogPhase::assemble_prediction);
+                        assemble_prediction(A);
+                    }
                 }
                 if (m_add_1_on_diag_for_useless_ghosts)
                 {
+                    auto event = log_phase(LogPhase::assemble_useless_ghosts);
                     add_1_on_diag_for_useless_ghosts(A);
                 }
 
                 if (!m_is_block)
                 {
+                    auto event = log_phase(LogPhase::MatAssembly);
                     PetscBool is_symmetric = matrix_is_symmetric() ? PETSC_TRUE : PETSC_FALSE;
                     MatSetOption(A, MAT_SYMMETRIC, is_symmetric);
 
@@ -174,6 +221,118 @@ namespace samurai
                 }
             }
 
+            /**
+             * @brief Re-inserts the coefficients into a matrix created by create_matrix()
+             * on the same mesh, e.g. after a change of the time step.
+             * The nonzero structure and the preallocation of the matrix are kept.
+             */
+            virtual void reassemble_matrix(Mat& A)
+            {
+                auto event = log_phase(LogPhase::reassemble_matrix);
+                MatZeroEntries(A);
+                assemble_matrix(A);
+            }
+
+            /**
+             * @brief Counterpart of assemble_matrix() that passes the coefficients to the sweep as they are computed,
+             * instead of inserting them into a matrix (matrix-free product, CSR arrays).
+             */
+            void apply(MatrixSweep& sweep)
+            {
+                apply_scheme(sweep);
+                if (m_include_bc)
+                {
+                    apply_boundary_conditions(sweep);
+                }
+                if (m_assemble_proj_pred)
+                {
+                    apply_projection_prediction(sweep);
+                }
+                if (m_add_1_on_diag_for_useless_ghosts)
+                {
+                    apply_useless_ghosts(sweep);
+                }
+            }
+
+            /**
+             * @brief Creates and assembles the matrix in one go: the CSR arrays are filled directly by the sweeps
+             * of the assembly (see apply()) and handed to PETSc at once. There is no insertion into the PETSc matrix.
+             * Falls back to create_matrix() and assemble_matrix() if the user has chosen a matrix type other than AIJ.
+             */
+            virtual void create_csr_matrix(Mat& A)
+            {
+                auto event = log_phase(LogPhase::create_csr_matrix);
+                reset();
+                auto m = matrix_rows();
+                auto n = matrix_cols();
+
+                MatCreate(PETSC_COMM_SELF, &A);
+                MatSetSizes(A, m, n, m, n);
+                MatSetBlockSizes(A, row_block_size(), col_block_size());
+                MatSetFromOptions(A);
+
+                PetscBool is_seqaij;
+                PetscObjectTypeCompare(reinterpret_cast<PetscObject>(A), MATSEQAIJ, &is_seqaij);
+                if (!is_seqaij)
+                {
+                    MatDestroy(&A);
+                    create_matrix(A);
+                    assemble_matrix(A);
+                    return;
+                }
+
+                PetscObjectSetName(reinterpret_cast<PetscObject>(A), m_name.c_str());
+                CsrBuilder builder;
+                build_csr(builder);
+                builder.set_matrix(A);
+                set_matrix_properties(A);
+            }
+
+            /**
+             * @brief Same as reassemble_matrix() for a matrix created by create_csr_matrix():
+             * the new values are copied at once if the structure is unchanged, otherwise the matrix is re-created.
+             */
+            virtual void reassemble_csr_matrix(Mat& A)
+            {
+                auto event = log_phase(LogPhase::reassemble_csr_matrix);
+                PetscBool is_seqaij;
+                PetscObjectTypeCompare(reinterpret_cast<PetscObject>(A), MATSEQAIJ, &is_seqaij);
+                if (!is_seqaij)
+                {
+                    reassemble_matrix(A);
+                    return;
+                }
+                CsrBuilder builder;
+                build_csr(builder);
+                if (!builder.update_values(A))
+                {
+                    MatDestroy(&A);
+                    create_csr_matrix(A);
+                }
+            }
+
+          private:
+
+            void build_csr(CsrBuilder& builder)
+            {
+                builder.build(matrix_rows(),
+                              [&](MatrixSweep& sweep)
+                              {
+                                  apply(sweep);
+                              });
+            }
+
+            void set_matrix_properties(Mat& A) const
+            {
+                PetscBool is_symmetric = matrix_is_symmetric() ? PETSC_TRUE : PETSC_FALSE;
+                MatSetOption(A, MAT_SYMMETRIC, is_symmetric);
+
+                PetscBool is_spd = matrix_is_spd() ? PETSC_TRUE : PETSC_FALSE;
+                MatSetOption(A, MAT_SPD, is_spd);
+            }
+
+          public:
+
             virtual ~MatrixAssembly()
             {
                 // std::cout << "Destruction of '" << name() << "'" << std::endl;
@@ -189,6 +348,20 @@ namespace samurai
              */
             virtual PetscInt matrix_cols() const = 0;
 
+            /**
+             * @brief Returns the block sizes of the rows and columns, which must match those of the vectors
+             * created by create_petsc_vector_from(): the number of components for fields stored as arrays of structures, 1 otherwise.
+             */
+            virtual PetscInt row_block_size() const
+            {
+                return 1;
+            }
+
+            virtual PetscInt col_block_size() const
+            {
+                return 1;
+            }
+
             /**
              * @brief Sets the sparsity pattern of the matrix for the interior of the domain (cells only).
              * @param nnz that stores, for each row index in the matrix, the number of non-zero coefficients.
@@ -236,6 +409,16 @@ namespace samurai
 
             virtual void add_1_on_diag_for_useless_ghosts(Mat& A) = 0;
 
+            /**
+             * @brief Counterparts of assemble_scheme(), assemble_boundary_conditions(), assemble_projection() and
+             * assemble_prediction(), and add_1_on_diag_for_useless_ghosts(), that pass the coefficients to a MatrixSweep.
+             * The rows that the assembly fills with INSERT_VALUES are cleared before their coefficients are passed.
+             */
+            virtual void apply_scheme(MatrixSweep& sweep)                = 0;
+            virtual void apply_boundary_conditions(MatrixSweep& sweep)   = 0;
+            virtual void apply_projection_prediction(MatrixSweep& sweep) = 0;
+            virtual void apply_useless_ghosts(MatrixSweep& sweep)        = 0;
+
             virtual void sparsity_pattern_useless_ghosts(std::vector<PetscInt>& nnz)
             {
                 for (std::size_t row = static_cast<std::size_t>(m_row_shift); row < static_cast<std::size_t>(m_row_shift + matrix_rows());
@@ -0,0 +1,103 @@
+#pragma once
+#include "matrix_assembly.hpp"
+
+namespace samurai
+{
+    namespace petsc
+    {
+        /**
+         * Matrix-free operator: the matrix defined by an assembly is never stored.
+         * Its product with a vector (and the extraction of its diagonal) is computed by the sweeps of the assembly
+         * (scheme, boundary conditions, projection/prediction, useless ghosts) applied to the vector (see MatrixAssembly::apply()).
+         * The rows of the boundary conditions and of the projection/prediction ghosts are then exactly those of the assembled matrix.
+         */
+        class MatrixFreeOperator
+        {
+          private:
+
+            MatrixAssembly* m_assembly;
+
+          public:
+
+            explicit MatrixFreeOperator(MatrixAssembly& assembly)
+                : m_assembly(&assembly)
+            {
+            }
+
+            /**
+             * @brief Creates the shell matrix A of the assembly. A owns the operator.
+             */
+            static void create_matrix(MatrixAssembly& assembly, Mat& A)
+            {
+                assembly.reset();
+                auto m = assembly.matrix_rows();
+                auto n = assembly.matrix_cols();
+
+                auto* op = new MatrixFreeOperator(assembly);
+                MatCreateShell(PETSC_COMM_SELF, m, n, m, n, op, &A);
+                MatSetBlockSizes(A, assembly.row_block_size(), assembly.col_block_size());
+                MatShellSetOperation(A, MATOP_MULT, reinterpret_cast<void (*)(void)>(&MatrixFreeOperator::mult));
+                MatShellSetOperation(A, MATOP_GET_DIAGONAL, reinterpret_cast<void (*)(void)>(&MatrixFreeOperator::get_diagonal));
+                MatShellSetOperation(A, MATOP_DESTROY, reinterpret_cast<void (*)(void)>(&MatrixFreeOperator::destroy));
+                MatSetOption(A, MAT_SYMMETRIC, assembly.matrix_is_symmetric() ? PETSC_TRUE : PETSC_FALSE);
+                MatSetOption(A, MAT_SPD, assembly.matrix_is_spd() ? PETSC_TRUE : PETSC_FALSE);
+            }
+
+          private:
+
+            static MatrixFreeOperator& get(Mat A)
+            {
+                MatrixFreeOperator* op;
+                MatShellGetContext(A, &op);
+                return *op;
+            }
+
+            static PetscErrorCode mult(Mat A, Vec x, Vec y)
+            {
+                auto& op = get(A);
+                const PetscScalar* x_data;
+                PetscScalar* y_data;
+                VecSet(y, 0);
+                VecGetArrayRead(x, &x_data);
+                VecGetArray(y, &y_data);
+                {
+                    auto event = op.m_assembly->log_phase(LogPhase::matrix_free_mult);
+                    auto sweep = MatrixSweep::product(x_data, y_data);
+                    op.m_assembly->apply(sweep);
+                    PetscLogFlops(sweep.flops());
+                }
+                VecRestoreArray(y, &y_data);
+                VecRestoreArrayRead(x, &x_data);
+                return 0;
+            }
+
+            static PetscErrorCode get_diagonal(Mat A, Vec d)
+            {
+                auto& op = get(A);
+                PetscScalar* d_data;
+                VecSet(d, 0);
+                VecGetArray(d, &d_data);
+                auto sweep = MatrixSweep::diagonal(d_data);
+                op.m_assembly->apply(sweep);
+                VecRestoreArray(d, &d_data);
+                return 0;
+            }
+
+            static PetscErrorCode destroy(Mat A)
+            {
+                delete &get(A);
+                return 0;
+            }
+        };
+
+        /**
+         * @brief Creates a matrix-free (shell) matrix that applies the operator of the assembly without storing it.
+         * Only the preconditioners that need the diagonal of the matrix (e.g. Jacobi) can be used with it.
+         */
+        inline void create_matrix_free(MatrixAssembly& assembly, Mat& A)
+        {
+            MatrixFreeOperator::create_matrix(assembly, A);
+        }
+
+    } // end namespace petsc
+} // end namespace samurai
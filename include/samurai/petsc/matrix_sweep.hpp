@@ -0,0 +1,138 @@
+#pragma once
+#include <petsc.h>
+
+namespace samurai
+{
+    namespace petsc
+    {
+        /**
+         * Receives the coefficients of the rows of a matrix as they are computed by the sweeps of an assembly
+         * (see MatrixAssembly::apply()), without a PETSc matrix. Depending on the mode, add(row, col, a):
+         *   - product:  y[row] += a * x[col] (matrix-free product),
+         *   - diagonal: y[row] += a if row == col,
+         *   - count:    counts the coefficients of the row (upper bound of the CSR row size),
+         *   - fill:     appends (col, a) to the CSR row, in a slot sized by the count mode.
+         * clear_row(row) discards the previous coefficients of the row: the assembly calls it where it uses INSERT_VALUES.
+         */
+        class MatrixSweep
+        {
+          public:
+
+            enum class Mode
+            {
+                product,
+                diagonal,
+                count,
+                fill
+            };
+
+          private:
+
+            Mode m_mode;
+            const PetscScalar* m_x = nullptr;
+            PetscScalar* m_y       = nullptr;
+            PetscLogDouble m_flops = 0;
+
+            // CSR (count and fill modes)
+            const PetscInt* m_row_begin = nullptr;
+            PetscInt* m_row_end         = nullptr; // row size in the count mode
+            PetscInt* m_col_indices     = nullptr;
+            PetscScalar* m_values       = nullptr;
+
+            explicit MatrixSweep(Mode mode)
+                : m_mode(mode)
+            {
+            }
+
+          public:
+
+            static MatrixSweep product(const PetscScalar* x, PetscScalar* y)
+            {
+                MatrixSweep sweep(Mode::product);
+                sweep.m_x = x;
+                sweep.m_y = y;
+                return sweep;
+            }
+
+            static MatrixSweep diagonal(PetscScalar* diagonal)
+            {
+                MatrixSweep sweep(Mode::diagonal);
+                sweep.m_y = diagonal;
+                return sweep;
+            }
+
+            /**
+             * @param row_sizes zero-initialized array of the number of rows.
+             */
+            static MatrixSweep count(PetscInt* row_sizes)
+            {
+                MatrixSweep sweep(Mode::count);
+                sweep.m_row_end = row_sizes;
+                return sweep;
+            }
+
+            /**
+             * @param row_begin first slot of each row.
+             * @param row_end next free slot of each row, initialized with row_begin.
+             */
+            static MatrixSweep fill(const PetscInt* row_begin, PetscInt* row_end, PetscInt* col_indices, PetscScalar* values)
+            {
+                MatrixSweep sweep(Mode::fill);
+                sweep.m_row_begin   = row_begin;
+                sweep.m_row_end     = row_end;
+                sweep.m_col_indices = col_indices;
+                sweep.m_values      = values;
+                return sweep;
+            }
+
+            inline void add(PetscInt row, PetscInt col, PetscScalar coeff)
+            {
+                switch (m_mode)
+                {
+                    case Mode::product:
+                        m_y[row] += coeff * m_x[col];
+                        m_flops += 2;
+                        break;
+                    case Mode::diagonal:
+                        if (row == col)
+                        {
+                            m_y[row] += coeff;
+                        }
+                        break;
+                    case Mode::count:
+                        ++m_row_end[row];
+                        break;
+                    case Mode::fill:
+                    {
+                        auto slot           = m_row_end[row]++;
+                        m_col_indices[slot] = col;
+                        m_values[slot]      = coeff;
+                        break;
+                    }
+                }
+            }
+
+            inline void clear_row(PetscInt row)
+            {
+                switch (m_mode)
+                {
+                    case Mode::product:
+                    case Mode::diagonal:
+                        m_y[row] = 0;
+                        break;
+                    case Mode::count:
+                        break;
+                    case Mode::fill:
+                        m_row_end[row] = m_row_begin[row];
+                        break;
+                }
+            }
+
+            PetscLogDouble flops() const
+            {
+                return m_flops;
+            }
+        };
+
+    } // end namespace petsc
+} // end namespace samurai
@@ -0,0 +1,73 @@
+#pragma once
+#include "../../algorithm.hpp"
+
+namespace samurai
+{
+    namespace petsc
+    {
+        namespace multigrid
+        {
+            /**
+             * @brief Returns the mesh where the cells of the finest level of the input mesh are replaced with their parents,
+             * the other cells being kept.
+             * An adapted mesh is then coarsened max_level - min_level times before it is uniform;
+             * a uniform mesh has all its cells replaced with their parents.
+             */
+            template <class Mesh>
+            Mesh coarsen(const Mesh& mesh)
+            {
+                using mesh_id_t = typename Mesh::mesh_id_t;
+
+                std::size_t min_level = mesh[mesh_id_t::cells].min_level();
+                std::size_t max_level = mesh[mesh_id_t::cells].max_level();
+
+                typename Mesh::cl_type coarse_cell_list;
+                if constexpr (Mesh::dim == 1)
+                {
+                    for_each_interval(mesh[mesh_id_t::cells],
+                                      [&](size_t level, const auto& i, const auto&)
+                                      {
+                                          if (level == max_level)
+                                          {
+                                              coarse_cell_list[level - 1][{}].add_interval(i >> 1);
+                                          }
+                                          else
+                                          {
+                                              coarse_cell_list[level][{}].add_interval(i);
+                                          }
+                                      });
+                }
+                else if constexpr (Mesh::dim == 2)
+                {
+                    for_each_interval(mesh[mesh_id_t::cells],
+                                      [&](size_t level, const auto& i, const auto& index)
+                                      {
+                                          auto j = index[0];
+                                          if (level != max_level)
+                                          {
+                                              coarse_cell_list[level][{j}].add_interval(i);
+                                          }
+                                          else if (j % 2 == 0)
+                                          {
+                                              coarse_cell_list[level - 1][{j / 2}].add_interval(i / 2);
+                                          }
+                                      });
+                }
+                std::size_t coarse_min_level = (min_level == max_level) ? min_level - 1 : min_level;
+                return Mesh(coarse_cell_list, coarse_min_level, max_level - 1);
+            }
+
+            /**
+             * @brief Number of levels of the hierarchy built by coarsen() that first makes the mesh uniform,
+             * i.e. max_level - min_level + 1 levels, or 1 if the mesh is already uniform.
+             */
+            template <class Mesh>
+            std::size_t levels_to_uniform(const Mesh& mesh)
+            {
+                using mesh_id_t = typename Mesh::mesh_id_t;
+                return mesh[mesh_id_t::cells].max_level() - mesh[mesh_id_t::cells].min_level() + 1;
+            }
+
+        } // end namespace multigrid
+    } // end namespace petsc
+} // end namespace samurai
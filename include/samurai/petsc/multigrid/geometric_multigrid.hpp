@@ -0,0 +1,300 @@
+#pragma once
+#include <memory>
+
+#include "samurai_dm.hpp"
+
+namespace samurai
+{
+    namespace petsc
+    {
+        enum class Smoothers : int
+        {
+            Petsc,
+            GaussSeidel,
+            SymGaussSeidel
+        };
+
+        // PC type of the samurai multigrid, selected by '-pc_type samurai_gmg' or PCSetType(pc, PCSAMURAIGMG)
+        inline constexpr const char* PCSAMURAIGMG = "samurai_gmg";
+
+        namespace detail
+        {
+            // The PC of this type is a placeholder: the solver of a scalar field replaces it by the PCMG of the samurai hierarchy
+            // at its setup (see GeometricMultigrid::apply_as_pc())
+            inline PetscErrorCode PCCreate_SamuraiGMG(PC /*pc*/)
+            {
+                return 0;
+            }
+        }
+
+        /**
+         * @brief Registers the PC type samurai_gmg, so that PETSc accepts '-pc_type samurai_gmg'.
+         */
+        inline void register_samurai_gmg()
+        {
+            PCRegister(PCSAMURAIGMG, detail::PCCreate_SamuraiGMG);
+        }
+
+        /**
+         * @brief Is the preconditioner of the KSP the samurai multigrid?
+         */
+        inline bool is_samurai_gmg(KSP ksp)
+        {
+            PC pc;
+            KSPGetPC(ksp, &pc);
+            PetscBool is_samurai_gmg = PETSC_FALSE;
+            PetscObjectTypeCompare(reinterpret_cast<PetscObject>(pc), PCSAMURAIGMG, &is_samurai_gmg);
+            return is_samurai_gmg == PETSC_TRUE;
+        }
+
+        /**
+         * Geometric multigrid preconditioner on samurai meshes (PCMG with a samurai DM), selected by -pc_type samurai_gmg.
+         * Each coarse level is obtained by coarsening the finest cells of the finer level (see multigrid::coarsen()),
+         * and assembles the same scheme as the finest level.
+         * By default, the hierarchy has max_level - min_level + 1 levels (the coarsest one being the uniform mesh of the minimum level);
+         * -pc_mg_levels overrides it.
+         *
+         * The hierarchy (meshes, transfer operators, matrices) is built once per mesh:
+         * as long as the mesh is not adapted, a change of coefficients of the scheme (e.g. time step)
+         * only re-inserts the coefficients into the matrices of the levels.
+         *
+         * Options:
+         *   -pc_type samurai_gmg uses this preconditioner (a plain -pc_type mg is left to PETSc).
+         *   --samg_transfer_ops  1: P and R assembled, 2: P assembled and R = P^T, 3: P and R matrix-free,
+         *                        4: P and R matrix-free via the prediction and projection operators of samurai.
+         *   --samg_pred_order    order of the prediction used by the prolongation (0 or 1).
+         *   --samg_smooth        gs, sgs (default) or petsc (options of the PCMG smoothers).
+         */
+        template <class Assembly>
+        class GeometricMultigrid
+        {
+            using Field     = typename Assembly::field_t;
+            using Mesh      = typename Field::mesh_t;
+            using mesh_id_t = typename Mesh::mesh_id_t;
+
+          private:
+
+            std::unique_ptr<SamuraiDM<Assembly>> _samuraiDM;
+            std::size_t m_mesh_generation = 0;
+            bool m_verbose                = true;
+
+          public:
+
+            GeometricMultigrid() = default;
+
+            GeometricMultigrid(GeometricMultigrid&&)            = default;
+            GeometricMultigrid& operator=(GeometricMultigrid&&) = default;
+
+            /**
+             * @brief Destroys the hierarchy. The KSP it has been applied to must have been destroyed before.
+             */
+            void destroy_petsc_objects()
+            {
+                _samuraiDM = nullptr;
+            }
+
+            /**
+             * @brief Has the hierarchy been built on the current mesh of the assembly?
+             */
+            bool is_built_on(const Assembly& assembly) const
+            {
+                return _samuraiDM && m_mesh_generation == assembly.mesh_generation();
+            }
+
+            bool is_built() const
+            {
+                return _samuraiDM != nullptr;
+            }
+
+            /**
+             * @brief Re-inserts the coefficients of the scheme into the matrices of all the levels of the hierarchy.
+             */
+            void update_operators(KSP& ksp)
+            {
+                PC mg;
+                KSPGetPC(ksp, &mg);
+                PetscInt levels;
+                PCMGGetLevels(mg, &levels);
+
+                // PCMG numbers the levels from the coarsest one
+                auto* ctx = &_samuraiDM->finest_level();
+                for (PetscInt l = levels - 1; l >= 0 && ctx; --l)
+                {
+                    KSP level_ksp;
+                    PCMGGetSmoother(mg, l, &level_ksp);
+                    Mat A;
+                    KSPGetOperators(level_ksp, &A, nullptr);
+                    ctx->assembly().reassemble_matrix(A);
+                    ctx = ctx->coarser;
+                }
+            }
+
+            void apply_as_pc(KSP& ksp, const Assembly& assembly)
+            {
+                PetscInt transfer_ops_arg = static_cast<PetscInt>(TransferOperators::Assembled);
+                PetscOptionsGetInt(NULL, NULL, "--samg_transfer_ops", &transfer_ops_arg, NULL);
+                auto transfer_ops = static_cast<TransferOperators>(transfer_ops_arg);
+
+                PetscInt prediction_order = 0;
+                PetscOptionsGetInt(NULL, NULL, "--samg_pred_order", &prediction_order, NULL);
+
+                PetscBool smoother_is_set = PETSC_FALSE;
+                Smoothers smoother        = Smoothers::SymGaussSeidel;
+                char smoother_char_array[10];
+                PetscOptionsGetString(NULL, NULL, "--samg_smooth", smoother_char_array, 10, &smoother_is_set);
+                if (smoother_is_set)
+                {
+                    std::string value = smoother_char_array;
+                    if (value == "gs")
+                    {
+                        smoother = Smoothers::GaussSeidel;
+                    }
+                    else if (value == "sgs")
+                    {
+                        smoother = Smoothers::SymGaussSeidel;
+                    }
+                    else if (value == "petsc")
+                    {
+                        smoother = Smoothers::Petsc;
+                    }
+                    else
+                    {
+                        std::cerr << "Unknown value for the option --samg_smooth: " << value << std::endl;
+                        assert(false && "Unknown value for the option --samg_smooth");
+                        exit(EXIT_FAILURE);
+                    }
+                }
+
+                _samuraiDM        = std::make_unique<SamuraiDM<Assembly>>(PETSC_COMM_SELF, assembly, transfer_ops, prediction_order);
+                m_mesh_generation = assembly.mesh_generation();
+                auto& mesh        = _samuraiDM->finest_level().mesh();
+
+                PC mg;
+                KSPGetPC(ksp, &mg);
+                PCSetType(mg, PCMG);
+                // The options of PCMG have not been read, the type of the PC being samurai_gmg
+                const char* prefix = nullptr;
+                PCGetOptionsPrefix(mg, &prefix);
+                PetscInt levels = -1;
+                PetscOptionsGetInt(NULL, prefix, "-pc_mg_levels", &levels, NULL);
+                if (levels < 2) // not set by -pc_mg_levels
+                {
+                    // An adapted mesh is coarsened down to the uniform mesh of its minimum level
+                    levels = static_cast<PetscInt>(multigrid::levels_to_uniform(mesh));
+                    if (levels == 1)
+                    {
+                        levels = std::max(static_cast<PetscInt>(mesh[mesh_id_t::cells].max_level()) - 3, PetscInt{2});
+                        levels = std::min(levels, PetscInt{8});
+                    }
+                }
+                // The coarsest level cannot go below the level 0
+                levels = std::min(levels, static_cast<PetscInt>(mesh[mesh_id_t::cells].max_level()) + 1);
+
+                if (m_verbose)
+                {
+                    print_info(smoother, transfer_ops, prediction_order, levels);
+                    m_verbose = false; // the hierarchy is rebuilt at each mesh adaptation
+                }
+
+                KSPSetDM(ksp, _samuraiDM->PetscDM());
+                KSPSetComputeOperators(ksp, SamuraiDM<Assembly>::ComputeMatrix, NULL);
+                PCMGSetLevels(mg, levels, nullptr);
+
+                // All of the following must be called after PCMGSetLevels()
+
+                if (smoother == Smoothers::GaussSeidel)
+                {
+                    PCMGSetDistinctSmoothUp(mg);
+                }
+
+                if (smoother != Smoothers::Petsc)
+                {
+                    for (int i = 1; i < levels; i++)
+                    {
+                        if (smoother == Smoothers::SymGaussSeidel)
+                        {
+                            KSP smoother_ksp;
+                            PCMGGetSmoother(mg, i, &smoother_ksp);
+                            KSPSetType(smoother_ksp, "richardson");
+                            KSPSetTolerances(smoother_ksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 1);
+                            PC smoother_pc;
+                            KSPGetPC(smoother_ksp, &smoother_pc);
+                            PCSetType(smoother_pc, PCSOR);
+                            PCSORSetSymmetric(smoother_pc, MatSORType::SOR_SYMMETRIC_SWEEP);
+                            PCSORSetIterations(smoother_pc, 1, 1);
+                        }
+                        else if (smoother == Smoothers::GaussSeidel)
+                        {
+                            // Pre-smoothing
+                            KSP pre_smoother_ksp;
+                            PCMGGetSmootherDown(mg, i, &pre_smoother_ksp);
+                            KSPSetType(pre_smoother_ksp, "richardson");
+                            KSPSetTolerances(pre_smoother_ksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 1);
+                            PC pre_smoother;
+                            KSPGetPC(pre_smoother_ksp, &pre_smoother);
+                            PCSetType(pre_smoother, PCSOR);
+                            PCSORSetSymmetric(pre_smoother, MatSORType::SOR_FORWARD_SWEEP);
+                            PCSORSetIterations(pre_smoother, 1, 1);
+
+                            // Post-smoothing
+                            KSP post_smoother_ksp;
+                            PCMGGetSmootherUp(mg, i, &post_smoother_ksp);
+                            KSPSetType(post_smoother_ksp, "richardson");
+                            KSPSetTolerances(post_smoother_ksp, PETSC_DEFAULT, PETSC_DEFAULT, PETSC_DEFAULT, 1);
+                            PC post_smoother;
+                            KSPGetPC(post_smoother_ksp, &post_smoother);
+                            PCSetType(post_smoother, PCSOR);
+                            PCSORSetSymmetric(post_smoother, MatSORType::SOR_BACKWARD_SWEEP);
+                            PCSORSetIterations(post_smoother, 1, 1);
+                        }
+                    }
+                }
+            }
+
+          private:
+
+            static void print_info(Smoothers smoother, TransferOperators transfer_ops, PetscInt prediction_order, PetscInt levels)
+            {
+                std::cout << "Samurai multigrid: " << std::endl;
+
+                std::cout << "    smoothers         : ";
+                if (smoother == Smoothers::GaussSeidel)
+                {
+                    std::cout << "Gauss-Seidel (pre: lexico., post: antilexico.)";
+                }
+                else if (smoother == Smoothers::SymGaussSeidel)
+                {
+                    std::cout << "symmetric Gauss-Seidel";
+                }
+                else if (smoother == Smoothers::Petsc)
+                {
+                    std::cout << "petsc options";
+                }
+                std::cout << std::endl;
+
+                std::cout << "    transfer operators: ";
+                if (transfer_ops == TransferOperators::Assembled)
+                {
+                    std::cout << "P assembled, R assembled";
+                }
+                else if (transfer_ops == TransferOperators::Assembled_PTranspose)
+                {
+                    std::cout << "P assembled, R = P^T";
+                }
+                else if (transfer_ops == TransferOperators::MatrixFree_Arrays)
+                {
+                    std::cout << "P mat-free, R mat-free (via double*)";
+                }
+                else if (transfer_ops == TransferOperators::MatrixFree_Fields)
+                {
+                    std::cout << "P mat-free, R mat-free (via Fields)";
+                }
+                std::cout << std::endl;
+
+                std::cout << "    prediction order  : " << prediction_order << std::endl;
+                std::cout << "    levels            : " << levels << std::endl;
+            }
+        };
+
+    } // end namespace petsc
+} // end namespace samurai
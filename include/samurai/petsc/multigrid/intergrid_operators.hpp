@@ -1,14 +1,39 @@
 #pragma once
-#include "../LevelCtx.hpp"
-#include <samurai/numeric/prediction.hpp>
-#include <samurai/numeric/projection.hpp>
+#include "../../numeric/prediction.hpp"
+#include "../../numeric/projection.hpp"
+#include "level_context.hpp"
 
-namespace samurai_new
+namespace samurai
 {
     namespace petsc
     {
         namespace multigrid
         {
+            /**
+             * @brief Calls f(coarse index, fine index, size) on the intervals of boundary ghosts that the coarse and fine meshes
+             * both have on the level (ghosts of the cells kept by the coarsening).
+             */
+            template <class Mesh, class Func>
+            void for_each_shared_boundary_ghost(const Mesh& coarse_mesh, const Mesh& fine_mesh, std::size_t level, Func&& f)
+            {
+                using mesh_id_t = typename Mesh::mesh_id_t;
+
+                auto shared_ghosts = samurai::intersection(samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain()),
+                                                           coarse_mesh[mesh_id_t::reference][level])
+                                         .on(level);
+                shared_ghosts(
+                    [&](const auto& i, const auto& index)
+                    {
+                        if constexpr (Mesh::dim == 1)
+                        {
+                            f(coarse_mesh.get_index(level, i.start), fine_mesh.get_index(level, i.start), i.size());
+                        }
+                        else
+                        {
+                            f(coarse_mesh.get_index(level, i.start, index[0]), fine_mesh.get_index(level, i.start, index[0]), i.size());
+                        }
+                    });
+            }
 
             template <class Mesh>
             void prolong(const Mesh& coarse_mesh, const Mesh& fine_mesh, const double* carray, double* farray, int prediction_order)
@@ -34,6 +59,22 @@ namespace samurai_new
                             }
                         });
 
+                    for_each_shared_boundary_ghost(coarse_mesh,
+                                                   fine_mesh,
+                                                   level,
+                                                   [&](auto i_c, auto i_f, auto size)
+                                                   {
+                                                       for (std::size_t ii = 0; ii < size; ++ii)
+                                                       {
+                                                           farray[i_f + ii] = carray[i_c + ii];
+                                                       }
+                                                   });
+
+                    if (level == 0)
+                    {
+                        continue; // no coarser cell
+                    }
+
                     // Coarse cells to fine cells: prediction
                     auto others = samurai::intersection(cm[level - 1], fm[level]).on(level - 1);
                     others(
@@ -110,7 +151,8 @@ namespace samurai_new
                     // Boundary
                     if constexpr (dim == 1)
                     {
-                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain()).on(level);
+                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain(), coarse_mesh[mesh_id_t::reference][level])
+                                                 .on(level);
                         fine_boundary(
                             [&](const auto& i, auto)
                             {
@@ -222,6 +264,26 @@ namespace samurai_new
                             }
                         });
 
+                    for_each_shared_boundary_ghost(coarse_mesh,
+                                                   fine_mesh,
+                                                   level,
+                                                   [&](auto i_c, auto i_f, auto size)
+                                                   {
+                                                       for (std::size_t ii = 0; ii < size; ++ii)
+                                                       {
+                                                           MatSetValue(P,
+                                                                       static_cast<PetscInt>(i_f + ii),
+                                                                       static_cast<PetscInt>(i_c + ii),
+                                                                       1,
+                                                                       INSERT_VALUES);
+                                                       }
+                                                   });
+
+                    if (level == 0)
+                    {
+                        continue; // no coarser cell
+                    }
+
                     // Coarse cells to fine cells: prediction
                     auto others = samurai::intersection(cm[level - 1], fm[level]).on(level - 1);
                     others(
@@ -383,7 +445,8 @@ namespace samurai_new
                     // Boundary
                     if constexpr (dim == 1)
                     {
-                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain()).on(level);
+                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain(), coarse_mesh[mesh_id_t::reference][level])
+                                                 .on(level);
                         fine_boundary(
                             [&](const auto& i, auto)
                             {
@@ -510,6 +573,22 @@ namespace samurai_new
                             fine_field(level, i) = coarse_field(level, i);
                         });
 
+                    for_each_shared_boundary_ghost(coarse_mesh,
+                                                   fine_mesh,
+                                                   level,
+                                                   [&](auto i_c, auto i_f, auto size)
+                                                   {
+                                                       for (std::size_t ii = 0; ii < size; ++ii)
+                                                       {
+                                                           fine_field.array()[i_f + ii] = coarse_field.array()[i_c + ii];
+                                                       }
+                                                   });
+
+                    if (level == 0)
+                    {
+                        continue; // no coarser cell
+                    }
+
                     // Coarse cells to fine cells: prediction
                     auto others = samurai::intersection(cm[level - 1], fm[level]).on(level - 1);
                     if (prediction_order == 0)
@@ -524,7 +603,8 @@ namespace samurai_new
                     // Boundary
                     if constexpr (dim == 1)
                     {
-                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain()).on(level);
+                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level], fine_mesh.domain(), coarse_mesh[mesh_id_t::reference][level])
+                                                 .on(level);
                         fine_boundary(
                             [&](const auto& i, auto)
                             {
@@ -608,6 +688,17 @@ namespace samurai_new
                             }
                         });
 
+                    for_each_shared_boundary_ghost(coarse_mesh,
+                                                   fine_mesh,
+                                                   level,
+                                                   [&](auto i_c, auto i_f, auto size)
+                                                   {
+                                                       for (std::size_t ii = 0; ii < size; ++ii)
+                                                       {
+                                                           carray[i_c + ii] = farray[i_f + ii];
+                                                       }
+                                                   });
+
                     // Fine cells to coarse cells: projection
                     auto others = samurai::intersection(cm[level], fm[level + 1]).on(level);
                     others(
@@ -642,7 +733,8 @@ namespace samurai_new
                     // Boundary
                     if constexpr (dim == 1)
                     {
-                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level + 1], fine_mesh.domain()).on(level + 1);
+                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level + 1], fine_mesh.domain(), coarse_mesh[mesh_id_t::reference][level + 1])
+                                                 .on(level + 1);
                         fine_boundary(
                             [&](const auto& i, auto)
                             {
@@ -776,6 +868,21 @@ namespace samurai_new
                             }
                         });
 
+                    for_each_shared_boundary_ghost(coarse_mesh,
+                                                   fine_mesh,
+                                                   level,
+                                                   [&](auto i_c, auto i_f, auto size)
+                                                   {
+                                                       for (std::size_t ii = 0; ii < size; ++ii)
+                                                       {
+                                                           MatSetValue(R,
+                                                                       static_cast<PetscInt>(i_c + ii),
+                                                                       static_cast<PetscInt>(i_f + ii),
+                                                                       1,
+                                                                       INSERT_VALUES);
+                                                       }
+                                                   });
+
                     // Fine cells to coarse cells: projection
                     auto others = samurai::intersection(cm[level], fm[level + 1]).on(level);
                     others(
@@ -818,7 +925,8 @@ namespace samurai_new
                     // Boundary
                     if constexpr (dim == 1)
                     {
-                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level + 1], fine_mesh.domain()).on(level + 1);
+                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level + 1], fine_mesh.domain(), coarse_mesh[mesh_id_t::reference][level + 1])
+                                                 .on(level + 1);
                         fine_boundary(
                             [&](const auto& i, auto)
                             {
@@ -949,6 +1057,17 @@ namespace samurai_new
                             coarse_field(level, i) = fine_field(level, i);
                         });
 
+                    for_each_shared_boundary_ghost(coarse_mesh,
+                                                   fine_mesh,
+                                                   level,
+                                                   [&](auto i_c, auto i_f, auto size)
+                                                   {
+                                                       for (std::size_t ii = 0; ii < size; ++ii)
+                                                       {
+                                                           coarse_field.array()[i_c + ii] = fine_field.array()[i_f + ii];
+                                                       }
+                                                   });
+
                     // Fine cells to coarse cells: projection
                     auto others = samurai::intersection(cm[level], fm[level + 1]).on(level);
                     others.apply_op(samurai::projection(coarse_field, fine_field));
@@ -956,7 +1075,7 @@ namespace samurai_new
                     // Boundary
                     if constexpr (dim == 1)
                     {
-                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level + 1], fine_mesh.domain());
+                        auto fine_boundary = samurai::difference(fine_mesh[mesh_id_t::reference][level + 1], fine_mesh.domain(), coarse_mesh[mesh_id_t::reference][level + 1]);
                         fine_boundary(
                             [&](const auto& i, auto)
                             {
@@ -1068,6 +1187,6 @@ namespace samurai_new
                 return coarse_field;
             }
 
-        }
-    }
-} // namespace
+        } // end namespace multigrid
+    } // end namespace petsc
+} // end namespace samurai
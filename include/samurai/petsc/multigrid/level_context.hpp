@@ -0,0 +1,175 @@
+#pragma once
+#include <memory>
+
+#include "../../bc.hpp"
+#include "coarsening.hpp"
+
+namespace samurai
+{
+    namespace petsc
+    {
+        enum class TransferOperators : int
+        {
+            // P assembled, R = assembled
+            Assembled = 1,
+            // P assembled, R = P^T
+            Assembled_PTranspose,
+            // P mat-free, R mat-free (via double*)
+            MatrixFree_Arrays,
+            // P mat-free, R mat-free (via Fields, i.e. the prediction and projection operators of samurai)
+            MatrixFree_Fields
+        };
+
+        namespace multigrid
+        {
+            /**
+             * Region of a boundary condition on a coarse mesh: the parents of the boundary cells of the fine region.
+             */
+            template <std::size_t dim, class TInterval>
+            class CoarseBcRegion : public BcRegion<dim, TInterval>
+            {
+              public:
+
+                using base_t   = BcRegion<dim, TInterval>;
+                using lca_t    = typename base_t::lca_t;
+                using region_t = typename base_t::region_t;
+
+                explicit CoarseBcRegion(const region_t& fine_region)
+                    : m_fine_region(fine_region)
+                {
+                }
+
+                region_t get_region(const lca_t& coarse_domain) const override
+                {
+                    region_t region;
+                    region.first = m_fine_region.first;
+                    for (const auto& fine_cells : m_fine_region.second)
+                    {
+                        region.second.emplace_back(intersection(coarse_domain, fine_cells).on(coarse_domain.level()));
+                    }
+                    return region;
+                }
+
+                std::unique_ptr<base_t> clone() const override
+                {
+                    return std::make_unique<CoarseBcRegion>(m_fine_region);
+                }
+
+              private:
+
+                region_t m_fine_region;
+            };
+
+            /**
+             * @brief Attaches to the coarse field the boundary conditions of the fine field, with the same types and regions.
+             * Only the types matter to assemble the coarse matrices: the values are set to zero.
+             */
+            template <class Field>
+            void attach_coarse_bc(Field& fine_field, Field& coarse_field)
+            {
+                using interval_t = typename Field::interval_t;
+
+                auto& coarse_domain = coarse_field.mesh().domain();
+                for (auto& bc : fine_field.get_bc())
+                {
+                    CoarseBcRegion<Field::dim, interval_t> region(bc->get_region());
+                    if (dynamic_cast<Dirichlet<Field>*>(bc.get()))
+                    {
+                        coarse_field.attach_bc(Dirichlet<Field>(coarse_domain, ConstantBc<Field>(), region));
+                    }
+                    else if (dynamic_cast<Neumann<Field>*>(bc.get()))
+                    {
+                        coarse_field.attach_bc(Neumann<Field>(coarse_domain, ConstantBc<Field>(), region));
+                    }
+                }
+            }
+        } // end namespace multigrid
+
+        /**
+         * Level of the multigrid hierarchy: mesh, unknown and assembly of the operator on that mesh.
+         * The finest level works on the mesh and the unknown of the solver.
+         * The coarse levels own their mesh (coarsened from the finer one) and unknown,
+         * and assemble the same scheme as the finest level.
+         */
+        template <class Assembly>
+        class LevelContext
+        {
+          public:
+
+            using field_t = typename Assembly::field_t;
+            using Mesh    = typename field_t::mesh_t;
+
+          private:
+
+            std::unique_ptr<Mesh> m_coarse_mesh;       // coarse levels only
+            std::unique_ptr<field_t> m_coarse_unknown; // coarse levels only
+            Mesh* m_mesh;
+            Assembly m_assembly;
+            std::unique_ptr<LevelContext> m_coarser;
+
+          public:
+
+            int level             = 0;
+            LevelContext* finer   = nullptr;
+            LevelContext* coarser = nullptr;
+            TransferOperators transfer_ops;
+            int prediction_order;
+
+            LevelContext(const Assembly& assembly, TransferOperators to, int pred_order)
+                : m_mesh(&assembly.unknown().mesh())
+                , m_assembly(assembly)
+                , transfer_ops(to)
+                , prediction_order(pred_order)
+            {
+            }
+
+            explicit LevelContext(LevelContext& fine_ctx)
+                : m_coarse_mesh(std::make_unique<Mesh>(multigrid::coarsen(fine_ctx.mesh())))
+                , m_coarse_unknown(std::make_unique<field_t>(fine_ctx.unknown().name(), *m_coarse_mesh))
+                , m_mesh(m_coarse_mesh.get())
+                , m_assembly(fine_ctx.assembly().scheme())
+                , level(fine_ctx.level + 1)
+                , finer(&fine_ctx)
+                , transfer_ops(fine_ctx.transfer_ops)
+                , prediction_order(fine_ctx.prediction_order)
+            {
+                multigrid::attach_coarse_bc(fine_ctx.unknown(), *m_coarse_unknown);
+                m_assembly.set_unknown(*m_coarse_unknown);
+            }
+
+            LevelContext(const LevelContext&)            = delete;
+            LevelContext& operator=(const LevelContext&) = delete;
+
+            /**
+             * @brief Creates the next coarser level, owned by this one. A previous coarser level is destroyed.
+             */
+            LevelContext& create_coarser()
+            {
+                m_coarser = std::make_unique<LevelContext>(*this);
+                coarser   = m_coarser.get();
+                return *coarser;
+            }
+
+            Mesh& mesh()
+            {
+                return *m_mesh;
+            }
+
+            field_t& unknown()
+            {
+                return m_assembly.unknown();
+            }
+
+            Assembly& assembly()
+            {
+                return m_assembly;
+            }
+
+            bool is_finest()
+            {
+                return level == 0;
+            }
+        };
+
+    } // end namespace petsc
+} // end namespace samurai
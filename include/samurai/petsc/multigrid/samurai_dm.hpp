@@ -1,53 +1,65 @@
 #pragma once
+#include "../utils.hpp"
 #include "intergrid_operators.hpp"
-#include <samurai/petsc/utils.hpp>
 
-namespace samurai_new
+namespace samurai
 {
     namespace petsc
     {
-
-        template <class Dsctzr>
+        /**
+         * PETSc DM (shell) of the multigrid hierarchy, used by PCMG to create the coarse levels,
+         * their matrices and the transfer operators between levels.
+         * The contexts of the levels are owned by the finest one, so that the hierarchy lives as long as this object.
+         */
+        template <class Assembly>
         class SamuraiDM
         {
           private:
 
-            DM _dm;
-            LevelContext<Dsctzr> _ctx;
-            // SamuraiDM* _coarse = nullptr;
+            DM _dm = nullptr;
+            LevelContext<Assembly> _ctx;
 
           public:
 
-            using Mesh  = typename Dsctzr::Mesh;
-            using Field = typename Dsctzr::field_t;
+            using Field = typename Assembly::field_t;
 
-            SamuraiDM(MPI_Comm comm, Dsctzr& assembly, Mesh& mesh, TransferOperators to, int prediction_order)
-                : _ctx(assembly, mesh, to, prediction_order)
+            SamuraiDM(MPI_Comm comm, const Assembly& assembly, TransferOperators to, int prediction_order)
+                : _ctx(assembly, to, prediction_order)
             {
                 DMShellCreate(comm, &_dm);
                 DefineShellFunctions(_dm, _ctx);
             }
 
-            /*SamuraiDM(MPI_Comm comm, const LevelCtx<Dsctzr>& fine_ctx) :
-                _ctx(fine_ctx)
+            SamuraiDM(const SamuraiDM&)            = delete;
+            SamuraiDM& operator=(const SamuraiDM&) = delete;
+
+            ~SamuraiDM()
             {
-                DMShellCreate(comm, &_dm);
-                DefineShellFunctions(_dm, _ctx);
-            }*/
+                destroy_petsc_objects();
+            }
 
             DM& PetscDM()
             {
                 return _dm;
             }
 
+            LevelContext<Assembly>& finest_level()
+            {
+                return _ctx;
+            }
+
             void destroy_petsc_objects()
             {
-                DMDestroy(&_dm);
+                if (_dm)
+                {
+                    DMDestroy(&_dm);
+                    _dm = nullptr;
+                }
             }
 
           private:
 
-            static void DefineShellFunctions(DM& shell, LevelContext<Dsctzr>& ctx)
+            static void DefineShellFunctions(DM& shell, LevelContext<Assembly>& ctx)
             {
                 DMShellSetContext(shell, &ctx);
                 DMShellSetCreateMatrix(shell, CreateMatrix);
@@ -72,35 +84,24 @@ namespace samurai_new
 
             static PetscErrorCode Coarsen(DM fine_dm, MPI_Comm /*comm*/, DM* coarse_dm)
             {
-                // std::cout << "Coarsen - begin" << std::endl;
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 DMShellGetContext(fine_dm, &fine_ctx);
 
-                LevelContext<Dsctzr>* coarse_ctx = new LevelContext(*fine_ctx);
-
-                //_coarse = new SamuraiDM(PetscObjectComm((PetscObject)fine_dm),
-                //*fine_ctx); *coarse_dm = _coarse->PetscDM();
+                // The coarse context is owned by the fine one
+                auto& coarse_ctx = fine_ctx->create_coarser();
 
                 DMShellCreate(PetscObjectComm(reinterpret_cast<PetscObject>(fine_dm)), coarse_dm);
-                DefineShellFunctions(*coarse_dm, *coarse_ctx);
-
-                // DMShellCreate(PetscObjectComm((PetscObject)fine_dm),
-                // coarse_dm); DefineShellFunctions(*coarse_dm, *coarse_ctx);
-                // std::cout << "Coarsen (create level " << coarse_ctx->level <<
-                // ")" << std::endl;
+                DefineShellFunctions(*coarse_dm, coarse_ctx);
                 return 0;
             }
 
             static PetscErrorCode CreateMatrix(DM shell, Mat* A)
             {
-                LevelContext<Dsctzr>* ctx;
+                LevelContext<Assembly>* ctx;
                 DMShellGetContext(shell, &ctx);
 
                 ctx->assembly().create_matrix(*A);
-                // std::cout << "CreateMatrix - level " << ctx->level <<
-                // std::endl;
-
-                MatSetDM(*A, shell); // Why???
+                MatSetDM(*A, shell);
                 return 0;
             }
 
@@ -110,13 +111,20 @@ namespace samurai_new
             {
                 DM shell;
                 KSPGetDM(ksp, &shell);
-                LevelContext<Dsctzr>* ctx;
+                LevelContext<Assembly>* ctx;
                 DMShellGetContext(shell, &ctx);
 
-                ctx->assembly().assemble_matrix(jac);
-
-                // MatView(jac, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF));
-                // std::cout << std::endl;
+                // Called again when the coefficients of the scheme change: the structure of the matrix is then kept
+                PetscBool assembled;
+                MatAssembled(jac, &assembled);
+                if (assembled)
+                {
+                    ctx->assembly().reassemble_matrix(jac);
+                }
+                else
+                {
+                    ctx->assembly().assemble_matrix(jac);
+                }
                 return 0;
             }
 
@@ -124,9 +132,9 @@ namespace samurai_new
 
             static PetscErrorCode CreateMatFreeProlongation(DM coarse_dm, DM fine_dm, Mat* P, Vec* scaling)
             {
-                LevelContext<Dsctzr>* coarse_ctx;
+                LevelContext<Assembly>* coarse_ctx;
                 DMShellGetContext(coarse_dm, &coarse_ctx);
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 DMShellGetContext(fine_dm, &fine_ctx);
 
                 auto nf = static_cast<PetscInt>(fine_ctx->mesh().nb_cells());
@@ -135,32 +143,24 @@ namespace samurai_new
                 MatCreateShell(PetscObjectComm(reinterpret_cast<PetscObject>(fine_dm)), nf, nc, nf, nc, coarse_ctx, P);
                 MatShellSetOperation(*P, MATOP_MULT, reinterpret_cast<void (*)(void)>(prolongation));
 
-                *scaling = nullptr; // Why???
+                *scaling = nullptr; // no scaling of the restriction
 
                 return 0;
             }
 
             static PetscErrorCode prolongation(Mat P, Vec x, Vec y)
             {
-                LevelContext<Dsctzr>* coarse_ctx;
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* coarse_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 MatShellGetContext(P, &coarse_ctx);
                 fine_ctx = coarse_ctx->finer;
 
-                // std::cout << "coarse vector x:" << std::endl;
-                // VecView(x, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout
-                // << std::endl;
-
                 if (coarse_ctx->transfer_ops == TransferOperators::MatrixFree_Fields)
                 {
                     Field coarse_field("coarse_field", coarse_ctx->mesh());
                     samurai::petsc::copy(x, coarse_field);
                     Field fine_field = multigrid::prolong(coarse_field, fine_ctx->mesh(), coarse_ctx->prediction_order);
                     samurai::petsc::copy(fine_field, y);
-
-                    // std::cout << "prolongated vector (marche):" << std::endl;
-                    // VecView(y, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF));
-                    // std::cout << std::endl;
                 }
                 else
                 {
@@ -171,47 +171,17 @@ namespace samurai_new
                     multigrid::prolong(coarse_ctx->mesh(), fine_ctx->mesh(), xarray, yarray, coarse_ctx->prediction_order);
                     VecRestoreArrayRead(x, &xarray);
                     VecRestoreArray(y, &yarray);
-
-                    /*std::cout << "prolongated vector (marche):" << std::endl;
-                    VecView(y, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout
-                    << std::endl;
-
-                    // With matrix
-                    std::size_t nf = fine_ctx->mesh().nb_cells();
-                    std::size_t nc = coarse_ctx->mesh().nb_cells();
-
-                    int stencil_size = 9; // in 2D!!!!!!
-
-                    Mat P2;
-                    MatCreate(PETSC_COMM_SELF, &P2);
-                    MatSetSizes(P2, nf, nc, nf, nc);
-                    MatSetFromOptions(P2);
-                    MatSeqAIJSetPreallocation(P2, stencil_size, NULL);
-                    multigrid::set_prolong_matrix(coarse_ctx->mesh(),
-                    fine_ctx->mesh(), P2); MatAssemblyBegin(P2,
-                    MAT_FINAL_ASSEMBLY); MatAssemblyEnd(P2, MAT_FINAL_ASSEMBLY);
-
-                    std::cout << "prolongated vector with matrix (marche pas):"
-                    << std::endl; Vec y2; VecCreateSeq(PETSC_COMM_SELF, nf,
-                    &y2); MatMult(P2, x, y2); VecView(y2,
-                    PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout <<
-                    std::endl;*/
                 }
 
-                // std::cout << "prolongated vector:" << std::endl;
-                // VecView(y, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout
-                // << std::endl; PetscReal norm; VecNorm(y, NORM_2, &norm);
-                // std::cout << "prolongated vector norm:" << norm << std::endl;
-
                 assert(samurai::petsc::check_nan_or_inf(y) && "Nan or Inf after prolongation");
                 return 0;
             }
 
             static PetscErrorCode CreateProlongationMatrix(DM coarse_dm, DM fine_dm, Mat* P, Vec* scaling)
             {
-                LevelContext<Dsctzr>* coarse_ctx;
+                LevelContext<Assembly>* coarse_ctx;
                 DMShellGetContext(coarse_dm, &coarse_ctx);
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 DMShellGetContext(fine_dm, &fine_ctx);
 
                 auto nf = static_cast<PetscInt>(fine_ctx->mesh().nb_cells());
@@ -231,19 +201,16 @@ namespace samurai_new
                 MatAssemblyBegin(*P, MAT_FINAL_ASSEMBLY);
                 MatAssemblyEnd(*P, MAT_FINAL_ASSEMBLY);
 
-                // MatView(*P, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout
-                // << std::endl;
-
-                *scaling = nullptr; // Why???
+                *scaling = nullptr; // no scaling of the restriction
 
                 return 0;
             }
 
             static PetscErrorCode CreateMatFreeRestriction(DM coarse_dm, DM fine_dm, Mat* R)
             {
-                LevelContext<Dsctzr>* coarse_ctx;
+                LevelContext<Assembly>* coarse_ctx;
                 DMShellGetContext(coarse_dm, &coarse_ctx);
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 DMShellGetContext(fine_dm, &fine_ctx);
 
                 auto nf = static_cast<PetscInt>(fine_ctx->mesh().nb_cells());
@@ -256,13 +223,9 @@ namespace samurai_new
 
             static PetscErrorCode restriction(Mat R, Vec x, Vec y)
             {
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 MatShellGetContext(R, &fine_ctx);
-                LevelContext<Dsctzr>* coarse_ctx = fine_ctx->coarser;
-
-                // std::cout << "restriction - fine vector:" << std::endl;
-                // VecView(x, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout
-                // << std::endl;
+                LevelContext<Assembly>* coarse_ctx = fine_ctx->coarser;
 
                 if (coarse_ctx->transfer_ops == TransferOperators::MatrixFree_Fields)
                 {
@@ -282,20 +245,15 @@ namespace samurai_new
                     VecRestoreArray(y, &yarray);
                 }
 
-                // std::cout << "restriction - restricted vector:" << std::endl;
-                // VecView(y, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout
-                // << std::endl; PetscReal norm; VecNorm(y, NORM_2, &norm);
-                // std::cout << "restricted vector norm:" << norm << std::endl;
-
                 assert(samurai::petsc::check_nan_or_inf(y) && "Nan or Inf after restriction");
                 return 0;
             }
 
             static PetscErrorCode CreateRestrictionMatrix(DM coarse_dm, DM fine_dm, Mat* R)
             {
-                LevelContext<Dsctzr>* coarse_ctx;
+                LevelContext<Assembly>* coarse_ctx;
                 DMShellGetContext(coarse_dm, &coarse_ctx);
-                LevelContext<Dsctzr>* fine_ctx;
+                LevelContext<Assembly>* fine_ctx;
                 DMShellGetContext(fine_dm, &fine_ctx);
 
                 auto nf = static_cast<PetscInt>(fine_ctx->mesh().nb_cells());
@@ -319,35 +277,27 @@ namespace samurai_new
                 MatAssemblyBegin(*R, MAT_FINAL_ASSEMBLY);
                 MatAssemblyEnd(*R, MAT_FINAL_ASSEMBLY);
 
-                // MatView(*R, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF));
-                // std::cout << std::endl;
-
                 return 0;
             }
 
             static PetscErrorCode CreateGlobalVector(DM shell, Vec* x)
             {
-                // std::cout << "CreateGlobalVector - begin " << std::endl;
-                LevelContext<Dsctzr>* ctx;
+                LevelContext<Assembly>* ctx;
                 DMShellGetContext(shell, &ctx);
                 VecCreateSeq(PETSC_COMM_SELF, static_cast<PetscInt>(ctx->mesh().nb_cells()), x);
                 VecSetDM(*x, shell);
-                // std::cout << "CreateGlobalVector - level " << ctx->level <<
-                // std::endl;
                 return 0;
             }
 
             static PetscErrorCode CreateLocalVector(DM shell, Vec* x)
             {
-                // std::cout << "CreateLocalVector - begin" << std::endl;
-                LevelContext<Dsctzr>* ctx;
+                LevelContext<Assembly>* ctx;
                 DMShellGetContext(shell, &ctx);
                 VecCreateSeq(PETSC_COMM_SELF, static_cast<PetscInt>(ctx->mesh().nb_cells()), x);
                 VecSetDM(*x, shell);
-                // std::cout << "CreateLocalVector - end" << std::endl;
                 return 0;
             }
         };
 
-    } // namespace petsc
-} // namespace samurai_new
+    } // end namespace petsc
+} // end namespace samurai
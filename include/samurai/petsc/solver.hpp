@@ -1,15 +1,12 @@
 #pragma once
 
-// #define ENABLE_MG
 #include "block_assembly.hpp"
 #include "fv/cell_based_scheme_assembly.hpp"
 #include "fv/flux_based_scheme_assembly.hpp"
 #include "fv/scheme_operators_assembly.hpp"
-#ifdef ENABLE_MG
-#include "multigrid/petsc/GeometricMultigrid.hpp"
-#else
+#include "matrix_free.hpp"
+#include "multigrid/geometric_multigrid.hpp"
 #include "utils.hpp"
-#endif
 
 namespace samurai
 {
@@ -18,7 +15,8 @@ namespace samurai
         template <class Assembly>
         class SolverBase
         {
-            using scheme_t = typename Assembly::scheme_t;
+            using scheme_t          = typename Assembly::scheme_t;
+            using mesh_generation_t = decltype(std::declval<const Assembly&>().mesh_generation());
 
           protected:
 
@@ -27,6 +25,12 @@ namespace samurai
             Mat m_A          = nullptr;
             bool m_is_set_up = false;
 
+            mesh_generation_t m_mesh_generation{}; // generation of the mesh(es) on which m_A has been created
+            bool m_coefficients_changed = false;
+            bool m_reuse_preconditioner = false;
+            bool m_matrix_free          = false;
+            bool m_csr_assembly         = false;
+
           public:
 
             explicit SolverBase(const scheme_t& scheme)
@@ -63,6 +67,12 @@ namespace samurai
                     this->m_ksp       = other.m_ksp;
                     this->m_A         = other.m_A;
                     this->m_is_set_up = other.m_is_set_up;
+
+                    this->m_mesh_generation      = other.m_mesh_generation;
+                    this->m_coefficients_changed = other.m_coefficients_changed;
+                    this->m_reuse_preconditioner = other.m_reuse_preconditioner;
+                    this->m_matrix_free          = other.m_matrix_free;
+                    this->m_csr_assembly         = other.m_csr_assembly;
                 }
                 return *this;
             }
@@ -76,6 +86,12 @@ namespace samurai
                     this->m_ksp       = other.m_ksp;
                     this->m_A         = other.m_A;
                     this->m_is_set_up = other.m_is_set_up;
+
+                    this->m_mesh_generation      = other.m_mesh_generation;
+                    this->m_coefficients_changed = other.m_coefficients_changed;
+                    this->m_reuse_preconditioner = other.m_reuse_preconditioner;
+                    this->m_matrix_free          = other.m_matrix_free;
+                    this->m_csr_assembly         = other.m_csr_assembly;
                     other.m_ksp       = nullptr; // Prevent KSP destruction when 'other' object is destroyed
                     other.m_A         = nullptr;
                     other.m_is_set_up = false;
@@ -98,10 +114,62 @@ namespace samurai
                 return m_assembly;
             }
 
+            /**
+             * @brief Declares that the coefficients of the scheme have changed (e.g. new time step) but not its stencil.
+             * At the next solve, the coefficients are re-inserted into the existing matrix, whose nonzero structure
+             * is kept as long as the mesh has not been adapted.
+             */
+            void update_coefficients()
+            {
+                m_coefficients_changed = true;
+            }
+
+            /**
+             * @brief If true, the preconditioner is not rebuilt when only the coefficients of the matrix change.
+             */
+            void reuse_preconditioner(bool reuse)
+            {
+                m_reuse_preconditioner = reuse;
+            }
+
+            /**
+             * @brief If true, the matrix is not assembled: its products with vectors are computed on the fly
+             * (see MatrixFreeOperator). The preconditioner defaults to Jacobi. Must be set before the setup.
+             */
+            void set_matrix_free(bool matrix_free)
+            {
+                if (m_matrix_free != matrix_free)
+                {
+                    m_matrix_free = matrix_free;
+                    m_is_set_up   = false;
+                    if (m_A)
+                    {
+                        MatDestroy(&m_A);
+                        KSPReset(m_ksp);
+                    }
+                }
+            }
+
+            bool is_matrix_free() const
+            {
+                return m_matrix_free;
+            }
+
+            /**
+             * @brief If true, the matrix is built from CSR arrays (see MatrixAssembly::create_csr_matrix()).
+             * Otherwise (default), it is preallocated then filled entry by entry.
+             * See benchmark/benchmark_petsc_assembly.cpp to compare both on a given mesh.
+             */
+            void set_csr_assembly(bool csr_assembly)
+            {
+                m_csr_assembly = csr_assembly;
+            }
+
           private:
 
             void configure_default_solver()
             {
+                register_samurai_gmg();
                 KSPCreate(PETSC_COMM_SELF, &m_ksp);
                 KSPSetFromOptions(m_ksp);
             }
@@ -113,11 +181,90 @@ namespace samurai
                 configure_default_solver();
             }
 
+            bool must_assemble()
+            {
+                return !is_set_up() || m_coefficients_changed || m_mesh_generation != assembly().mesh_generation();
+            }
+
+            /**
+             * @brief Creates and assembles the matrix if the mesh has changed since its creation.
+             * Otherwise, only re-inserts the coefficients into the existing matrix.
+             * @return true if the matrix has been created.
+             */
+            bool assemble_operator()
+            {
+                LogStage stage("samurai: assembly");
+                bool same_mesh = m_A && m_mesh_generation == assembly().mesh_generation();
+                if (same_mesh)
+                {
+                    if (m_matrix_free)
+                    {
+                        // The coefficients are computed at each product: only notify the preconditioner
+                        PetscObjectStateIncrease(reinterpret_cast<PetscObject>(m_A));
+                    }
+                    else if (m_csr_assembly)
+                    {
+                        assembly().reassemble_csr_matrix(m_A);
+                    }
+                    else
+                    {
+                        assembly().reassemble_matrix(m_A);
+                    }
+                }
+                else
+                {
+                    if (m_A)
+                    {
+                        MatDestroy(&m_A);
+                        KSPReset(m_ksp); // the sizes of the operators may change
+                    }
+                    if (m_matrix_free)
+                    {
+                        create_matrix_free_operator();
+                    }
+                    else if (m_csr_assembly)
+                    {
+                        assembly().create_csr_matrix(m_A);
+                    }
+                    else
+                    {
+                        assembly().create_matrix(m_A);
+                        assembly().assemble_matrix(m_A);
+                    }
+                    PetscObjectSetName(reinterpret_cast<PetscObject>(m_A), "A");
+                    m_mesh_generation = assembly().mesh_generation();
+                }
+                m_coefficients_changed = false;
+                KSPSetReusePreconditioner(m_ksp, same_mesh && m_reuse_preconditioner ? PETSC_TRUE : PETSC_FALSE);
+                return !same_mesh;
+            }
+
+          private:
+
+            void create_matrix_free_operator()
+            {
+                if constexpr (std::is_base_of_v<MatrixAssembly, Assembly>)
+                {
+                    create_matrix_free(assembly(), m_A);
+
+                    PC pc;
+                    KSPGetPC(m_ksp, &pc);
+                    PCSetType(pc, PCJACOBI);
+                    KSPSetFromOptions(m_ksp); // the user can still choose another preconditioner
+                }
+                else
+                {
+                    std::cerr << "The matrix-free mode is not available for nested block matrices." << std::endl;
+                    assert(false && "Matrix-free nested block matrix");
+                    exit(EXIT_FAILURE);
+                }
+            }
+
           public:
 
             virtual void setup()
             {
-                if (is_set_up())
+                if (is_set_up() && !must_assemble())
                 {
                     return;
                 }
@@ -130,15 +277,17 @@ namespace samurai
                     exit(EXIT_FAILURE);
                 }
 
-                assembly().create_matrix(m_A);
-                assembly().assemble_matrix(m_A);
-                PetscObjectSetName(reinterpret_cast<PetscObject>(m_A), "A");
+                assemble_operator();
 
                 // PetscBool is_symmetric;
                 // MatIsSymmetric(m_A, 0, &is_symmetric);
 
                 KSPSetOperators(m_ksp, m_A, m_A);
-                PetscInt err = KSPSetUp(m_ksp);
+                PetscInt err;
+                {
+                    LogStage stage("samurai: solver setup");
+                    err = KSPSetUp(m_ksp);
+                }
                 if (err != 0)
                 {
                     std::cerr << "The setup of the solver failed!" << std::endl;
@@ -152,6 +301,7 @@ namespace samurai
 
             void prepare_rhs_and_solve(Vec& b, Vec& x)
             {
+                LogStage stage("samurai: solve");
                 // Update the right-hand side with the boundary conditions stored in the solution field
                 assembly().enforce_bc(b);
                 // Set to zero the right-hand side of the ghost equations
@@ -188,6 +338,11 @@ namespace samurai
 
           public:
 
+            KSP& Krylov_solver()
+            {
+                return m_ksp;
+            }
+
             int iterations()
             {
                 PetscInt n_iterations;
@@ -211,17 +366,20 @@ namespace samurai
             using Field      = typename scheme_t::field_t;
             using Mesh       = typename Field::mesh_t;
 
+            using base_class::assemble_operator;
             using base_class::assembly;
             using base_class::m_A;
+            using base_class::m_coefficients_changed;
             using base_class::m_is_set_up;
             using base_class::m_ksp;
+            using base_class::m_mesh_generation;
+            using base_class::m_reuse_preconditioner;
+            using base_class::must_assemble;
 
           private:
 
             bool m_use_samurai_mg = false;
-#ifdef ENABLE_MG
-            GeometricMultigrid<Assembly> _samurai_mg;
-#endif
+            GeometricMultigrid<Assembly> m_samurai_mg;
 
           public:
 
@@ -231,50 +389,64 @@ namespace samurai
                 configure_solver();
             }
 
-#ifdef ENABLE_MG
             void destroy_petsc_objects() override
             {
                 base_class::destroy_petsc_objects();
-                _samurai_mg.destroy_petsc_objects();
+                m_samurai_mg.destroy_petsc_objects(); // after the KSP, which uses the hierarchy
             }
-#endif
 
           protected:
 
             void configure_solver() override
             {
-                KSP user_ksp;
-                KSPCreate(PETSC_COMM_SELF, &user_ksp);
-                KSPSetFromOptions(user_ksp);
-                PC user_pc;
-                KSPGetPC(user_ksp, &user_pc);
-                PCType user_pc_type;
-                PCGetType(user_pc, &user_pc_type);
-#ifdef ENABLE_MG
-                m_use_samurai_mg = strcmp(user_pc_type, PCMG) == 0;
-#endif
-                KSPDestroy(&user_ksp);
-
+                register_samurai_gmg();
                 KSPCreate(PETSC_COMM_SELF, &m_ksp);
                 KSPSetFromOptions(m_ksp);
-#ifdef ENABLE_MG
+
+                // The samurai multigrid is selected by '-pc_type samurai_gmg': a plain '-pc_type mg' is left to PETSc
+                m_use_samurai_mg = is_samurai_gmg(m_ksp);
                 if (m_use_samurai_mg)
                 {
-                    if constexpr (Mesh::dim > 2)
+                    if constexpr (Mesh::dim > 2 || Field::size > 1)
                     {
-                        std::cerr << "Samurai Multigrid is not implemented for "
-                                     "dim > 2."
-                                  << std::endl;
+                        std::cerr << "Samurai Multigrid is only implemented for scalar fields in dim <= 2." << std::endl;
                         assert(false);
                         exit(EXIT_FAILURE);
                     }
-                    _samurai_mg = GeometricMultigrid(assembly(), assembly().mesh());
-                    _samurai_mg.apply_as_pc(m_ksp);
                 }
-#endif
                 m_is_set_up = false;
             }
 
+            /**
+             * @brief Builds the multigrid hierarchy if the mesh has changed since the last setup.
+             * Otherwise, the hierarchy is kept and only the coefficients of its matrices are updated.
+             */
+            void setup_samurai_mg()
+            {
+                if (m_samurai_mg.is_built_on(assembly()))
+                {
+                    if (m_coefficients_changed)
+                    {
+                        m_samurai_mg.update_operators(m_ksp);
+                    }
+                    KSPSetReusePreconditioner(m_ksp, m_reuse_preconditioner ? PETSC_TRUE : PETSC_FALSE);
+                }
+                else
+                {
+                    if (m_samurai_mg.is_built())
+                    {
+                        // The levels of PCMG depend on the mesh: start again from a new KSP
+                        KSPDestroy(&m_ksp);
+                        m_samurai_mg.destroy_petsc_objects();
+                        KSPCreate(PETSC_COMM_SELF, &m_ksp);
+                        KSPSetFromOptions(m_ksp);
+                    }
+                    m_samurai_mg.apply_as_pc(m_ksp, assembly());
+                }
+                m_mesh_generation      = assembly().mesh_generation();
+                m_coefficients_changed = false;
+            }
+
           public:
 
             void set_unknown(Field& unknown)
@@ -284,7 +456,7 @@ namespace samurai
 
             void setup() override
             {
-                if (m_is_set_up)
+                if (m_is_set_up && !must_assemble())
                 {
                     return;
                 }
@@ -295,27 +467,29 @@ namespace samurai
                     assert(false && "Undefined unknown");
                     exit(EXIT_FAILURE);
                 }
-                if (!m_use_samurai_mg)
+                if (m_use_samurai_mg)
+                {
+                    setup_samurai_mg();
+                }
+                else
                 {
-                    assembly().create_matrix(m_A);
-                    assembly().assemble_matrix(m_A);
-                    PetscObjectSetName(reinterpret_cast<PetscObject>(m_A), "A");
+                    assemble_operator();
 
                     // PetscBool is_symmetric;
                     // MatIsSymmetric(m_A, 0, &is_symmetric);
 
                     KSPSetOperators(m_ksp, m_A, m_A);
                 }
-                KSPSetUp(m_ksp);
+                {
+                    LogStage stage("samurai: solver setup");
+                    KSPSetUp(m_ksp);
+                }
                 m_is_set_up = true;
             }
 
             void solve(const Field& rhs)
             {
-                if (!m_is_set_up)
-                {
-                    setup();
-                }
+                setup();
                 Vec b = create_petsc_vector_from(rhs);
                 PetscObjectSetName(reinterpret_cast<PetscObject>(b), "b");
                 Vec x = create_petsc_vector_from(assembly().unknown());
@@ -348,10 +522,12 @@ namespace samurai
         {
             using assembly_t = NestedBlockAssembly<rows_, cols_, Operators...>;
             using base_class = SolverBase<assembly_t>;
+            using base_class::assemble_operator;
             using base_class::assembly;
             using base_class::m_A;
             using base_class::m_is_set_up;
             using base_class::m_ksp;
+            using base_class::must_assemble;
 
             using block_operator_t            = typename assembly_t::scheme_t;
             static constexpr std::size_t rows = assembly_t::rows;
@@ -396,7 +572,7 @@ namespace samurai
 
             void setup() override
             {
-                if (m_is_set_up)
+                if (m_is_set_up && !must_assemble())
                 {
                     return;
                 }
@@ -410,25 +586,29 @@ namespace samurai
                 }
 
                 // assembly().reset();
-                assembly().create_matrix(m_A);
-                assembly().assemble_matrix(m_A);
-                PetscObjectSetName(reinterpret_cast<PetscObject>(m_A), "A");
+                bool created = assemble_operator();
                 // MatView(m_A, PETSC_VIEWER_STDOUT_(PETSC_COMM_SELF)); std::cout << std::endl;
                 KSPSetOperators(m_ksp, m_A, m_A);
 
-                // Set names to the petsc fields
                 PC pc;
                 KSPGetPC(m_ksp, &pc);
-                IS is_fields[cols];
-                MatNestGetISs(m_A, is_fields, NULL);
-                auto field_names = assembly().field_names();
-                for (std::size_t i = 0; i < cols; ++i)
+                if (created)
                 {
-                    PCFieldSplitSetIS(pc, field_names[i].c_str(), is_fields[i]);
-                }
+                    // Set names to the petsc fields
+                    IS is_fields[cols];
+                    MatNestGetISs(m_A, is_fields, NULL);
+                    auto field_names = assembly().field_names();
+                    for (std::size_t i = 0; i < cols; ++i)
+                    {
+                        PCFieldSplitSetIS(pc, field_names[i].c_str(), is_fields[i]);
+                    }
 
-                KSPSetFromOptions(m_ksp);
-                PCSetUp(pc);
+                    KSPSetFromOptions(m_ksp);
+                }
+                {
+                    LogStage stage("samurai: solver setup");
+                    PCSetUp(pc);
+                }
                 // KSPSetUp(m_ksp); // Here, PETSc fails for some reason.
 
                 m_is_set_up = true;
@@ -442,10 +622,7 @@ namespace samurai
                 //                   "The number of source fields passed to solve() must equal "
                 //                   "the number of rows of the block operator.");
 
-                if (!m_is_set_up)
-                {
-                    setup();
-                }
+                setup();
                 Vec b = assembly().create_rhs_vector(rhs_tuple);
                 Vec x = assembly().create_solution_vector();
                 this->prepare_rhs_and_solve(b, x);
@@ -507,10 +684,7 @@ namespace samurai
                 //                   "The number of source fields passed to solve() must equal "
                 //                   "the number of rows of the block operator.");
 
-                if (!m_is_set_up)
-                {
-                    this->setup();
-                }
+                this->setup();
 
                 Vec b = assembly().create_rhs_vector(rhs_tuple);
                 Vec x = assembly().create_solution_vector();
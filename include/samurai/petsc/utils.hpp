@@ -1,33 +1,49 @@
 #pragma once
+#include <algorithm>
+#include <array>
 #include <petsc.h>
+#include <string>
 
 namespace samurai
 {
     namespace petsc
     {
+        /**
+         * @brief Creates a PETSc vector sharing the storage of the field (no copy).
+         * The layout of the field (scalar, AOS or SOA) is the one used by the matrix assembly.
+         * For AOS fields, the block size of the vector is the number of components.
+         */
         template <class Field>
         Vec create_petsc_vector_from(Field& f)
         {
             Vec v;
-            auto n = static_cast<PetscInt>(f.mesh().nb_cells() * Field::size);
-            VecCreateSeqWithArray(MPI_COMM_SELF, 1, n, f.array().data(), &v);
+            auto n      = static_cast<PetscInt>(f.mesh().nb_cells() * Field::size);
+            PetscInt bs = Field::is_soa ? 1 : static_cast<PetscInt>(Field::size);
+            VecCreateSeqWithArray(MPI_COMM_SELF, bs, n, f.array().data(), &v);
             return v;
         }
 
-        template <class Field>
-        void copy(Field& f, Vec& v)
+        /**
+         * @brief Creates a nested PETSc vector whose blocks share the storage of the fields (no copy).
+         */
+        template <class... Fields>
+        Vec create_nested_petsc_vector_from(const std::string& name, Fields&... fields)
         {
-            auto n = static_cast<PetscInt>(f.mesh().nb_cells() * Field::size);
-
-            PetscInt n_vec;
-            VecGetSize(v, &n_vec);
-            assert(n == n_vec);
-
-            for (PetscInt i = 0; i < n; ++i)
+            constexpr std::size_t n_blocks = sizeof...(Fields);
+            std::array<Vec, n_blocks> blocks{create_petsc_vector_from(fields)...};
+            std::array<std::string, n_blocks> names{fields.name()...};
+            for (std::size_t i = 0; i < n_blocks; ++i)
+            {
+                PetscObjectSetName(reinterpret_cast<PetscObject>(blocks[i]), names[i].c_str());
+            }
+            Vec v;
+            VecCreateNest(PETSC_COMM_SELF, static_cast<PetscInt>(n_blocks), NULL, blocks.data(), &v);
+            for (auto& block : blocks)
             {
-                double value = f.array().data()[i];
-                VecSetValues(v, 1, &i, &value, INSERT_VALUES);
+                VecDestroy(&block); // the nested vector holds its own reference
             }
+            PetscObjectSetName(reinterpret_cast<PetscObject>(v), name.c_str());
+            return v;
         }
 
         template <class Field>
@@ -39,53 +55,39 @@ namespace samurai
             VecGetSize(v, &n_vec);
             assert(shift + n <= n_vec);
 
-            for (PetscInt i = 0; i < n; ++i)
-            {
-                double value = f.array().data()[i];
-                VecSetValue(v, shift + i, value, INSERT_VALUES);
-            }
+            double* arr;
+            VecGetArray(v, &arr);
+            std::copy(f.array().data(), f.array().data() + n, arr + shift);
+            VecRestoreArray(v, &arr);
         }
 
         template <class Field>
-        void copy(Vec& v, Field& f)
+        void copy(Field& f, Vec& v)
         {
-            std::size_t n = f.mesh().nb_cells() * Field::size;
-
-            PetscInt n_vec;
-            VecGetSize(v, &n_vec);
-            assert(static_cast<PetscInt>(n) == n_vec);
-
-            const double* arr;
-            VecGetArrayRead(v, &arr);
-
-            for (std::size_t i = 0; i < n; ++i)
-            {
-                f.array().data()[i] = arr[i];
-            }
-
-            VecRestoreArrayRead(v, &arr);
+            copy(f, v, 0);
         }
 
         template <class Field>
         void copy(PetscInt shift, Vec& v, Field& f)
         {
-            std::size_t n = f.mesh().nb_cells() * Field::size;
+            auto n = static_cast<PetscInt>(f.mesh().nb_cells() * Field::size);
 
             PetscInt n_vec;
             VecGetSize(v, &n_vec);
-            assert(shift + static_cast<PetscInt>(n) <= n_vec);
+            assert(shift + n <= n_vec);
 
             const double* arr;
             VecGetArrayRead(v, &arr);
-
-            for (std::size_t i = 0; i < n; ++i)
-            {
-                f.array().data()[i] = arr[static_cast<std::size_t>(shift) + i];
-            }
-
+            std::copy(arr + shift, arr + shift + n, f.array().data());
             VecRestoreArrayRead(v, &arr);
         }
 
+        template <class Field>
+        void copy(Vec& v, Field& f)
+        {
+            copy(0, v, f);
+        }
+
         bool check_nan_or_inf(const Vec& v)
         {
             PetscInt n;
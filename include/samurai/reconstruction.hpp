@@ -2,12 +2,20 @@
 
 #include "field.hpp"
 #include "numeric/prediction.hpp"
+#include "parallel.hpp"
 #include "samurai_config.hpp"
 #include "subset/subset_op.hpp"
+#include <algorithm>
 #include <array>
 #include <fmt/format.h>
 #include <fmt/ranges.h>
+#include <limits>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <tuple>
+#include <vector>
+#include <xtensor/xadapt.hpp>
 
 namespace samurai
 {
@@ -154,131 +162,197 @@ namespace samurai
         return out;
     }
 
-    template <std::size_t order = 1, class index_t = default_config::value_t>
-    auto prediction(std::size_t level, index_t i) -> prediction_map<1, index_t>
+    /**
+     * Prediction coefficients of a given order from a coarse cell to its descendants delta_l levels below, in 1D.
+     * The value of the fine cell ii (0 <= ii < 2^delta_l) is the sum over s < size(ii) of
+     * weights(ii)[s] * coarse_value(coarse_cell + offsets(ii)[s]).
+     * In 2D and 3D, the prediction operator is the tensor product of the 1D ones.
+     *
+     * The coefficients are stored in flat arrays, built once per (order, delta_l) by get_prediction_table()
+     * and never modified afterwards, so that they can be read concurrently.
+     */
+    template <std::size_t order, class index_t = default_config::value_t>
+    class prediction_table
     {
-        static std::map<std::tuple<std::size_t, std::size_t, index_t>, prediction_map<1, index_t>> values;
+      public:
+
+        explicit prediction_table(std::size_t delta_l);
+
+        std::size_t delta_level() const
+        {
+            return m_delta_l;
+        }
 
-        if (level == 0)
+        std::size_t size(std::size_t ii) const
         {
-            return prediction_map<1, index_t>{{i}};
+            return m_start[ii + 1] - m_start[ii];
         }
 
-        auto iter = values.find({order, level, i});
+        const index_t* offsets(std::size_t ii) const
+        {
+            return m_offsets.data() + m_start[ii];
+        }
 
-        if (iter == values.end())
+        const double* weights(std::size_t ii) const
         {
-            int ig      = i >> 1;
-            double sign = (i & 1) ? -1. : 1.;
+            return m_weights.data() + m_start[ii];
+        }
 
-            values[{order, level, i}] = prediction<order, index_t>(level - 1, ig);
+      private:
 
+        std::size_t m_delta_l;
+        std::vector<std::size_t> m_start;
+        std::vector<index_t> m_offsets;
+        std::vector<double> m_weights;
+    };
+
+    /**
+     * @brief Returns the prediction table of the given order for the level difference delta_l (thread-safe).
+     */
+    template <std::size_t order, class index_t = default_config::value_t>
+    const prediction_table<order, index_t>& get_prediction_table(std::size_t delta_l)
+    {
+        static constexpr std::size_t n_tables = default_config::max_level + 1;
+        static std::array<std::once_flag, n_tables> built;
+        static std::array<std::unique_ptr<const prediction_table<order, index_t>>, n_tables> tables;
+
+        assert(delta_l < n_tables);
+        std::call_once(built[delta_l],
+                       [&]()
+                       {
+                           tables[delta_l] = std::make_unique<const prediction_table<order, index_t>>(delta_l);
+                       });
+        return *tables[delta_l];
+    }
+
+    template <std::size_t order, class index_t>
+    prediction_table<order, index_t>::prediction_table(std::size_t delta_l)
+        : m_delta_l(delta_l)
+    {
+        auto n_fine_cells = std::size_t{1} << delta_l;
+        m_start.reserve(n_fine_cells + 1);
+        m_start.push_back(0);
+        if (delta_l == 0)
+        {
+            m_offsets.push_back(0);
+            m_weights.push_back(1.);
+            m_start.push_back(1);
+            return;
+        }
+
+        // The fine cell ii is predicted from the cells around its parent ig at level delta_l - 1,
+        // which are themselves predicted from the coarse cell (translated by m >> (delta_l - 1) for the cell m).
+        const auto& parent_table = get_prediction_table<order, index_t>(delta_l - 1);
+        auto parent_shift        = static_cast<index_t>(delta_l - 1);
+
+        std::map<index_t, double> coeffs;
+        auto add_parent_stencil = [&](index_t m, double weight)
+        {
+            auto translation = m >> parent_shift;
+            auto m_in_cell   = static_cast<std::size_t>(m - (translation << parent_shift));
+            for (std::size_t s = 0; s < parent_table.size(m_in_cell); ++s)
+            {
+                coeffs[translation + parent_table.offsets(m_in_cell)[s]] += weight * parent_table.weights(m_in_cell)[s];
+            }
+        };
+
+        for (std::size_t ii = 0; ii < n_fine_cells; ++ii)
+        {
+            auto ig     = static_cast<index_t>(ii >> 1);
+            double sign = (ii & 1) ? -1. : 1.;
             auto interp = interp_coeffs<2 * order + 1>(sign);
+
+            coeffs.clear();
+            add_parent_stencil(ig, 1.);
             for (std::size_t ci = 0; ci < interp.size(); ++ci)
             {
                 if (ci != order)
                 {
-                    values[{order, level, i}] += interp[ci] * prediction<order, index_t>(level - 1, ig + static_cast<index_t>(ci - order));
+                    add_parent_stencil(ig + static_cast<index_t>(ci) - static_cast<index_t>(order), interp[ci]);
+                }
+            }
+            for (const auto& [offset, weight] : coeffs)
+            {
+                if (weight != 0)
+                {
+                    m_offsets.push_back(offset);
+                    m_weights.push_back(weight);
                 }
             }
-            return values[{order, level, i}];
+            m_start.push_back(m_offsets.size());
         }
-        return iter->second;
     }
 
-    template <std::size_t order = 1, class index_t = default_config::value_t>
-    auto prediction(std::size_t level, index_t i, index_t j) -> prediction_map<2, index_t>
+    namespace detail
     {
-        static std::map<std::tuple<std::size_t, std::size_t, index_t, index_t>, prediction_map<2, index_t>> values;
-
-        if (level == 0)
+        /**
+         * @brief Splits the fine index i at level delta_l into the fine cell in its coarse ancestor and the index of that ancestor.
+         */
+        template <class index_t>
+        inline std::pair<std::size_t, index_t> split_fine_index(std::size_t delta_l, index_t i)
         {
-            return prediction_map<2, index_t>{
-                {i, j}
-            };
+            auto shift  = static_cast<index_t>(delta_l);
+            auto coarse = i >> shift;
+            return {static_cast<std::size_t>(i - (coarse << shift)), coarse};
         }
+    }
 
-        auto iter = values.find({order, level, i, j});
+    template <std::size_t order = 1, class index_t = default_config::value_t>
+    auto prediction(std::size_t level, index_t i) -> prediction_map<1, index_t>
+    {
+        const auto& table   = get_prediction_table<order, index_t>(level);
+        auto [ii, i_coarse] = detail::split_fine_index(level, i);
 
-        if (iter == values.end())
+        prediction_map<1, index_t> result;
+        for (std::size_t s = 0; s < table.size(ii); ++s)
         {
-            int ig       = i >> 1;
-            int jg       = j >> 1;
-            double isign = (i & 1) ? -1. : 1.;
-            double jsign = (j & 1) ? -1. : 1.;
-
-            values[{order, level, i, j}] = prediction<order, index_t>(level - 1, ig, jg);
+            result.coeff[{i_coarse + table.offsets(ii)[s]}] = table.weights(ii)[s];
+        }
+        return result;
+    }
 
-            auto interpx = interp_coeffs<2 * order + 1>(isign);
-            auto interpy = interp_coeffs<2 * order + 1>(jsign);
+    template <std::size_t order = 1, class index_t = default_config::value_t>
+    auto prediction(std::size_t level, index_t i, index_t j) -> prediction_map<2, index_t>
+    {
+        const auto& table   = get_prediction_table<order, index_t>(level);
+        auto [ii, i_coarse] = detail::split_fine_index(level, i);
+        auto [jj, j_coarse] = detail::split_fine_index(level, j);
 
-            for (std::size_t ci = 0; ci < interpx.size(); ++ci)
+        prediction_map<2, index_t> result;
+        for (std::size_t sj = 0; sj < table.size(jj); ++sj)
+        {
+            for (std::size_t si = 0; si < table.size(ii); ++si)
             {
-                for (std::size_t cj = 0; cj < interpy.size(); ++cj)
-                {
-                    if (ci != order || cj != order)
-                    {
-                        values[{order, level, i, j}] += interpx[ci] * interpy[cj]
-                                                      * prediction<order, index_t>(level - 1,
-                                                                                   ig + static_cast<index_t>(ci - order),
-                                                                                   jg + static_cast<index_t>(cj - order));
-                    }
-                }
+                typename prediction_map<2, index_t>::key_t key{i_coarse + table.offsets(ii)[si], j_coarse + table.offsets(jj)[sj]};
+                result.coeff[key] = table.weights(ii)[si] * table.weights(jj)[sj];
             }
-            return values[{order, level, i, j}];
         }
-        return iter->second;
+        return result;
     }
 
     template <std::size_t order = 1, class index_t = default_config::value_t>
     auto prediction(std::size_t level, index_t i, index_t j, index_t k) -> prediction_map<3, index_t>
     {
-        static std::map<std::tuple<std::size_t, std::size_t, index_t, index_t, index_t>, prediction_map<3, index_t>> values;
-
-        if (level == 0)
-        {
-            return prediction_map<3, index_t>{
-                {i, j, k}
-            };
-        }
+        const auto& table   = get_prediction_table<order, index_t>(level);
+        auto [ii, i_coarse] = detail::split_fine_index(level, i);
+        auto [jj, j_coarse] = detail::split_fine_index(level, j);
+        auto [kk, k_coarse] = detail::split_fine_index(level, k);
 
-        auto iter = values.find({order, level, i, j, k});
-
-        if (iter == values.end())
+        prediction_map<3, index_t> result;
+        for (std::size_t sk = 0; sk < table.size(kk); ++sk)
         {
-            int ig       = i >> 1;
-            int jg       = j >> 1;
-            int kg       = k >> 1;
-            double isign = (i & 1) ? -1. : 1.;
-            double jsign = (j & 1) ? -1. : 1.;
-            double ksign = (k & 1) ? -1. : 1.;
-
-            values[{order, level, i, j, k}] = prediction<order, index_t>(level - 1, ig, jg, kg);
-
-            auto interpx = interp_coeffs<2 * order + 1>(isign);
-            auto interpy = interp_coeffs<2 * order + 1>(jsign);
-            auto interpz = interp_coeffs<2 * order + 1>(ksign);
-
-            for (std::size_t ci = 0; ci < interpx.size(); ++ci)
+            for (std::size_t sj = 0; sj < table.size(jj); ++sj)
             {
-                for (std::size_t cj = 0; cj < interpy.size(); ++cj)
+                for (std::size_t si = 0; si < table.size(ii); ++si)
                 {
-                    for (std::size_t ck = 0; ck < interpz.size(); ++ck)
-                    {
-                        if (ci != order || cj != order || ck != order)
-                        {
-                            values[{order, level, i, j, k}] += interpx[ci] * interpy[cj] * interpz[ck]
-                                                             * prediction<order, index_t>(level - 1,
-                                                                                          ig + static_cast<index_t>(ci - order),
-                                                                                          jg + static_cast<index_t>(cj - order),
-                                                                                          kg + static_cast<index_t>(ck - order));
-                        }
-                    }
+                    typename prediction_map<3, index_t>::key_t key{i_coarse + table.offsets(ii)[si],
+                                                                   j_coarse + table.offsets(jj)[sj],
+                                                                   k_coarse + table.offsets(kk)[sk]};
+                    result.coeff[key] = table.weights(ii)[si] * table.weights(jj)[sj] * table.weights(kk)[sk];
                 }
             }
-            return values[{order, level, i, j, k}];
         }
-        return iter->second;
+        return result;
     }
 
     template <class TInterval>
@@ -301,15 +375,17 @@ namespace samurai
             }
             else
             {
-                index_t nb_cells = 1 << delta_l;
+                const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+                index_t nb_cells  = 1 << delta_l;
                 for (index_t ii = 0; ii < nb_cells; ++ii)
                 {
-                    auto pred = prediction<prediction_order, index_t>(delta_l, ii);
-                    for (const auto& kv : pred.coeff)
+                    auto i_f = (i << delta_l) + ii;
+                    i_f.step = nb_cells;
+
+                    auto si           = static_cast<std::size_t>(ii);
+                    for (std::size_t s = 0; s < table.size(si); ++s)
                     {
-                        auto i_f = (i << delta_l) + ii;
-                        i_f.step = nb_cells;
-                        dest(reconstruct_level, i_f) += kv.second * src(level, i + kv.first[0]);
+                        dest(reconstruct_level, i_f) += table.weights(si)[s] * src(level, i + table.offsets(si)[s]);
                     }
                 }
             }
@@ -328,19 +404,25 @@ namespace samurai
             }
             else
             {
-                index_t nb_cells = 1 << delta_l;
+                const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+                index_t nb_cells  = 1 << delta_l;
                 for (index_t jj = 0; jj < nb_cells; ++jj)
                 {
                     auto j_f = (j << delta_l) + jj;
+                    auto sj  = static_cast<std::size_t>(jj);
                     for (index_t ii = 0; ii < nb_cells; ++ii)
                     {
-                        auto pred = prediction<prediction_order, index_t>(delta_l, ii, jj);
-                        auto i_f  = (i << delta_l) + ii;
-                        i_f.step  = nb_cells;
+                        auto i_f = (i << delta_l) + ii;
+                        i_f.step = nb_cells;
+                        auto si  = static_cast<std::size_t>(ii);
 
-                        for (const auto& kv : pred.coeff)
+                        for (std::size_t t = 0; t < table.size(sj); ++t)
                         {
-                            dest(reconstruct_level, i_f, j_f) += kv.second * src(level, i + kv.first[0], j + kv.first[1]);
+                            for (std::size_t s = 0; s < table.size(si); ++s)
+                            {
+                                dest(reconstruct_level, i_f, j_f) += table.weights(si)[s] * table.weights(sj)[t]
+                                                                   * src(level, i + table.offsets(si)[s], j + table.offsets(sj)[t]);
+                            }
                         }
                     }
                 }
@@ -360,23 +442,36 @@ namespace samurai
             }
             else
             {
-                index_t nb_cells = 1 << delta_l;
+                const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+                index_t nb_cells  = 1 << delta_l;
                 for (index_t kk = 0; kk < nb_cells; ++kk)
                 {
                     auto k_f = (k << delta_l) + kk;
+                    auto sk  = static_cast<std::size_t>(kk);
                     for (index_t jj = 0; jj < nb_cells; ++jj)
                     {
                         auto j_f = (j << delta_l) + jj;
+                        auto sj  = static_cast<std::size_t>(jj);
                         for (index_t ii = 0; ii < nb_cells; ++ii)
                         {
-                            auto pred = prediction<prediction_order, index_t>(delta_l, ii, jj, kk);
-                            auto i_f  = (i << delta_l) + ii;
-                            i_f.step  = nb_cells;
+                            auto i_f = (i << delta_l) + ii;
+                            i_f.step = nb_cells;
+                            auto si  = static_cast<std::size_t>(ii);
 
-                            for (const auto& kv : pred.coeff)
+                            for (std::size_t u = 0; u < table.size(sk); ++u)
                             {
-                                dest(reconstruct_level, i_f, j_f, k_f) += kv.second
-                                                                        * src(level, i + kv.first[0], j + kv.first[1], k + kv.first[2]);
+                                for (std::size_t t = 0; t < table.size(sj); ++t)
+                                {
+                                    for (std::size_t s = 0; s < table.size(si); ++s)
+                                    {
+                                        auto weight = table.weights(si)[s] * table.weights(sj)[t] * table.weights(sk)[u];
+                                        dest(reconstruct_level, i_f, j_f, k_f) += weight
+                                                                                * src(level,
+                                                                                      i + table.offsets(si)[s],
+                                                                                      j + table.offsets(sj)[t],
+                                                                                      k + table.offsets(sk)[u]);
+                                    }
+                                }
                             }
                         }
                     }
@@ -421,6 +516,199 @@ namespace samurai
         return reconstruct_field;
     }
 
+    namespace detail
+    {
+        /**
+         * Values of the row of cells (fine_level, fine_i, fine_index) predicted from the leaf row (level, i, index) which contains it.
+         * The values are written in buffer with the layout of the field (scalar, AOS or SOA), and returned as an xtensor adaptor.
+         */
+        template <class Field, class interval_t, class coord_t, class fine_coord_t>
+        auto reconstruct_fine_row(const Field& field,
+                                  std::size_t level,
+                                  const interval_t& i,
+                                  const coord_t& index,
+                                  std::size_t fine_level,
+                                  const fine_coord_t& fine_index,
+                                  std::vector<typename Field::value_type>& buffer)
+        {
+            using value_t                          = typename interval_t::value_t;
+            constexpr std::size_t dim              = Field::dim;
+            constexpr std::size_t size             = Field::size;
+            constexpr std::size_t prediction_order = Field::mesh_t::config::prediction_order;
+
+            std::size_t delta_l = fine_level - level;
+            const auto& table   = get_prediction_table<prediction_order, value_t>(delta_l);
+            auto nb_cells       = static_cast<std::size_t>(1) << delta_l;
+            auto n_coarse       = static_cast<std::size_t>(i.end - i.start);
+            auto n_fine         = n_coarse << delta_l;
+            buffer.assign(n_fine * size, 0);
+
+            auto buffer_at = [&](std::size_t x, std::size_t c) -> typename Field::value_type&
+            {
+                if constexpr (Field::is_soa)
+                {
+                    return buffer[c * n_fine + x];
+                }
+                else
+                {
+                    return buffer[x * size + c];
+                }
+            };
+
+            // Position of the row in the descendants of its leaf in the other directions
+            std::array<std::size_t, 2> sjk{0, 0};
+            std::array<std::size_t, 2> n_jk{1, 1};
+            for (std::size_t d = 0; d < dim - 1; ++d)
+            {
+                sjk[d]  = static_cast<std::size_t>(fine_index[d] - (index[d] << delta_l));
+                n_jk[d] = table.size(sjk[d]);
+            }
+
+            for (std::size_t ii = 0; ii < nb_cells; ++ii)
+            {
+                const auto* offsets_i = table.offsets(ii);
+                const auto* weights_i = table.weights(ii);
+                auto [min_off, max_off] = std::minmax_element(offsets_i, offsets_i + table.size(ii));
+                interval_t source_i{i.start + *min_off, i.end + *max_off};
+
+                for (std::size_t u = 0; u < n_jk[1]; ++u)
+                {
+                    for (std::size_t t = 0; t < n_jk[0]; ++t)
+                    {
+                        double weight_jk = 1;
+                        std::array<value_t, dim - 1> source_index;
+                        for (std::size_t d = 0; d < dim - 1; ++d)
+                        {
+                            auto s          = d == 0 ? t : u;
+                            source_index[d] = index[d] + table.offsets(sjk[d])[s];
+                            weight_jk *= table.weights(sjk[d])[s];
+                        }
+                        auto row = std::apply(
+                            [&](auto... jk)
+                            {
+                                return make_field_row(field, level, source_i, jk...);
+                            },
+                            source_index);
+
+                        for (std::size_t s = 0; s < table.size(ii); ++s)
+                        {
+                            double weight = weight_jk * weights_i[s];
+                            auto shift    = static_cast<std::ptrdiff_t>(offsets_i[s] - *min_off);
+                            for (std::size_t c = 0; c < size; ++c)
+                            {
+                                for (std::size_t x = 0; x < n_coarse; ++x)
+                                {
+                                    buffer_at((x << delta_l) + ii, c) += weight * row(static_cast<std::ptrdiff_t>(x) + shift, c);
+                                }
+                            }
+                        }
+                    }
+                }
+            }
+
+            if constexpr (size == 1)
+            {
+                return xt::adapt(buffer.data(), n_fine, xt::no_ownership(), std::array<std::size_t, 1>{n_fine});
+            }
+            else if constexpr (Field::is_soa)
+            {
+                return xt::adapt(buffer.data(), n_fine * size, xt::no_ownership(), std::array<std::size_t, 2>{size, n_fine});
+            }
+            else
+            {
+                return xt::adapt(buffer.data(), n_fine * size, xt::no_ownership(), std::array<std::size_t, 2>{n_fine, size});
+            }
+        }
+    }
+
+    /**
+     * Streaming reconstruction of the field on the uniform mesh of the finest level, without allocating it.
+     * func(i, index, values) is called for each row of cells (i, index) of the finest level, where values are the
+     * reconstructed values of the row, with the same shape as field(level, i, index): the adaptor is only valid during the call.
+     * The rows are given slab by slab: by increasing index[dim - 2] (the last direction), and for each slab,
+     * by increasing level of the leaf they come from. The memory used is that of a single row.
+     */
+    template <class Field, class Func>
+    void reconstruction(const Field& field, Func&& func)
+    {
+        using mesh_id_t  = typename Field::mesh_t::mesh_id_t;
+        using interval_t = typename Field::interval_t;
+        using value_t    = typename interval_t::value_t;
+        using coord_t    = xt::xtensor_fixed<value_t, xt::xshape<Field::dim - 1>>;
+
+        constexpr std::size_t dim = Field::dim;
+
+        const auto& mesh       = field.mesh();
+        std::size_t fine_level = mesh.domain().level();
+        std::size_t min_level  = mesh[mesh_id_t::cells].min_level();
+        std::size_t max_level  = mesh[mesh_id_t::cells].max_level();
+
+        std::vector<typename Field::value_type> buffer;
+        coord_t fine_index;
+
+        if constexpr (dim == 1)
+        {
+            for_each_interval(mesh[mesh_id_t::cells],
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  auto delta_l = fine_level - level;
+                                  interval_t fine_i{i.start << delta_l, i.end << delta_l};
+                                  auto values = detail::reconstruct_fine_row(field, level, i, index, fine_level, fine_index, buffer);
+                                  func(fine_i, fine_index, values);
+                              });
+        }
+        else
+        {
+            // Leaf rows of each level, sorted by their last index, and bounds of the slabs at the finest level
+            std::vector<std::vector<std::pair<interval_t, coord_t>>> leaves(max_level + 1);
+            value_t first_slab = std::numeric_limits<value_t>::max();
+            value_t last_slab  = std::numeric_limits<value_t>::min();
+            for_each_interval(mesh[mesh_id_t::cells],
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  leaves[level].emplace_back(i, index);
+                                  auto delta_l = fine_level - level;
+                                  first_slab   = std::min(first_slab, index[dim - 2] << delta_l);
+                                  last_slab    = std::max(last_slab, ((index[dim - 2] + 1) << delta_l) - 1);
+                              });
+
+            std::vector<std::size_t> cursor(max_level + 1, 0);
+            for (value_t slab = first_slab; slab <= last_slab; ++slab)
+            {
+                fine_index[dim - 2] = slab;
+                for (std::size_t level = min_level; level <= max_level; ++level)
+                {
+                    auto delta_l     = fine_level - level;
+                    auto coarse_slab = slab >> delta_l;
+                    auto& rows       = leaves[level];
+                    auto& r          = cursor[level];
+                    while (r < rows.size() && rows[r].second[dim - 2] < coarse_slab)
+                    {
+                        ++r;
+                    }
+                    for (std::size_t q = r; q < rows.size() && rows[q].second[dim - 2] == coarse_slab; ++q)
+                    {
+                        const auto& [i, index] = rows[q];
+                        interval_t fine_i{i.start << delta_l, i.end << delta_l};
+                        if constexpr (dim == 2)
+                        {
+                            auto values = detail::reconstruct_fine_row(field, level, i, index, fine_level, fine_index, buffer);
+                            func(fine_i, fine_index, values);
+                        }
+                        else
+                        {
+                            for (fine_index[0] = index[0] << delta_l; fine_index[0] < ((index[0] + 1) << delta_l); ++fine_index[0])
+                            {
+                                auto values = detail::reconstruct_fine_row(field, level, i, index, fine_level, fine_index, buffer);
+                                func(fine_i, fine_index, values);
+                            }
+                        }
+                    }
+                }
+            }
+        }
+    }
+
     namespace detail
     {
         // 1D portion
@@ -428,14 +716,14 @@ namespace samurai
         auto
         portion_impl(const Field& f, std::size_t element, std::size_t level, const typename Field::interval_t& i, std::size_t delta_l, index_t ii)
         {
-            auto pred = prediction<prediction_order, index_t>(delta_l, ii);
+            const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+            auto si           = static_cast<std::size_t>(ii);
 
             auto result = xt::zeros_like(f(element, level, i));
 
-            for (const auto& kv : pred.coeff)
+            for (std::size_t s = 0; s < table.size(si); ++s)
             {
-                // cppcheck-suppress useStlAlgorithm
-                result += kv.second * f(element, level, i + kv.first[0]);
+                result += table.weights(si)[s] * f(element, level, i + table.offsets(si)[s]);
             }
             return result;
         }
@@ -443,14 +731,14 @@ namespace samurai
         template <std::size_t prediction_order, class Field, class index_t = typename Field::interval_t::value_t>
         auto portion_impl(const Field& f, std::size_t level, const typename Field::interval_t& i, std::size_t delta_l, index_t ii)
         {
-            auto pred = prediction<prediction_order, index_t>(delta_l, ii);
+            const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+            auto si           = static_cast<std::size_t>(ii);
 
             auto result = xt::zeros_like(f(level, i));
 
-            for (const auto& kv : pred.coeff)
+            for (std::size_t s = 0; s < table.size(si); ++s)
             {
-                // cppcheck-suppress useStlAlgorithm
-                result += kv.second * f(level, i + kv.first[0]);
+                result += table.weights(si)[s] * f(level, i + table.offsets(si)[s]);
             }
             return result;
         }
@@ -466,14 +754,19 @@ namespace samurai
                           index_t ii,
                           index_t jj)
         {
-            auto pred = prediction<prediction_order, index_t>(delta_l, ii, jj);
+            const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+            auto si           = static_cast<std::size_t>(ii);
+            auto sj           = static_cast<std::size_t>(jj);
 
             auto result = xt::zeros_like(f(element, level, i, j));
 
-            for (const auto& kv : pred.coeff)
+            for (std::size_t t = 0; t < table.size(sj); ++t)
             {
-                // cppcheck-suppress useStlAlgorithm
-                result += kv.second * f(element, level, i + kv.first[0], j + kv.first[1]);
+                for (std::size_t s = 0; s < table.size(si); ++s)
+                {
+                    result += table.weights(si)[s] * table.weights(sj)[t]
+                            * f(element, level, i + table.offsets(si)[s], j + table.offsets(sj)[t]);
+                }
             }
             return result;
         }
@@ -482,14 +775,18 @@ namespace samurai
         auto
         portion_impl(const Field& f, std::size_t level, const typename Field::interval_t& i, index_t j, std::size_t delta_l, index_t ii, index_t jj)
         {
-            auto pred = prediction<prediction_order, index_t>(delta_l, ii, jj);
+            const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+            auto si           = static_cast<std::size_t>(ii);
+            auto sj           = static_cast<std::size_t>(jj);
 
             auto result = xt::zeros_like(f(level, i, j));
 
-            for (const auto& kv : pred.coeff)
+            for (std::size_t t = 0; t < table.size(sj); ++t)
             {
-                // cppcheck-suppress useStlAlgorithm
-                result += kv.second * f(level, i + kv.first[0], j + kv.first[1]);
+                for (std::size_t s = 0; s < table.size(si); ++s)
+                {
+                    result += table.weights(si)[s] * table.weights(sj)[t] * f(level, i + table.offsets(si)[s], j + table.offsets(sj)[t]);
+                }
             }
             return result;
         }
@@ -507,14 +804,23 @@ namespace samurai
                           index_t jj,
                           index_t kk)
         {
-            auto pred = prediction<prediction_order, index_t>(delta_l, ii, jj, kk);
+            const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+            auto si           = static_cast<std::size_t>(ii);
+            auto sj           = static_cast<std::size_t>(jj);
+            auto sk           = static_cast<std::size_t>(kk);
 
             auto result = xt::zeros_like(f(element, level, i, j, k));
 
-            for (const auto& kv : pred.coeff)
+            for (std::size_t u = 0; u < table.size(sk); ++u)
             {
-                // cppcheck-suppress useStlAlgorithm
-                result += kv.second * f(element, level, i + kv.first[0], j + kv.first[1], k + kv.first[2]);
+                for (std::size_t t = 0; t < table.size(sj); ++t)
+                {
+                    for (std::size_t s = 0; s < table.size(si); ++s)
+                    {
+                        result += table.weights(si)[s] * table.weights(sj)[t] * table.weights(sk)[u]
+                                * f(element, level, i + table.offsets(si)[s], j + table.offsets(sj)[t], k + table.offsets(sk)[u]);
+                    }
+                }
             }
             return result;
         }
@@ -530,14 +836,23 @@ namespace samurai
                           index_t jj,
                           index_t kk)
         {
-            auto pred = prediction<prediction_order, index_t>(delta_l, ii, jj, kk);
+            const auto& table = get_prediction_table<prediction_order, index_t>(delta_l);
+            auto si           = static_cast<std::size_t>(ii);
+            auto sj           = static_cast<std::size_t>(jj);
+            auto sk           = static_cast<std::size_t>(kk);
 
             auto result = xt::zeros_like(f(level, i, j, k));
 
-            for (const auto& kv : pred.coeff)
+            for (std::size_t u = 0; u < table.size(sk); ++u)
             {
-                // cppcheck-suppress useStlAlgorithm
-                result += kv.second * f(level, i + kv.first[0], j + kv.first[1], k + kv.first[2]);
+                for (std::size_t t = 0; t < table.size(sj); ++t)
+                {
+                    for (std::size_t s = 0; s < table.size(si); ++s)
+                    {
+                        result += table.weights(si)[s] * table.weights(sj)[t] * table.weights(sk)[u]
+                                * f(level, i + table.offsets(si)[s], j + table.offsets(sj)[t], k + table.offsets(sk)[u]);
+                    }
+                }
             }
             return result;
         }
@@ -668,17 +983,91 @@ namespace samurai
         return detail::portion_impl<prediction_order>(f, level, i, j, k, delta_l, ii, jj, kk);
     }
 
-    template <class Field_src, class Field_dst>
-    void transfer(Field_src& field_src, Field_dst& field_dst)
+    /**
+     * Sparse linear map from the cells of a source mesh to the cells of a destination mesh:
+     * - a destination cell that is also a source cell takes its value;
+     * - a destination cell covered by finer source cells takes the mean of their values;
+     * - a destination cell inside a coarser source cell takes the value predicted from it.
+     * The map is stored row by row (one row per destination cell, CSR format), in terms of storage indices,
+     * so that it is computed once for a pair of meshes and then applied as a gather to any pair of fields.
+     * The source field must have its ghosts updated before the application (see update_ghost_mr()).
+     */
+    template <class Mesh_src, class Mesh_dst = Mesh_src>
+    class transfer_map
     {
-        static constexpr std::size_t dim = Field_src::dim;
-        using mesh_id_t                  = typename Field_src::mesh_t::mesh_id_t;
-        using interval_t                 = typename Field_src::interval_t;
-        using value_t                    = typename interval_t::value_t;
-        auto& mesh_src                   = field_src.mesh();
-        auto& mesh_dst                   = field_dst.mesh();
+      public:
 
-        field_dst.fill(0.);
+        transfer_map() = default;
+        transfer_map(const Mesh_src& mesh_src, const Mesh_dst& mesh_dst);
+
+        void update(const Mesh_src& mesh_src, const Mesh_dst& mesh_dst);
+
+        template <class Field_src, class Field_dst>
+        void apply(const Field_src& field_src, Field_dst& field_dst) const;
+
+        std::size_t nb_rows() const
+        {
+            return m_rows.size();
+        }
+
+        std::size_t nb_entries() const
+        {
+            return m_src.size();
+        }
+
+      private:
+
+        void build(const Mesh_src& mesh_src, const Mesh_dst& mesh_dst);
+
+        bool m_built                   = false;
+        std::size_t m_src_generation   = 0;
+        std::size_t m_dst_generation   = 0;
+        std::vector<std::size_t> m_rows;  // storage index of the destination cell of each row
+        std::vector<std::size_t> m_start; // entries of the row r: [m_start[r], m_start[r + 1])
+        std::vector<std::size_t> m_src;   // storage index of the source cell of each entry
+        std::vector<double> m_weights;
+    };
+
+    template <class Mesh_src, class Mesh_dst>
+    transfer_map<Mesh_src, Mesh_dst>::transfer_map(const Mesh_src& mesh_src, const Mesh_dst& mesh_dst)
+    {
+        build(mesh_src, mesh_dst);
+    }
+
+    /**
+     * @brief Rebuilds the map if one of the meshes has changed since the last build.
+     */
+    template <class Mesh_src, class Mesh_dst>
+    void transfer_map<Mesh_src, Mesh_dst>::update(const Mesh_src& mesh_src, const Mesh_dst& mesh_dst)
+    {
+        if (!m_built || m_src_generation != mesh_src.generation() || m_dst_generation != mesh_dst.generation())
+        {
+            build(mesh_src, mesh_dst);
+        }
+    }
+
+    template <class Mesh_src, class Mesh_dst>
+    void transfer_map<Mesh_src, Mesh_dst>::build(const Mesh_src& mesh_src, const Mesh_dst& mesh_dst)
+    {
+        static constexpr std::size_t dim              = Mesh_src::dim;
+        static constexpr std::size_t prediction_order = Mesh_src::config::prediction_order;
+        using mesh_id_t                               = typename Mesh_src::mesh_id_t;
+        using interval_t                              = typename Mesh_src::interval_t;
+        using value_t                                 = typename interval_t::value_t;
+        using coord_t                                 = xt::xtensor_fixed<value_t, xt::xshape<dim - 1>>;
+
+        struct entry
+        {
+            std::size_t dst;
+            std::size_t src;
+            double weight;
+        };
+
+        std::vector<entry> entries;
+        auto first_cell = [](const auto& mesh, std::size_t level, const interval_t& i, const coord_t& index)
+        {
+            return static_cast<std::size_t>(mesh.get_interval(level, i, index).index + i.start);
+        };
 
         for (std::size_t level_dst = mesh_dst.min_level(); level_dst <= mesh_dst.max_level(); ++level_dst)
         {
@@ -686,67 +1075,34 @@ namespace samurai
             same_cell(
                 [&](const auto& i, const auto& index)
                 {
-                    if constexpr (dim == 1)
+                    auto dst = first_cell(mesh_dst, level_dst, i, index);
+                    auto src = first_cell(mesh_src, level_dst, i, index);
+                    for (std::size_t x = 0; x < i.size(); ++x)
                     {
-                        field_dst(level_dst, i) = field_src(level_dst, i);
-                    }
-                    else if constexpr (dim == 2)
-                    {
-                        auto j                     = index[0];
-                        field_dst(level_dst, i, j) = field_src(level_dst, i, j);
-                    }
-                    else if constexpr (dim == 3)
-                    {
-                        auto j                        = index[0];
-                        auto k                        = index[1];
-                        field_dst(level_dst, i, j, k) = field_src(level_dst, i, j, k);
+                        entries.push_back({dst + x, src + x, 1.});
                     }
                 });
 
             for (std::size_t level_src = level_dst + 1; level_src <= mesh_src.max_level(); ++level_src)
             {
                 auto proj_cell = intersection(mesh_dst[mesh_id_t::cells][level_dst], mesh_src[mesh_id_t::cells][level_src]).on(level_src);
-
                 proj_cell(
                     [&](const auto& i, const auto& index)
                     {
-                        std::size_t shift = level_src - level_dst;
-
-                        if constexpr (dim == 1)
+                        auto shift = static_cast<value_t>(level_src - level_dst);
+                        coord_t dst_index;
+                        for (std::size_t d = 0; d < dim - 1; ++d)
                         {
-                            auto src = field_src(level_src, i);
-                            auto dst = field_dst(level_dst, i >> shift);
-                            for (value_t ii = 0; ii < static_cast<value_t>(i.size()); ++ii)
-                            {
-                                auto i_dst = static_cast<std::size_t>(((i.start + ii) >> static_cast<value_t>(shift))
-                                                                      - (i.start >> static_cast<value_t>(shift)));
-                                dst(i_dst) += src(ii) / (1 << shift);
-                            }
+                            dst_index[d] = index[d] >> shift;
                         }
-                        else if constexpr (dim == 2)
+                        interval_t dst_i{i.start >> shift, ((i.end - 1) >> shift) + 1};
+                        auto dst    = mesh_dst.get_interval(level_dst, dst_i, dst_index).index;
+                        auto src    = first_cell(mesh_src, level_src, i, index);
+                        auto weight = 1. / static_cast<double>(std::size_t{1} << (static_cast<std::size_t>(shift) * dim));
+                        for (value_t x = i.start; x < i.end; ++x)
                         {
-                            auto j   = index[0];
-                            auto src = field_src(level_src, i, j);
-                            auto dst = field_dst(level_dst, i >> shift, j >> shift);
-                            for (value_t ii = 0; ii < static_cast<value_t>(i.size()); ++ii)
-                            {
-                                auto i_dst = static_cast<std::size_t>(((i.start + ii) >> static_cast<value_t>(shift))
-                                                                      - (i.start >> static_cast<value_t>(shift)));
-                                dst(i_dst) += src(ii) / (1 << (shift * dim));
-                            }
-                        }
-                        else if constexpr (dim == 3)
-                        {
-                            auto j   = index[0];
-                            auto k   = index[1];
-                            auto src = field_src(level_src, i, j, k);
-                            auto dst = field_dst(level_dst, i >> shift, j >> shift, k >> shift);
-                            for (value_t ii = 0; ii < static_cast<value_t>(i.size()); ++ii)
-                            {
-                                auto i_dst = static_cast<std::size_t>(((i.start + ii) >> static_cast<value_t>(shift))
-                                                                      - (i.start >> static_cast<value_t>(shift)));
-                                dst(i_dst) += src(ii) / (1 << (shift * dim));
-                            }
+                            auto fine = static_cast<std::size_t>(x - i.start);
+                            entries.push_back({static_cast<std::size_t>(dst + (x >> shift)), src + fine, weight});
                         }
                     });
             }
@@ -754,65 +1110,145 @@ namespace samurai
             for (std::size_t level_src = mesh_src.min_level(); level_src < level_dst; ++level_src)
             {
                 auto pred_cell = intersection(mesh_dst[mesh_id_t::cells][level_dst], mesh_src[mesh_id_t::cells][level_src]).on(level_dst);
-
                 pred_cell(
                     [&](const auto& i, const auto& index)
                     {
-                        auto shift = level_dst - level_src;
-                        if constexpr (dim == 1)
+                        auto shift        = static_cast<value_t>(level_dst - level_src);
+                        const auto& table = get_prediction_table<prediction_order, value_t>(static_cast<std::size_t>(shift));
+                        auto dst          = first_cell(mesh_dst, level_dst, i, index);
+
+                        // Position of the row in the descendants of its source cells in the other directions
+                        coord_t src_index;
+                        std::array<std::size_t, 2> sjk{0, 0};
+                        std::array<std::size_t, 2> n_jk{1, 1};
+                        for (std::size_t d = 0; d < dim - 1; ++d)
                         {
-                            auto dst = field_dst(level_dst, i);
-                            for (value_t ii = 0; ii < static_cast<value_t>(i.size()); ++ii)
-                            {
-                                auto i_src = (i.start + static_cast<value_t>(ii)) >> shift;
-                                dst(ii)    = portion(field_src,
-                                                  level_src,
-                                                  interval_t{i_src, i_src + 1},
-                                                  shift,
-                                                  i.start + ii - (i_src << static_cast<value_t>(shift)))[0];
-                            }
+                            src_index[d] = index[d] >> shift;
+                            sjk[d]       = static_cast<std::size_t>(index[d] - (src_index[d] << shift));
+                            n_jk[d]      = table.size(sjk[d]);
                         }
-                        else if constexpr (dim == 2)
+
+                        // Source cells used by the row, in the direction x
+                        value_t min_offset = 0;
+                        value_t max_offset = 0;
+                        for (std::size_t ii = 0; ii < (std::size_t{1} << shift); ++ii)
                         {
-                            auto j   = index[0];
-                            auto dst = field_dst(level_dst, i, j);
-                            for (value_t ii = 0; ii < static_cast<value_t>(i.size()); ++ii)
+                            for (std::size_t s = 0; s < table.size(ii); ++s)
                             {
-                                auto i_src = (i.start + static_cast<value_t>(ii)) >> shift;
-                                auto j_src = j >> shift;
-                                dst(ii)    = portion(field_src,
-                                                  level_src,
-                                                  interval_t{i_src, i_src + 1},
-                                                  j_src,
-                                                  shift,
-                                                  i.start + ii - (i_src << static_cast<value_t>(shift)),
-                                                  j - (j_src << shift))[0];
+                                min_offset = std::min(min_offset, table.offsets(ii)[s]);
+                                max_offset = std::max(max_offset, table.offsets(ii)[s]);
                             }
                         }
-                        else if constexpr (dim == 3)
+                        interval_t src_i{(i.start >> shift) + min_offset, ((i.end - 1) >> shift) + 1 + max_offset};
+
+                        for (std::size_t u = 0; u < n_jk[1]; ++u)
                         {
-                            auto j   = index[0];
-                            auto k   = index[1];
-                            auto dst = field_dst(level_dst, i, j, k);
-                            for (value_t ii = 0; ii < static_cast<value_t>(i.size()); ++ii)
+                            for (std::size_t t = 0; t < n_jk[0]; ++t)
                             {
-                                auto i_src = (i.start + static_cast<value_t>(ii)) >> shift;
-                                auto j_src = j >> shift;
-                                auto k_src = k >> shift;
-                                dst(ii)    = portion(field_src,
-                                                  level_src,
-                                                  interval_t{i_src, i_src + 1},
-                                                  j_src,
-                                                  k_src,
-                                                  shift,
-                                                  i.start + ii - (i_src << static_cast<value_t>(shift)),
-                                                  j - (j_src << shift),
-                                                  k - (k_src << shift))[0];
+                                double weight_jk = 1;
+                                coord_t row_index;
+                                for (std::size_t d = 0; d < dim - 1; ++d)
+                                {
+                                    auto s       = d == 0 ? t : u;
+                                    row_index[d] = src_index[d] + table.offsets(sjk[d])[s];
+                                    weight_jk *= table.weights(sjk[d])[s];
+                                }
+                                auto src = mesh_src.get_interval(level_src, src_i, row_index).index;
+
+                                for (value_t x = i.start; x < i.end; ++x)
+                                {
+                                    auto x_src = x >> shift;
+                                    auto ii    = static_cast<std::size_t>(x - (x_src << shift));
+                                    for (std::size_t s = 0; s < table.size(ii); ++s)
+                                    {
+                                        entries.push_back({dst + static_cast<std::size_t>(x - i.start),
+                                                           static_cast<std::size_t>(src + x_src + table.offsets(ii)[s]),
+                                                           weight_jk * table.weights(ii)[s]});
+                                    }
+                                }
                             }
                         }
                     });
             }
         }
+
+        // Conversion to CSR
+        std::stable_sort(entries.begin(),
+                         entries.end(),
+                         [](const auto& a, const auto& b)
+                         {
+                             return a.dst < b.dst;
+                         });
+        m_rows.clear();
+        m_start.clear();
+        m_src.clear();
+        m_weights.clear();
+        m_src.reserve(entries.size());
+        m_weights.reserve(entries.size());
+        for (const auto& e : entries)
+        {
+            if (m_rows.empty() || m_rows.back() != e.dst)
+            {
+                m_rows.push_back(e.dst);
+                m_start.push_back(m_src.size());
+            }
+            m_src.push_back(e.src);
+            m_weights.push_back(e.weight);
+        }
+        m_start.push_back(m_src.size());
+
+        m_built          = true;
+        m_src_generation = mesh_src.generation();
+        m_dst_generation = mesh_dst.generation();
+    }
+
+    /**
+     * @brief Sets the destination field from the source field.
+     * The rows are independent gathers in the source field: they are distributed with the default execution policy.
+     */
+    template <class Mesh_src, class Mesh_dst>
+    template <class Field_src, class Field_dst>
+    void transfer_map<Mesh_src, Mesh_dst>::apply(const Field_src& field_src, Field_dst& field_dst) const
+    {
+        static_assert(Field_src::size == Field_dst::size, "transfer: the fields must have the same number of components.");
+        assert(m_built && m_src_generation == field_src.mesh().generation() && m_dst_generation == field_dst.mesh().generation());
+
+        field_dst.fill(0.);
+
+        auto src = detail::make_field_cells(field_src);
+        auto dst = detail::make_field_cells(field_dst);
+        parallel_for(execution::par,
+                     m_rows.size(),
+                     [&](std::size_t r)
+                     {
+                         auto row = static_cast<std::ptrdiff_t>(m_rows[r]);
+                         for (std::size_t c = 0; c < Field_src::size; ++c)
+                         {
+                             double value = 0;
+                             for (std::size_t e = m_start[r]; e < m_start[r + 1]; ++e)
+                             {
+                                 value += m_weights[e] * src(static_cast<std::ptrdiff_t>(m_src[e]), c);
+                             }
+                             dst(row, c) = value;
+                         }
+                     });
+    }
+
+    /**
+     * @brief Transfer with a map kept by the caller: the map is only rebuilt when one of the meshes has changed.
+     */
+    template <class Field_src, class Field_dst, class Mesh_src, class Mesh_dst>
+    void transfer(const Field_src& field_src, Field_dst& field_dst, transfer_map<Mesh_src, Mesh_dst>& map)
+    {
+        map.update(field_src.mesh(), field_dst.mesh());
+        map.apply(field_src, field_dst);
+    }
+
+    template <class Field_src, class Field_dst>
+    void transfer(Field_src& field_src, Field_dst& field_dst)
+    {
+        transfer_map<typename Field_src::mesh_t, typename Field_dst::mesh_t> map(field_src.mesh(), field_dst.mesh());
+        map.apply(field_src, field_dst);
     }
 
 }
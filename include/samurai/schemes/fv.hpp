@@ -4,9 +4,12 @@
 
 #pragma once
 #include "../numeric/error.hpp"
+#include "weno.hpp"
 
 #include "fv/explicit_flux_based_scheme.hpp"
+#include "fv/local_time_stepping.hpp"
 #include "fv/scheme_operators.hpp"
+#include "fv/smoothers.hpp"
 
 #include "fv/operators/convection_FV__nonlin.hpp"
 #include "fv/operators/diffusion_FV.hpp"
@@ -0,0 +1,231 @@
+#pragma once
+#include "../../algorithm.hpp"
+#include "../../algorithm/update.hpp"
+#include "../../interface.hpp"
+#include "../../parallel.hpp"
+#include "flux_based_scheme__nonlin.hpp"
+
+namespace samurai
+{
+    /**
+     * Local time stepping of the explicit Euler scheme u^{n+1} = u^n - dt * scheme(u^n).
+     * The cells of level l are advanced with the time step dt_l = 2^(max_level - l) dt, where dt is the time step of the finest level:
+     * advance() covers the time step of the coarsest level in 2^(max_level - min_level) substeps of the finest level,
+     * and the cells of level l are updated 2^(l - min_level) times instead of 2^(max_level - min_level) times.
+     *
+     * A level starts its step at the substeps that are multiples of its ratio 2^(max_level - l),
+     * and updates its cells at the end of the step.
+     * The fluxes are computed at the start of the steps, from the values at that time (the values of the coarser levels,
+     * and the ghosts predicted from them, are those of the beginning of their step).
+     * The interfaces between a level l and the level l+1 belong to the level l+1: their fluxes are computed at every substep
+     * of the level l+1, applied to the fine cell at once, and accumulated for the coarse cell until the end of its step
+     * (flux register). The same fluxes are applied on both sides of every interface, so the scheme is conservative.
+     * At a substep, only the ghosts of the levels that start a step are updated.
+     */
+    template <class Scheme, class check = void>
+    class LocalTimeStepping
+    {
+    };
+
+    /**
+     * NON-LINEAR flux-based schemes
+     */
+    template <class Scheme>
+    class LocalTimeStepping<Scheme, std::enable_if_t<is_FluxBasedScheme_v<Scheme> && Scheme::cfg_t::flux_type == FluxType::NonLinear>>
+    {
+        using field_t                                  = typename Scheme::field_t;
+        using mesh_id_t                                = typename field_t::mesh_t::mesh_id_t;
+        static constexpr std::size_t dim               = field_t::dim;
+        static constexpr std::size_t output_field_size = Scheme::output_field_size;
+
+        static_assert(output_field_size == field_t::size, "the scheme must have the size of the field to be integrated in time");
+
+      protected:
+
+        const Scheme* m_scheme = nullptr;
+
+      public:
+
+        explicit LocalTimeStepping(const Scheme& scheme)
+            : m_scheme(&scheme)
+        {
+        }
+
+        auto& scheme() const
+        {
+            return *m_scheme;
+        }
+
+        /**
+         * @brief Advances u by 2^(max_level - min_level) time steps dt of the finest level. Returns the time covered.
+         */
+        double advance(field_t& u, double dt)
+        {
+            auto& mesh     = u.mesh();
+            auto min_level = mesh[mesh_id_t::cells].min_level();
+            auto max_level = mesh[mesh_id_t::cells].max_level();
+
+            // Increments of the cells during their current step, including the flux registers of the coarse cells at a level jump
+            auto increment = make_field<typename field_t::value_type, field_t::size, field_t::is_soa>("lts_increment", mesh);
+            increment.fill(0);
+
+            std::size_t n_substeps = std::size_t{1} << (max_level - min_level);
+            for (std::size_t k = 0; k < n_substeps; ++k)
+            {
+                // The cells of the levels that do not start a step at this substep are unchanged since the previous substep
+                if (k == 0)
+                {
+                    update_ghost_mr(u);
+                }
+                else
+                {
+                    update_ghost_mr_from_level(first_active_level(k, min_level, max_level), u);
+                }
+                for (std::size_t level = min_level; level <= max_level; ++level)
+                {
+                    std::size_t ratio = std::size_t{1} << (max_level - level);
+                    if (k % ratio == 0)
+                    {
+                        add_level_fluxes(u, increment, level, static_cast<double>(ratio) * dt);
+                    }
+                }
+                for (std::size_t level = min_level; level <= max_level; ++level)
+                {
+                    std::size_t ratio = std::size_t{1} << (max_level - level);
+                    if ((k + 1) % ratio == 0)
+                    {
+                        parallel_for_each_interval(execution::par,
+                                                   mesh,
+                                                   level,
+                                                   [&](std::size_t l, const auto& i, const auto& index)
+                                                   {
+                                                       u(l, i, index) += increment(l, i, index);
+                                                       increment(l, i, index) = 0;
+                                                   });
+                    }
+                }
+            }
+            return static_cast<double>(n_substeps) * dt;
+        }
+
+      private:
+
+        /**
+         * @brief Coarsest level that starts a step at the substep k: the levels l such that 2^(max_level - l) divides k.
+         */
+        static std::size_t first_active_level(std::size_t k, std::size_t min_level, std::size_t max_level)
+        {
+            std::size_t level = max_level;
+            while (level > min_level && k % (std::size_t{1} << (max_level - level + 1)) == 0)
+            {
+                --level;
+            }
+            return level;
+        }
+
+        /**
+         * @brief Adds -dt_level * (flux contributions) for the interfaces that belong to the level:
+         * interfaces between two cells of the level, level jumps with the level below, boundary interfaces.
+         */
+        void add_level_fluxes(field_t& u, field_t& increment, std::size_t level, double dt_level) const
+        {
+            auto& mesh     = u.mesh();
+            auto min_level = mesh[mesh_id_t::cells].min_level();
+            auto h         = cell_length(level);
+
+            auto add_contrib = [&](auto& cell, const auto& contrib)
+            {
+                for (std::size_t field_i = 0; field_i < output_field_size; ++field_i)
+                {
+                    field_value(increment, cell, field_i) -= dt_level * scheme().cell_coeff(contrib, field_i);
+                }
+            };
+            auto add_interface_contribs = [&](auto& interface_cells, const auto& left_cell_contrib, const auto& right_cell_contrib)
+            {
+                add_contrib(interface_cells[0], left_cell_contrib);
+                add_contrib(interface_cells[1], right_cell_contrib);
+            };
+
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                auto& scheme_def = scheme().definition()[d];
+
+                for_each_interior_interface___same_level(mesh,
+                                                         level,
+                                                         scheme_def.flux().direction,
+                                                         scheme_def.flux().stencil,
+                                                         [&](auto& interface_cells, auto& comput_cells)
+                                                         {
+                                                             auto flux_value = scheme_def.flux().flux_function(u, comput_cells);
+                                                             decltype(flux_value) minus_flux_value = -flux_value;
+                                                             add_interface_contribs(interface_cells,
+                                                                                    scheme_def.contribution(flux_value, h, h),
+                                                                                    scheme_def.contribution(minus_flux_value, h, h));
+                                                         });
+
+                if (level > min_level)
+                {
+                    auto h_coarse = cell_length(level - 1);
+
+                    //         |__|   level
+                    //    |____|      level - 1
+                    for_each_interior_interface___level_jump_direction(
+                        mesh,
+                        level - 1,
+                        scheme_def.flux().direction,
+                        scheme_def.flux().stencil,
+                        [&](auto& interface_cells, auto& comput_cells)
+                        {
+                            auto flux_value                       = scheme_def.flux().flux_function(u, comput_cells);
+                            decltype(flux_value) minus_flux_value = -flux_value;
+                            add_interface_contribs(interface_cells,
+                                                   scheme_def.contribution(flux_value, h, h_coarse),
+                                                   scheme_def.contribution(minus_flux_value, h, h));
+                        });
+
+                    //    |__|        level
+                    //       |____|   level - 1
+                    for_each_interior_interface___level_jump_opposite_direction(
+                        mesh,
+                        level - 1,
+                        scheme_def.flux().direction,
+                        scheme_def.flux().stencil,
+                        [&](auto& interface_cells, auto& comput_cells)
+                        {
+                            auto flux_value                       = scheme_def.flux().flux_function(u, comput_cells);
+                            decltype(flux_value) minus_flux_value = -flux_value;
+                            add_interface_contribs(interface_cells,
+                                                   scheme_def.contribution(flux_value, h, h),
+                                                   scheme_def.contribution(minus_flux_value, h, h_coarse));
+                        });
+                }
+
+                for_each_boundary_interface___direction(mesh,
+                                                        level,
+                                                        scheme_def.flux().direction,
+                                                        scheme_def.flux().stencil,
+                                                        [&](auto& cell, auto& comput_cells)
+                                                        {
+                                                            auto flux_value = scheme_def.flux().flux_function(u, comput_cells);
+                                                            add_contrib(cell, scheme_def.contribution(flux_value, h, h));
+                                                        });
+                for_each_boundary_interface___opposite_direction(mesh,
+                                                                 level,
+                                                                 scheme_def.flux().direction,
+                                                                 scheme_def.flux().stencil,
+                                                                 [&](auto& cell, auto& comput_cells)
+                                                                 {
+                                                                     auto flux_value = scheme_def.flux().flux_function(u, comput_cells);
+                                                                     decltype(flux_value) minus_flux_value = -flux_value;
+                                                                     add_contrib(cell, scheme_def.contribution(minus_flux_value, h, h));
+                                                                 });
+            }
+        }
+    };
+
+    template <class Scheme>
+    auto make_local_time_stepping(const Scheme& scheme)
+    {
+        return LocalTimeStepping<Scheme>(scheme);
+    }
+} // end namespace samurai
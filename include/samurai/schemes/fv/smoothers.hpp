@@ -0,0 +1,607 @@
+#pragma once
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include "../../algorithm/update.hpp"
+#include "../../parallel.hpp"
+#include "explicit_flux_based_scheme.hpp"
+#include "scheme_operators.hpp"
+
+namespace samurai
+{
+    enum class SmootherType
+    {
+        Jacobi,
+        RedBlackGaussSeidel,
+        Chebyshev
+    };
+
+    namespace detail
+    {
+        /**
+         * Decomposition of a scheme into a linear flux-based scheme and a cell-based part with a one-cell stencil
+         * (e.g. the identity in 'id + dt * diff').
+         */
+        template <class Scheme>
+        struct smoother_scheme_parts
+        {
+            static_assert(is_FluxBasedScheme_v<Scheme> && Scheme::cfg_t::flux_type == FluxType::LinearHomogeneous,
+                          "The smoothers are only implemented for linear flux-based schemes.");
+
+            static auto& flux_scheme(const Scheme& scheme)
+            {
+                return scheme;
+            }
+
+            static double cell_coeff(const Scheme&, double)
+            {
+                return 0;
+            }
+        };
+
+        template <class FluxScheme, class CellScheme>
+        struct smoother_scheme_parts<FluxBasedScheme_Sum_CellBasedScheme<FluxScheme, CellScheme>>
+        {
+            using scheme_t = FluxBasedScheme_Sum_CellBasedScheme<FluxScheme, CellScheme>;
+
+            static_assert(FluxScheme::cfg_t::flux_type == FluxType::LinearHomogeneous,
+                          "The smoothers are only implemented for linear flux-based schemes.");
+            static_assert(CellScheme::cfg_t::scheme_stencil_size == 1, "The smoothers only accept cell-based schemes with a one-cell stencil.");
+
+            static auto& flux_scheme(const scheme_t& scheme)
+            {
+                return scheme.flux_scheme();
+            }
+
+            static double cell_coeff(const scheme_t& scheme, double h)
+            {
+                return scheme.cell_scheme().coefficients(h)[0];
+            }
+        };
+    }
+
+    /**
+     * Matrix-free smoothers for the linear system 'scheme(u) = rhs': no matrix is assembled,
+     * the operator is applied to the field through the interface iterators of the scheme.
+     * The boundary conditions and the projection/prediction ghosts are handled by the ghost update of the field,
+     * so that the iterations work on the cells only.
+     *
+     *   - weighted Jacobi:          u += w D^{-1} (rhs - A u)
+     *   - red-black Gauss-Seidel:   the cells of each color (parity of i+j+k) are updated in turn, in place, from the current
+     *                               values of their stencil: the rows of the operator are stored once per mesh.
+     *                               With a star stencil, the cells of one color only depend on the other color,
+     *                               so that each half-sweep is processed in parallel. The ghosts are updated once per sweep.
+     *   - Chebyshev:                polynomial smoother on D^{-1} A, whose largest eigenvalue is estimated by power iterations.
+     *
+     * D is the diagonal of the operator, including the dependency of the boundary ghosts and of the prediction ghosts
+     * (order 0 part) on the cells. It is computed once per mesh, or after update_coefficients().
+     */
+    template <class Scheme>
+    class Smoother
+    {
+        using parts_t = detail::smoother_scheme_parts<Scheme>;
+
+      public:
+
+        using field_t                    = typename Scheme::field_t;
+        using mesh_t                     = typename field_t::mesh_t;
+        using mesh_id_t                  = typename mesh_t::mesh_id_t;
+        using cell_t                     = typename field_t::cell_t;
+        static constexpr std::size_t dim = field_t::dim;
+
+        static_assert(field_t::size == 1, "The smoothers are only implemented for scalar fields.");
+
+      private:
+
+        const Scheme* m_scheme;
+        SmootherType m_type                = SmootherType::Jacobi;
+        double m_weight                    = 2. / 3;
+        double m_chebyshev_min_ratio       = 0.1; // lower bound of the Chebyshev interval, relative to the largest eigenvalue
+        std::size_t m_power_iterations     = 10;
+        std::unique_ptr<field_t> m_diagonal;
+        std::size_t m_mesh_generation      = 0;
+        double m_lambda_max                = 0;
+
+        // Rows of the operator on the cells (red-black Gauss-Seidel), ordered by color
+        std::vector<std::size_t> m_row_cell; // index of the cell of the row in the field
+        std::vector<std::size_t> m_row_ptr;
+        std::vector<std::size_t> m_cols; // indices in the field (cells or ghosts)
+        std::vector<double> m_values;
+        std::array<std::size_t, 3> m_color_rows{}; // rows of the color c: [m_color_rows[c], m_color_rows[c+1])
+        bool m_independent_colors = true;
+
+      public:
+
+        explicit Smoother(const Scheme& scheme, SmootherType type = SmootherType::Jacobi)
+            : m_scheme(&scheme)
+            , m_type(type)
+        {
+        }
+
+        void set_type(SmootherType type)
+        {
+            m_type = type;
+        }
+
+        /**
+         * @brief Relaxation weight of the Jacobi smoother (2/3 by default).
+         */
+        void set_weight(double weight)
+        {
+            m_weight = weight;
+        }
+
+        /**
+         * @brief The Chebyshev smoother damps the eigenvalues in [ratio * lambda_max, 1.1 * lambda_max] (ratio = 0.1 by default).
+         */
+        void set_chebyshev_min_ratio(double ratio)
+        {
+            m_chebyshev_min_ratio = ratio;
+        }
+
+        /**
+         * @brief Declares that the coefficients of the scheme have changed: the diagonal is recomputed at the next use.
+         */
+        void update_coefficients()
+        {
+            m_diagonal = nullptr;
+        }
+
+        /**
+         * @brief Returns A u, computed on the cells.
+         */
+        auto apply(field_t& u) const
+        {
+            update_ghost_mr(u);
+            auto result = make_explicit(parts_t::flux_scheme(scheme())).apply_to(u);
+            parallel_for_each_interval(u.mesh(),
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           auto cell_coeff = parts_t::cell_coeff(scheme(), cell_length(level));
+                                           result(level, i, index) += cell_coeff * u(level, i, index);
+                                       });
+            return result;
+        }
+
+        /**
+         * @brief Returns rhs - A u, computed on the cells.
+         */
+        auto residual(field_t& u, const field_t& rhs) const
+        {
+            auto r = apply(u);
+            parallel_for_each_interval(u.mesh(),
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           r(level, i, index) = rhs(level, i, index) - r(level, i, index);
+                                       });
+            return r;
+        }
+
+        /**
+         * @brief Performs 'sweeps' iterations of the smoother (the degree of the polynomial for Chebyshev).
+         */
+        void smooth(field_t& u, const field_t& rhs, std::size_t sweeps = 1)
+        {
+            setup(u);
+            if (m_type == SmootherType::Chebyshev)
+            {
+                chebyshev(u, rhs, sweeps);
+                return;
+            }
+            for (std::size_t s = 0; s < sweeps; ++s)
+            {
+                if (m_type == SmootherType::Jacobi)
+                {
+                    auto r = residual(u, rhs);
+                    relax(u, r, m_weight);
+                }
+                else
+                {
+                    update_ghost_mr(u);
+                    for (int color = 0; color < 2; ++color)
+                    {
+                        relax_color(u, rhs, color);
+                    }
+                }
+            }
+        }
+
+        /**
+         * @brief Uses the smoother as an iterative solver, until ||rhs - A u|| <= tol * ||rhs||.
+         * @return the number of iterations.
+         */
+        std::size_t solve(field_t& u, const field_t& rhs, double tol = 1e-8, std::size_t max_iterations = 10000)
+        {
+            double rhs_norm = cells_norm(rhs);
+            if (rhs_norm == 0)
+            {
+                rhs_norm = 1;
+            }
+            for (std::size_t it = 1; it <= max_iterations; ++it)
+            {
+                smooth(u, rhs);
+                if (cells_norm(residual(u, rhs)) <= tol * rhs_norm)
+                {
+                    return it;
+                }
+            }
+            return max_iterations;
+        }
+
+        const field_t& diagonal(field_t& u)
+        {
+            setup(u);
+            return *m_diagonal;
+        }
+
+      private:
+
+        const Scheme& scheme() const
+        {
+            return *m_scheme;
+        }
+
+        void setup(field_t& u)
+        {
+            if (!m_diagonal || m_mesh_generation != u.mesh().generation())
+            {
+                compute_diagonal(u);
+                m_mesh_generation = u.mesh().generation();
+                m_lambda_max      = 0;
+                m_row_ptr.clear();
+            }
+            if (m_type == SmootherType::Chebyshev && m_lambda_max == 0)
+            {
+                estimate_lambda_max(u);
+            }
+            if (m_type == SmootherType::RedBlackGaussSeidel && m_row_ptr.empty())
+            {
+                compute_rows(u);
+            }
+        }
+
+        static int color(const cell_t& cell)
+        {
+            int parity = 0;
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                parity += static_cast<int>(cell.indices[d]);
+            }
+            return ((parity % 2) + 2) % 2;
+        }
+
+        /**
+         * Calls add(equation cell index, stencil cell index, coefficient) for the coefficients of the operator.
+         */
+        template <class Func>
+        void for_each_coefficient(mesh_t& mesh, Func&& add) const
+        {
+            auto& flux_scheme = parts_t::flux_scheme(scheme());
+            flux_scheme.for_each_interior_interface(mesh,
+                                                    [&](auto& interface_cells, auto& comput_cells, auto& left_cell_coeffs, auto& right_cell_coeffs)
+                                                    {
+                                                        for (std::size_t c = 0; c < comput_cells.size(); ++c)
+                                                        {
+                                                            add(interface_cells[0].index,
+                                                                comput_cells[c].index,
+                                                                flux_scheme.cell_coeff(left_cell_coeffs, c, 0, 0));
+                                                            add(interface_cells[1].index,
+                                                                comput_cells[c].index,
+                                                                flux_scheme.cell_coeff(right_cell_coeffs, c, 0, 0));
+                                                        }
+                                                    });
+            flux_scheme.for_each_boundary_interface(mesh,
+                                                    [&](auto& cell, auto& comput_cells, auto& coeffs)
+                                                    {
+                                                        for (std::size_t c = 0; c < comput_cells.size(); ++c)
+                                                        {
+                                                            add(cell.index, comput_cells[c].index, flux_scheme.cell_coeff(coeffs, c, 0, 0));
+                                                        }
+                                                    });
+            for_each_cell(mesh[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              add(cell.index, cell.index, parts_t::cell_coeff(scheme(), cell.length));
+                          });
+        }
+
+        /**
+         * Stores the rows of the operator, the rows of the red cells first (count, then fill).
+         */
+        void compute_rows(field_t& u)
+        {
+            static constexpr auto no_row = std::numeric_limits<std::size_t>::max();
+
+            auto& mesh = u.mesh();
+            std::vector<std::size_t> row_of(u.array().size(), no_row);
+
+            m_row_cell.clear();
+            for (int c = 0; c < 2; ++c)
+            {
+                m_color_rows[static_cast<std::size_t>(c)] = m_row_cell.size();
+                for_each_cell(mesh[mesh_id_t::cells],
+                              [&](const auto& cell)
+                              {
+                                  if (color(cell) == c)
+                                  {
+                                      row_of[static_cast<std::size_t>(cell.index)] = m_row_cell.size();
+                                      m_row_cell.push_back(static_cast<std::size_t>(cell.index));
+                                  }
+                              });
+            }
+            m_color_rows[2] = m_row_cell.size();
+
+            m_row_ptr.assign(m_row_cell.size() + 1, 0);
+            for_each_coefficient(mesh,
+                                 [&](auto cell_index, auto, double)
+                                 {
+                                     auto row = row_of[static_cast<std::size_t>(cell_index)];
+                                     if (row != no_row) // the equations of the ghosts are not smoothed
+                                     {
+                                         ++m_row_ptr[row + 1];
+                                     }
+                                 });
+            for (std::size_t row = 0; row < m_row_cell.size(); ++row)
+            {
+                m_row_ptr[row + 1] += m_row_ptr[row];
+            }
+
+            m_cols.resize(m_row_ptr.back());
+            m_values.resize(m_row_ptr.back());
+            std::vector<std::size_t> next(m_row_ptr.begin(), m_row_ptr.end() - 1);
+            for_each_coefficient(mesh,
+                                 [&](auto cell_index, auto stencil_index, double coeff)
+                                 {
+                                     auto row = row_of[static_cast<std::size_t>(cell_index)];
+                                     if (row != no_row)
+                                     {
+                                         auto k      = next[row]++;
+                                         m_cols[k]   = static_cast<std::size_t>(stencil_index);
+                                         m_values[k] = coeff;
+                                     }
+                                 });
+
+            // The updates of one color are independent if no row uses another cell of the same color
+            m_independent_colors = true;
+            for (std::size_t row = 0; row < m_row_cell.size() && m_independent_colors; ++row)
+            {
+                bool red = row < m_color_rows[1];
+                for (std::size_t k = m_row_ptr[row]; k < m_row_ptr[row + 1]; ++k)
+                {
+                    auto col_row = row_of[m_cols[k]];
+                    if (col_row != no_row && col_row != row && (col_row < m_color_rows[1]) == red)
+                    {
+                        m_independent_colors = false;
+                        break;
+                    }
+                }
+            }
+        }
+
+        static bool is_child(const cell_t& child, const cell_t& parent)
+        {
+            if (child.level != parent.level + 1)
+            {
+                return false;
+            }
+            for (std::size_t d = 0; d < dim; ++d)
+            {
+                if ((child.indices[d] >> 1) != parent.indices[d])
+                {
+                    return false;
+                }
+            }
+            return true;
+        }
+
+        void compute_diagonal(field_t& u)
+        {
+            auto& mesh = u.mesh();
+
+            // Dependency of the boundary ghosts on their neighbouring cell (e.g. -1 for Dirichlet, 1 for Neumann),
+            // measured by updating the boundary conditions with 0 then 1 in the cells.
+            field_t bc_dependency = u;
+            field_t bc_shift      = u;
+            bc_dependency.fill(0);
+            bc_shift.fill(0);
+            parallel_for_each_interval(mesh,
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           bc_dependency(level, i, index) = 1;
+                                       });
+            update_bc(bc_dependency);
+            update_bc(bc_shift);
+            bc_dependency.array() -= bc_shift.array();
+            parallel_for_each_interval(mesh,
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           bc_dependency(level, i, index) = 0;
+                                       });
+
+            // Dependency of the value used in the stencil on the cell of the equation
+            auto dependency = [&](const cell_t& cell, const cell_t& stencil_cell) -> double
+            {
+                if (stencil_cell.index == cell.index || is_child(stencil_cell, cell))
+                {
+                    return 1;
+                }
+                return bc_dependency[stencil_cell];
+            };
+
+            m_diagonal = std::make_unique<field_t>("diagonal", mesh);
+            auto& diag = *m_diagonal;
+            diag.fill(0);
+
+            auto& flux_scheme = parts_t::flux_scheme(scheme());
+            flux_scheme.for_each_interior_interface(mesh,
+                                                    [&](auto& interface_cells, auto& comput_cells, auto& left_cell_coeffs, auto& right_cell_coeffs)
+                                                    {
+                                                        for (std::size_t c = 0; c < comput_cells.size(); ++c)
+                                                        {
+                                                            diag[interface_cells[0]] += flux_scheme.cell_coeff(left_cell_coeffs, c, 0, 0)
+                                                                                      * dependency(interface_cells[0], comput_cells[c]);
+                                                            diag[interface_cells[1]] += flux_scheme.cell_coeff(right_cell_coeffs, c, 0, 0)
+                                                                                      * dependency(interface_cells[1], comput_cells[c]);
+                                                        }
+                                                    });
+            flux_scheme.for_each_boundary_interface(mesh,
+                                                    [&](auto& cell, auto& comput_cells, auto& coeffs)
+                                                    {
+                                                        for (std::size_t c = 0; c < comput_cells.size(); ++c)
+                                                        {
+                                                            diag[cell] += flux_scheme.cell_coeff(coeffs, c, 0, 0) * dependency(cell, comput_cells[c]);
+                                                        }
+                                                    });
+            parallel_for_each_interval(mesh,
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           diag(level, i, index) += parts_t::cell_coeff(scheme(), cell_length(level));
+                                       });
+        }
+
+        /**
+         * Power iterations on D^{-1} A, starting from the highest frequency mode of the uniform grid.
+         * The affine part of A (boundary values) is removed by subtracting A 0.
+         */
+        void estimate_lambda_max(field_t& u)
+        {
+            auto& mesh = u.mesh();
+            auto& diag = *m_diagonal;
+
+            field_t zero = u;
+            zero.fill(0);
+            auto a_zero = apply(zero);
+
+            field_t v = u;
+            v.fill(0);
+            for_each_cell(mesh[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              v[cell] = (color(cell) == 0) ? 1 : -1;
+                          });
+
+            m_lambda_max = 0;
+            for (std::size_t it = 0; it < m_power_iterations; ++it)
+            {
+                double v_norm = cells_norm(v);
+                auto w        = apply(v);
+                parallel_for_each_interval(mesh,
+                                           [&](std::size_t level, const auto& i, const auto& index)
+                                           {
+                                               w(level, i, index) = (w(level, i, index) - a_zero(level, i, index)) / diag(level, i, index);
+                                           });
+                double w_norm = cells_norm(w);
+                m_lambda_max  = w_norm / v_norm;
+                parallel_for_each_interval(mesh,
+                                           [&](std::size_t level, const auto& i, const auto& index)
+                                           {
+                                               v(level, i, index) = w(level, i, index) / w_norm;
+                                           });
+            }
+        }
+
+        template <class Residual>
+        void relax(field_t& u, const Residual& r, double weight) const
+        {
+            auto& diag = *m_diagonal;
+            parallel_for_each_interval(u.mesh(),
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           u(level, i, index) += weight * r(level, i, index) / diag(level, i, index);
+                                       });
+        }
+
+        /**
+         * Updates in place the cells of one color: u_c += (rhs_c - (A u)_c) / D_c, (A u)_c being computed from the stored row.
+         */
+        void relax_color(field_t& u, const field_t& rhs, int c) const
+        {
+            auto* u_data          = u.array().data();
+            const auto* rhs_data  = rhs.array().data();
+            const auto* diag_data = m_diagonal->array().data();
+
+            auto first_row = m_color_rows[static_cast<std::size_t>(c)];
+            auto n_rows    = m_color_rows[static_cast<std::size_t>(c) + 1] - first_row;
+            auto relax_row = [&](std::size_t r)
+            {
+                auto row   = first_row + r;
+                auto cell  = m_row_cell[row];
+                double res = rhs_data[cell];
+                for (std::size_t k = m_row_ptr[row]; k < m_row_ptr[row + 1]; ++k)
+                {
+                    res -= m_values[k] * u_data[m_cols[k]];
+                }
+                u_data[cell] += res / diag_data[cell];
+            };
+            if (m_independent_colors)
+            {
+                parallel_for(execution::par, n_rows, relax_row);
+            }
+            else
+            {
+                parallel_for(execution::seq, n_rows, relax_row);
+            }
+        }
+
+        /**
+         * Chebyshev iterations preconditioned by the diagonal, on the interval [min_ratio * lambda_max, 1.1 * lambda_max].
+         */
+        void chebyshev(field_t& u, const field_t& rhs, std::size_t degree)
+        {
+            double lambda_max = 1.1 * m_lambda_max;
+            double lambda_min = m_chebyshev_min_ratio * m_lambda_max;
+            double theta      = (lambda_max + lambda_min) / 2;
+            double delta      = (lambda_max - lambda_min) / 2;
+            double sigma      = theta / delta;
+            double rho        = 1 / sigma;
+
+            auto& mesh = u.mesh();
+            auto& diag = *m_diagonal;
+
+            field_t d("chebyshev_direction", mesh);
+            d.fill(0);
+            auto r = residual(u, rhs);
+            parallel_for_each_interval(mesh,
+                                       [&](std::size_t level, const auto& i, const auto& index)
+                                       {
+                                           d(level, i, index) = r(level, i, index) / (theta * diag(level, i, index));
+                                           u(level, i, index) += d(level, i, index);
+                                       });
+            for (std::size_t k = 1; k < degree; ++k)
+            {
+                double rho_new = 1 / (2 * sigma - rho);
+                r              = residual(u, rhs);
+                parallel_for_each_interval(mesh,
+                                           [&](std::size_t level, const auto& i, const auto& index)
+                                           {
+                                               d(level, i, index) = rho_new * rho * d(level, i, index)
+                                                                  + 2 * rho_new / delta * r(level, i, index) / diag(level, i, index);
+                                               u(level, i, index) += d(level, i, index);
+                                           });
+                rho = rho_new;
+            }
+        }
+
+        template <class Field>
+        static double cells_norm(const Field& f)
+        {
+            double sum = 0;
+            for_each_interval(f.mesh()[mesh_id_t::cells],
+                              [&](std::size_t level, const auto& i, const auto& index)
+                              {
+                                  sum += xt::sum(xt::square(f(level, i, index)))();
+                              });
+            return std::sqrt(sum);
+        }
+    };
+
+    template <class Scheme>
+    auto make_smoother(const Scheme& scheme, SmootherType type = SmootherType::Jacobi)
+    {
+        return Smoother<Scheme>(scheme, type);
+    }
+
+} // end namespace samurai
@@ -0,0 +1,281 @@
+#pragma once
+#include <algorithm>
+#include <array>
+#include <cmath>
+
+#include <xtensor/xtensor.hpp>
+
+#include "../field_expression.hpp"
+#include "../numeric/field_row.hpp"
+#include "../operators_base.hpp"
+
+namespace samurai
+{
+    enum class WenoWeights
+    {
+        JS, // Jiang-Shu
+        Z   // WENO-Z (Borges et al.)
+    };
+
+    /**
+     * Fifth-order WENO reconstruction of the values v(k) of a line of cells at the faces k + 1/2.
+     *
+     * Each face uses the three substencils {k-2, k-1, k}, {k-1, k, k+1}, {k, k+1, k+2} from the left (u^-)
+     * and their mirrors {k+1, k+2, k+3}, {k, k+1, k+2}, {k-1, k, k+1} from the right (u^+).
+     * A substencil of 3 cells centred at t has three smoothness indicators (one per position in the stencils above),
+     * and each of them is used by exactly one u^- and one u^+: they are computed once per substencil, by chunks of faces,
+     * and shared by the faces.
+     */
+    template <WenoWeights weights = WenoWeights::JS>
+    class Weno5
+    {
+      public:
+
+        static constexpr std::size_t chunk_size = 64;
+
+        explicit Weno5(double eps = weights == WenoWeights::JS ? 1e-6 : 1e-40)
+            : m_eps(eps)
+        {
+        }
+
+        /**
+         * @brief Reconstructions at the faces k + 1/2, 0 <= k < n: minus[k] = u^-, plus[k] = u^+. v(k) must be defined for -2 <= k < n + 3.
+         */
+        template <class Values>
+        void reconstruct(const Values& v, std::size_t n, double* minus, double* plus) const
+        {
+            // Smoothness indicators of the substencils centred at t = k0 - 1 + s, stored at s
+            std::array<double, chunk_size + 3> beta_left;
+            std::array<double, chunk_size + 3> beta_mid;
+            std::array<double, chunk_size + 3> beta_right;
+
+            for (std::size_t k0 = 0; k0 < n; k0 += chunk_size)
+            {
+                std::size_t m = std::min(chunk_size, n - k0);
+                auto first    = static_cast<std::ptrdiff_t>(k0);
+                for (std::size_t s = 0; s < m + 3; ++s)
+                {
+                    auto t     = first - 1 + static_cast<std::ptrdiff_t>(s);
+                    double a   = v(t - 1);
+                    double b   = v(t);
+                    double c   = v(t + 1);
+                    double s13 = 13. / 12 * (a - 2 * b + c) * (a - 2 * b + c);
+
+                    beta_left[s]  = s13 + 0.25 * (a - 4 * b + 3 * c) * (a - 4 * b + 3 * c);
+                    beta_mid[s]   = s13 + 0.25 * (a - c) * (a - c);
+                    beta_right[s] = s13 + 0.25 * (3 * a - 4 * b + c) * (3 * a - 4 * b + c);
+                }
+
+                for (std::size_t s = 0; s < m; ++s)
+                {
+                    auto k = first + static_cast<std::ptrdiff_t>(s);
+
+                    double vm2 = v(k - 2);
+                    double vm1 = v(k - 1);
+                    double v0  = v(k);
+                    double vp1 = v(k + 1);
+                    double vp2 = v(k + 2);
+                    double vp3 = v(k + 3);
+
+                    minus[k0 + s] = combine(beta_left[s],
+                                            beta_mid[s + 1],
+                                            beta_right[s + 2],
+                                            1. / 3 * vm2 - 7. / 6 * vm1 + 11. / 6 * v0,
+                                            -1. / 6 * vm1 + 5. / 6 * v0 + 1. / 3 * vp1,
+                                            1. / 3 * v0 + 5. / 6 * vp1 - 1. / 6 * vp2);
+
+                    plus[k0 + s] = combine(beta_right[s + 3],
+                                           beta_mid[s + 2],
+                                           beta_left[s + 1],
+                                           1. / 3 * vp3 - 7. / 6 * vp2 + 11. / 6 * vp1,
+                                           -1. / 6 * vp2 + 5. / 6 * vp1 + 1. / 3 * v0,
+                                           1. / 3 * vp1 + 5. / 6 * v0 - 1. / 6 * vm1);
+                }
+            }
+        }
+
+        /**
+         * @brief Weighted combination of the candidate values p0, p1, p2 of the substencils with smoothness indicators b0, b1, b2.
+         * The linear weights are (1/10, 6/10, 3/10), substencil 0 being the farthest from the face.
+         */
+        double combine(double b0, double b1, double b2, double p0, double p1, double p2) const
+        {
+            double a0, a1, a2;
+            if constexpr (weights == WenoWeights::JS)
+            {
+                a0 = 0.1 / ((m_eps + b0) * (m_eps + b0));
+                a1 = 0.6 / ((m_eps + b1) * (m_eps + b1));
+                a2 = 0.3 / ((m_eps + b2) * (m_eps + b2));
+            }
+            else
+            {
+                double tau5 = std::abs(b0 - b2);
+                a0          = 0.1 * (1 + tau5 / (m_eps + b0));
+                a1          = 0.6 * (1 + tau5 / (m_eps + b1));
+                a2          = 0.3 * (1 + tau5 / (m_eps + b2));
+            }
+            return (a0 * p0 + a1 * p1 + a2 * p2) / (a0 + a1 + a2);
+        }
+
+      private:
+
+        double m_eps;
+    };
+
+    /**
+     * Upwind WENO5 approximation of vel . grad(phi) (Hamilton-Jacobi form, used for the transport of level sets).
+     * The one-sided derivatives of phi at a cell are the WENO5 reconstructions u^- and u^+ of the divided differences
+     * of phi at the face between the two differences that surround the cell.
+     * In the direction x, the differences and the reconstructions are computed on the whole row at once.
+     * In the other directions, only the upwind side is computed for each cell.
+     * phi must have 3 ghosts in each direction.
+     */
+    template <class TInterval, WenoWeights weights>
+    class weno5_advection_op : public field_operator_base<TInterval>,
+                               public field_expression<weno5_advection_op<TInterval, weights>>
+    {
+      public:
+
+        INIT_OPERATOR(weno5_advection_op)
+
+        template <class Field, class Vel>
+        inline auto operator()(Dim<1>, const Field& phi, const Vel& vel) const
+        {
+            return advection(phi, vel);
+        }
+
+        template <class Field, class Vel>
+        inline auto operator()(Dim<2>, const Field& phi, const Vel& vel) const
+        {
+            return advection(phi, vel, j);
+        }
+
+        template <class Field, class Vel>
+        inline auto operator()(Dim<3>, const Field& phi, const Vel& vel) const
+        {
+            return advection(phi, vel, j, k);
+        }
+
+      private:
+
+        template <class Field, class Vel, class... Index>
+        auto advection(const Field& phi, const Vel& vel, Index... index) const
+        {
+            static constexpr std::size_t dim = sizeof...(Index) + 1;
+            using value_t                    = typename interval_t::value_t;
+
+            Weno5<weights> weno;
+            const double inv_dx = 1. / dx();
+            const std::size_t n = i.size();
+            auto vel_row        = detail::make_field_row(vel, level, i, index...);
+
+            xt::xtensor<double, 1> result = xt::empty<double>({n});
+
+            // Direction x: differences (phi(x + 1) - phi(x)) / dx for i.start - 3 <= x < i.end + 2, stored in q(x - i.start + 3)
+            {
+                auto phi_row = detail::make_field_row(phi, level, interval_t{i.start - 3, i.end + 3}, index...);
+                xt::xtensor<double, 1> q = xt::empty<double>({n + 5});
+                for (std::size_t x = 0; x < n + 5; ++x)
+                {
+                    auto px = static_cast<std::ptrdiff_t>(x);
+                    q(x)    = (phi_row(px + 1, 0) - phi_row(px, 0)) * inv_dx;
+                }
+                xt::xtensor<double, 1> dphi_minus = xt::empty<double>({n});
+                xt::xtensor<double, 1> dphi_plus  = xt::empty<double>({n});
+                // The differences at the faces i.start + k - 1/2 and i.start + k + 1/2 surround the cell i.start + k
+                weno.reconstruct(
+                    [&](std::ptrdiff_t k)
+                    {
+                        return q(static_cast<std::size_t>(k + 2));
+                    },
+                    n,
+                    dphi_minus.data(),
+                    dphi_plus.data());
+                for (std::size_t c = 0; c < n; ++c)
+                {
+                    double u  = vel_row(static_cast<std::ptrdiff_t>(c), 0);
+                    result(c) = u * (u >= 0 ? dphi_minus(c) : dphi_plus(c));
+                }
+            }
+
+            // Directions y and z: the 7 rows phi(index + m e_d), -3 <= m <= 3
+            std::array<value_t, dim - 1> coords{static_cast<value_t>(index)...};
+            for (std::size_t d = 1; d < dim; ++d)
+            {
+                using row_t = decltype(detail::make_field_row(phi, level, i, index...));
+                std::array<row_t, 7> rows;
+                for (std::size_t r = 0; r < 7; ++r)
+                {
+                    auto shifted = coords;
+                    shifted[d - 1] += static_cast<value_t>(r) - 3;
+                    if constexpr (dim == 2)
+                    {
+                        rows[r] = detail::make_field_row(phi, level, i, shifted[0]);
+                    }
+                    else if constexpr (dim == 3)
+                    {
+                        rows[r] = detail::make_field_row(phi, level, i, shifted[0], shifted[1]);
+                    }
+                }
+
+                for (std::size_t c = 0; c < n; ++c)
+                {
+                    auto pc  = static_cast<std::ptrdiff_t>(c);
+                    double u = vel_row(pc, d);
+                    std::array<double, 6> q;
+                    for (std::size_t m = 0; m < 6; ++m)
+                    {
+                        q[m] = (rows[m + 1](pc, 0) - rows[m](pc, 0)) * inv_dx;
+                    }
+                    // Upwind side: q1, ..., q5 are the differences read in the direction of the velocity
+                    bool pos  = u >= 0;
+                    double q1 = pos ? q[0] : q[5];
+                    double q2 = pos ? q[1] : q[4];
+                    double q3 = pos ? q[2] : q[3];
+                    double q4 = pos ? q[3] : q[2];
+                    double q5 = pos ? q[4] : q[1];
+
+                    double s0  = 13. / 12 * (q1 - 2 * q2 + q3) * (q1 - 2 * q2 + q3);
+                    double s1  = 13. / 12 * (q2 - 2 * q3 + q4) * (q2 - 2 * q3 + q4);
+                    double s2  = 13. / 12 * (q3 - 2 * q4 + q5) * (q3 - 2 * q4 + q5);
+                    double is0 = s0 + 0.25 * (q1 - 4 * q2 + 3 * q3) * (q1 - 4 * q2 + 3 * q3);
+                    double is1 = s1 + 0.25 * (q2 - q4) * (q2 - q4);
+                    double is2 = s2 + 0.25 * (3 * q3 - 4 * q4 + q5) * (3 * q3 - 4 * q4 + q5);
+
+                    double dphi = weno.combine(is0,
+                                               is1,
+                                               is2,
+                                               1. / 3 * q1 - 7. / 6 * q2 + 11. / 6 * q3,
+                                               -1. / 6 * q2 + 5. / 6 * q3 + 1. / 3 * q4,
+                                               1. / 3 * q3 + 5. / 6 * q4 - 1. / 6 * q5);
+                    result(c) += u * dphi;
+                }
+            }
+            return result;
+        }
+    };
+
+    template <class TInterval>
+    using weno5_op = weno5_advection_op<TInterval, WenoWeights::JS>;
+
+    template <class TInterval>
+    using weno5z_op = weno5_advection_op<TInterval, WenoWeights::Z>;
+
+    /**
+     * @brief Upwind WENO5 approximation of vel . grad(phi), with the Jiang-Shu weights.
+     */
+    template <class Field, class Vel>
+    inline auto weno5(const Field& phi, const Vel& vel)
+    {
+        return make_field_operator_function<weno5_op>(phi, vel);
+    }
+
+    /**
+     * @brief Upwind WENO5 approximation of vel . grad(phi), with the WENO-Z weights.
+     */
+    template <class Field, class Vel>
+    inline auto weno5z(const Field& phi, const Vel& vel)
+    {
+        return make_field_operator_function<weno5z_op>(phi, vel);
+    }
+}
@@ -159,6 +159,16 @@ namespace samurai
         {
         };
 
+        template <class T>
+        struct is_field_operator_function : std::false_type
+        {
+        };
+
+        template <template <class T> class OP, class... CT>
+        struct is_field_operator_function<field_operator_function<OP, CT...>> : std::true_type
+        {
+        };
+
         template <class... T>
         auto& extract_mesh(const std::tuple<T...>& t)
         {
@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cmath>
+
+#include <samurai/bc.hpp>
+#include <samurai/box.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    /**
+     * @brief Mesh of the unit box adapted to the smooth front tanh(50 (x - front)), so that it has several levels with
+     * projection and prediction ghosts. Shared by the tests and the benchmarks of the schemes and of the solvers.
+     */
+    template <std::size_t dim = 2>
+    MRMesh<MRConfig<dim>> adapted_mesh(std::size_t min_level, std::size_t max_level, double front = 0.4, double eps = 1e-3)
+    {
+        using point_t = typename Box<double, dim>::point_t;
+        point_t min_corner;
+        point_t max_corner;
+        min_corner.fill(0.);
+        max_corner.fill(1.);
+        Box<double, dim> box(min_corner, max_corner);
+        MRMesh<MRConfig<dim>> mesh{box, min_level, max_level};
+
+        auto u = make_field<double, 1>("u", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::tanh(50 * (cell.center(0) - front));
+                      });
+        make_bc<Neumann>(u, 0.);
+        auto MRadaptation = make_MRAdapt(u);
+        MRadaptation(eps, 1.);
+        return mesh;
+    }
+}
@@ -1,10 +1,90 @@
+#include <algorithm>
+#include <cmath>
+
 #include <gtest/gtest.h>
 
+#include <samurai/bc.hpp>
 #include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
 #include <samurai/uniform_mesh.hpp>
 
 namespace samurai
 {
+    namespace
+    {
+        using bc_mesh_t = MRMesh<MRConfig<2>>;
+
+        // Level 3 on the left half and level 4 on the right half of the unit square
+        auto two_level_bc_mesh()
+        {
+            typename bc_mesh_t::cl_type cl;
+            for (int j = 0; j < 8; ++j)
+            {
+                cl[3][{j}].add_interval({0, 4});
+            }
+            for (int j = 0; j < 16; ++j)
+            {
+                cl[4][{j}].add_interval({8, 16});
+            }
+            return bc_mesh_t(cl, 3, 4);
+        }
+
+        // Ghosts a(level) * value + b * mirror of the bc, computed interval by interval on the subsets of the ghost layers
+        template <class Field, class Coeff>
+        void mirror_ghosts_by_subsets(Bc<Field>& bc, Field& field, Coeff&& a, double b)
+        {
+            using mesh_id_t           = typename Field::mesh_t::mesh_id_t;
+            using interval_t          = typename Field::interval_t;
+            constexpr int ghost_width = std::max(static_cast<int>(Field::mesh_t::config::max_stencil_width),
+                                                 static_cast<int>(Field::mesh_t::config::prediction_order));
+
+            const auto& mesh = field.mesh()[mesh_id_t::reference];
+            auto region      = bc.get_region();
+            auto& direction  = region.first;
+            auto& lca        = region.second;
+            for (std::size_t level = mesh.min_level(); level <= mesh.max_level(); ++level)
+            {
+                for (std::size_t d = 0; d < direction.size(); ++d)
+                {
+                    std::size_t delta_l = lca[d].level() - level;
+                    for (int ig = 0; ig < ghost_width; ++ig)
+                    {
+                        DirectionVector<2> m = (2 * ig + 1) * direction[d];
+                        auto boundary_layer  = translate(lca[d], (ig + 1) * (direction[d] << delta_l));
+                        auto ghosts          = intersection(intersection(mesh[level], boundary_layer), translate(mesh[level], m)).on(level);
+                        ghosts(
+                            [&](const auto& i, const auto& index)
+                            {
+                                auto j = index[0];
+                                if (bc.get_value_type() == BCVType::function)
+                                {
+                                    bc.update_values(direction[d], level, i, index);
+                                }
+                                for (auto x = i.start; x < i.end; ++x)
+                                {
+                                    interval_t ix{x, x + 1};
+                                    double value = (bc.get_value_type() == BCVType::constant)
+                                                     ? bc.constant_value()
+                                                     : bc.value()(static_cast<std::ptrdiff_t>(x - i.start), 0);
+                                    field(level, ix, j)[0] = a(level) * value + b * field(level, ix - m[0], j - m[1])[0];
+                                }
+                            });
+                    }
+                }
+            }
+        }
+
+        template <class Field>
+        void init_bc_test(Field& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              u[cell] = std::sin(5 * cell.center(0)) + cell.center(1);
+                          });
+        }
+    }
+
     TEST(bc, scalar_homogeneous)
     {
         static constexpr std::size_t dim = 1;
@@ -26,4 +106,139 @@ namespace samurai
         make_bc<Dirichlet>(u);
         EXPECT_EQ(u.get_bc()[0]->constant_value(), xt::zeros<double>({4}));
     }
+
+    TEST(bc, function_and_batch_function)
+    {
+        using mesh_t = MRMesh<MRConfig<1>>;
+        mesh_t mesh{Box<double, 1>({0.}, {1.}), 3, 3};
+
+        auto u = make_field<double, 1>("u", mesh);
+        auto v = make_field<double, 1>("v", mesh);
+        u.fill(0.);
+        v.fill(0.);
+
+        make_bc<Dirichlet>(u,
+                           [](const auto&, const auto& coords)
+                           {
+                               return coords[0] + 1;
+                           });
+        make_batch_bc<Dirichlet>(v,
+                                 [](const auto& points, const auto& values)
+                                 {
+                                     for (std::size_t x = 0; x < points.size(); ++x)
+                                     {
+                                         values(static_cast<std::ptrdiff_t>(x), 0) = points.coords[0][x] + 1;
+                                     }
+                                 });
+        update_bc(u);
+        update_bc(v);
+
+        // Ghosts 2 g - mirror, with g the value at the boundary point
+        using interval_t = typename mesh_t::interval_t;
+        EXPECT_DOUBLE_EQ(u(3, interval_t{-1, 0})[0], 2.);
+        EXPECT_DOUBLE_EQ(u(3, interval_t{8, 9})[0], 4.);
+        EXPECT_DOUBLE_EQ(v(3, interval_t{-1, 0})[0], 2.);
+        EXPECT_DOUBLE_EQ(v(3, interval_t{8, 9})[0], 4.);
+    }
+
+    TEST(bc, batch_function_single_value)
+    {
+        using mesh_t = MRMesh<MRConfig<1>>;
+        mesh_t mesh{Box<double, 1>({0.}, {1.}), 3, 3};
+        auto u = make_field<double, 1>("u", mesh);
+
+        int ghost_index = 0;
+        int direction   = 0;
+        make_batch_bc<Dirichlet>(u,
+                                 [&](const auto& points, const auto& values)
+                                 {
+                                     ghost_index  = points.i.start;
+                                     direction    = points.direction[0];
+                                     values(0, 0) = points.coords[0][0];
+                                 });
+        auto& bc = u.get_bc()[0];
+
+        // Left ghost, whose outward direction is given
+        typename decltype(u)::cell_t ghost(3, {-1}, 0);
+        EXPECT_DOUBLE_EQ(bc->value(ghost, {-1}, {0.}), 0.);
+        EXPECT_EQ(ghost_index, -1);
+        EXPECT_EQ(direction, -1);
+
+        // Right ghost, whose outward direction is found from the boundary point on its face
+        typename decltype(u)::cell_t right_ghost(3, {8}, 0);
+        EXPECT_DOUBLE_EQ(bc->value(right_ghost, {1.}), 1.);
+        EXPECT_EQ(ghost_index, 8);
+        EXPECT_EQ(direction, 1);
+    }
+
+    TEST(bc, precomputed_ghosts_as_by_subsets)
+    {
+        auto mesh = two_level_bc_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        auto ref  = make_field<double, 1>("ref", mesh);
+
+        auto check = [&](auto&& a, double b)
+        {
+            u.fill(-1.);
+            init_bc_test(u);
+            ref.array() = u.array();
+            mirror_ghosts_by_subsets(*ref.get_bc()[0], ref, a, b);
+            update_bc(u);
+            EXPECT_EQ(u.array(), ref.array());
+        };
+        auto two = [](std::size_t)
+        {
+            return 2.;
+        };
+
+        make_bc<Dirichlet>(u, 2.);
+        make_bc<Dirichlet>(ref, 2.);
+        check(two, -1.);
+
+        auto g = [](const auto&, const auto& coords)
+        {
+            return coords[0] + 2 * coords[1];
+        };
+        u.get_bc().clear();
+        ref.get_bc().clear();
+        make_bc<Dirichlet>(u, g);
+        make_bc<Dirichlet>(ref, g);
+        check(two, -1.);
+
+        u.get_bc().clear();
+        ref.get_bc().clear();
+        make_bc<Neumann>(u, 3.);
+        make_bc<Neumann>(ref, 3.);
+        check(
+            [](std::size_t level)
+            {
+                return 1. / (1 << level);
+            },
+            1.);
+    }
+
+    TEST(bc, ghost_lists_follow_the_mesh)
+    {
+        auto mesh = two_level_bc_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 0.);
+        auto& bc = *u.get_bc()[0];
+
+        // Built once per level and reused
+        const auto& ghosts = bc.ghosts(mesh, 4);
+        EXPECT_GT(ghosts.size(), std::size_t{0});
+        EXPECT_EQ(&bc.ghosts(mesh, 4), &ghosts);
+        std::size_t n_ghosts = ghosts.size();
+
+        // Another mesh has another generation: the list is rebuilt
+        bc_mesh_t uniform{Box<double, 2>({0., 0.}, {1., 1.}), 4, 4};
+        ASSERT_NE(uniform.generation(), mesh.generation());
+        EXPECT_GT(bc.ghosts(uniform, 4).size(), n_ghosts);
+        EXPECT_EQ(bc.ghosts(mesh, 4).size(), n_ghosts);
+
+        // Changing the region drops the lists
+        DirectionVector<2> right = {1, 0};
+        bc.on(right);
+        EXPECT_LT(bc.ghosts(mesh, 4).size(), n_ghosts);
+    }
 }
@@ -0,0 +1,156 @@
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <xtensor/xarray.hpp>
+#include <xtensor/xview.hpp>
+
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/numeric/error.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using mesh_t    = MRMesh<MRConfig<2>>;
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        // Left half of the unit square on the level 3, right half on the level 4
+        auto two_level_mesh()
+        {
+            typename mesh_t::cl_type cl;
+            for (int j = 0; j < 8; ++j)
+            {
+                cl[3][{j}].add_interval({0, 4});
+            }
+            for (int j = 0; j < 16; ++j)
+            {
+                cl[4][{j}].add_interval({8, 16});
+            }
+            return mesh_t(cl, 3, 4);
+        }
+
+        // x + y on a batch of points
+        auto x_plus_y = batch(
+            [](const auto& x)
+            {
+                return xt::eval(xt::view(x, 0, xt::all()) + xt::view(x, 1, xt::all()));
+            });
+
+        struct partial_sum
+        {
+            detail::compensated_sum sum;
+        };
+    }
+
+    TEST(error, norms_of_a_polynomial)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        u.fill(0);
+
+        // The error is x + y, whose square has the degree 2 in each direction: exact with 2 points
+        auto result = compute_error_norms(u, x_plus_y, GaussLegendre<3>{});
+        EXPECT_NEAR(result.error.L1, 1., 1e-14);
+        EXPECT_NEAR(result.error.L2, std::sqrt(7. / 6.), 1e-14);
+        EXPECT_GT(result.error.Linf, 1.9);
+        EXPECT_LT(result.error.Linf, 2.);
+        EXPECT_DOUBLE_EQ(result.solution.L2, result.error.L2);
+        EXPECT_NEAR(result.relative().L2, 1., 1e-14);
+
+        // Left half: mean of x + y is 3/4, right half: 5/4
+        ASSERT_EQ(result.error_by_level.size(), std::size_t{5});
+        EXPECT_NEAR(result.error_by_level[3].L1, 0.5 * 0.75, 1e-14);
+        EXPECT_NEAR(result.error_by_level[4].L1, 0.5 * 1.25, 1e-14);
+        EXPECT_NEAR(std::pow(result.error_by_level[3].L2, 2) + std::pow(result.error_by_level[4].L2, 2), 7. / 6., 1e-14);
+
+        // The evaluation point by point gives the same norms
+        auto pointwise_result = compute_error_norms(
+            u,
+            [](const auto& point)
+            {
+                return point[0] + point[1];
+            },
+            GaussLegendre<3>{});
+        EXPECT_DOUBLE_EQ(pointwise_result.error.L1, result.error.L1);
+        EXPECT_DOUBLE_EQ(pointwise_result.error.L2, result.error.L2);
+        EXPECT_DOUBLE_EQ(pointwise_result.error.Linf, result.error.Linf);
+    }
+
+    TEST(error, L2_error_is_the_L2_norm_with_one_point)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::sin(cell.center(0)) + cell.center(1);
+                      });
+
+        auto result = compute_error_norms(u, x_plus_y, GaussLegendre<0>{});
+        EXPECT_DOUBLE_EQ(L2_error(u, x_plus_y), result.error.L2);
+        EXPECT_DOUBLE_EQ(L2_error<true>(u, x_plus_y), result.error.L2 / result.solution.L2);
+    }
+
+    TEST(error, reduction_independent_of_the_policy)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::exp(cell.center(0) * cell.center(1));
+                      });
+
+        auto accumulate = [](partial_sum& p, double weight, double, double e)
+        {
+            p.sum.add(weight * e * e);
+        };
+        auto exact        = x_plus_y;
+        auto sequential   = detail::reduce_on_nodes<partial_sum>(execution::seq, u, exact, GaussLegendre<5>{}, accumulate);
+        auto thread_pool  = detail::reduce_on_nodes<partial_sum>(execution::thread_pool, u, exact, GaussLegendre<5>{}, accumulate);
+        auto default_pool = detail::reduce_on_nodes<partial_sum>(execution::par, u, exact, GaussLegendre<5>{}, accumulate);
+
+        // Same blocks, with bitwise identical partial sums
+        ASSERT_EQ(thread_pool.size(), sequential.size());
+        ASSERT_EQ(default_pool.size(), sequential.size());
+        for (std::size_t b = 0; b < sequential.size(); ++b)
+        {
+            EXPECT_EQ(thread_pool[b].first, sequential[b].first);
+            EXPECT_EQ(thread_pool[b].second.sum.value(), sequential[b].second.sum.value());
+            EXPECT_EQ(default_pool[b].second.sum.value(), sequential[b].second.sum.value());
+        }
+    }
+
+    TEST(error, vector_exact_solution)
+    {
+        auto mesh = two_level_mesh();
+        auto v    = make_field<double, 2>("v", mesh);
+        v.fill(0);
+
+        // Function of a point returning a vector, evaluated point by point as in the demos
+        auto exact = [](const auto& point)
+        {
+            return xt::xtensor_fixed<double, xt::xshape<2>>{point[0], point[1]};
+        };
+        auto result = compute_error_norms(v, exact, GaussLegendre<3>{});
+        EXPECT_NEAR(result.error.L1, 1., 1e-14);
+        EXPECT_NEAR(L2_error(v, exact), std::sqrt(2. / 3.), 1e-2);
+
+        // A batch of the values of a scalar for a vector field is rejected instead of being read out of bounds
+        // (at compile time if the rank of the values is static)
+        auto scalar_batch = batch(
+            [](const auto& x)
+            {
+                return xt::xarray<double>(xt::view(x, 0, xt::all()));
+            });
+        auto accumulate = [](partial_sum& p, double weight, double, double e)
+        {
+            p.sum.add(weight * e * e);
+        };
+        EXPECT_THROW(detail::reduce_on_nodes<partial_sum>(execution::seq, v, scalar_batch, GaussLegendre<3>{}, accumulate),
+                     std::runtime_error);
+    }
+}
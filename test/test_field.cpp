@@ -1,10 +1,12 @@
 #include <algorithm>
+#include <cmath>
 
 #include <gtest/gtest.h>
 
 #include <samurai/box.hpp>
 #include <samurai/field.hpp>
 #include <samurai/mr/mesh.hpp>
+#include <samurai/stencil_field.hpp>
 #include <samurai/uniform_mesh.hpp>
 
 namespace samurai
@@ -120,4 +122,85 @@ namespace samurai
         u.name() = "new_name";
         EXPECT_EQ(u.name(), "new_name");
     }
+
+    TEST(field, parallel_assignment)
+    {
+        using mesh_t = MRMesh<MRConfig<2>>;
+        mesh_t mesh{Box<double, 2>({0., 0.}, {1., 1.}), 7, 7};
+        auto u = make_field<double, 1>("u", mesh);
+        auto v = make_field<double, 1>("v", mesh);
+        auto w = make_field<double, 1>("w", mesh);
+        auto z = make_field<double, 1>("z", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::sin(cell.center(0));
+                          v[cell] = cell.center(1);
+                      });
+
+        auto expect_assigned = [&]()
+        {
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              EXPECT_EQ(w[cell], u[cell] + 2 * v[cell]);
+                              EXPECT_EQ(z[cell], u[cell] * v[cell]);
+                          });
+        };
+
+        w.fill(0);
+        w.assign(execution::thread_pool, u + 2 * v);
+        z.assign(execution::openmp, u * v);
+        expect_assigned();
+
+        w.fill(0);
+        z.fill(0);
+        Field_tuple<decltype(w), decltype(z)> wz(w, z);
+        wz.assign(execution::thread_pool, u + 2 * v, u * v);
+        expect_assigned();
+    }
+
+    TEST(field, in_place_stencil_assignment)
+    {
+        // A single interval of 4 chunks
+        using mesh_t = MRMesh<MRConfig<1>>;
+        mesh_t mesh{Box<double, 1>({0.}, {1.}), 14, 14};
+        auto u = make_field<double, 1>("u", mesh);
+        auto v = make_field<double, 1>("v", mesh);
+        u.fill(0);
+        v.fill(1);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          u[cell] = std::sin(10 * cell.center(0));
+                      });
+
+        const void* data = u.array().data();
+        EXPECT_FALSE(detail::reads_neighbours_of(u + 2 * v, data));
+        EXPECT_FALSE(detail::reads_neighbours_of(v - upwind(1., v), data));
+        EXPECT_TRUE(detail::reads_neighbours_of(upwind(1., u), data));
+        EXPECT_TRUE(detail::reads_neighbours_of(v - 0.5 * upwind(1., u), data));
+
+        // The in place update reads the old values of the neighbours, as with a destination of its own
+        auto expected = make_field<double, 1>("expected", mesh);
+        expected      = u - 0.5 * upwind(1., u);
+        u.assign(execution::thread_pool, u - 0.5 * upwind(1., u));
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(u[cell], expected[cell]);
+                      });
+
+        auto w = make_field<double, 1>("w", mesh);
+        w.fill(0);
+        Field_tuple<decltype(u), decltype(w)> uw(u, w);
+        expected = u - 0.5 * upwind(1., u);
+        uw.assign(execution::thread_pool, u - 0.5 * upwind(1., u), 2 * v);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(u[cell], expected[cell]);
+                          EXPECT_EQ(w[cell], 2.);
+                      });
+    }
 }
@@ -0,0 +1,157 @@
+#include <cmath>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <xtensor/xview.hpp>
+
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using mesh_t    = MRMesh<MRConfig<2>>;
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        // Left half of the unit square on the level 2, right half on the level 3
+        auto two_level_mesh()
+        {
+            typename mesh_t::cl_type cl;
+            for (int j = 0; j < 4; ++j)
+            {
+                cl[2][{j}].add_interval({0, 2});
+            }
+            for (int j = 0; j < 8; ++j)
+            {
+                cl[3][{j}].add_interval({4, 8});
+            }
+            return mesh_t(cl, 2, 3);
+        }
+
+        // Mean of x^p on [a, b]
+        double mean_of_power(double a, double b, int p)
+        {
+            return (std::pow(b, p + 1) - std::pow(a, p + 1)) / ((p + 1) * (b - a));
+        }
+
+        // Means of x^p y^p + x^p + 1 with n points in each direction, for p = 2n - 1
+        template <std::size_t n_points>
+        void expect_exact_means()
+        {
+            constexpr std::size_t degree = 2 * n_points - 1;
+            constexpr int p              = static_cast<int>(degree);
+
+            auto mesh = two_level_mesh();
+            GaussLegendre<degree> gl;
+            EXPECT_EQ(gl.nb_nodes(2), n_points * n_points);
+
+            auto batch_f = [&](const auto& x)
+            {
+                auto x0 = xt::view(x, 0, xt::all());
+                auto x1 = xt::view(x, 1, xt::all());
+                return xt::eval(xt::pow(x0, p) * xt::pow(x1, p) + xt::pow(x0, p) + 1.);
+            };
+            auto point_f = [&](const auto& point)
+            {
+                return std::pow(point[0], p) * std::pow(point[1], p) + std::pow(point[0], p) + 1.;
+            };
+            auto u = make_field<double, 1>("u", mesh, batch(batch_f), gl);
+            auto v = make_field<double, 1>("v", mesh, point_f, gl);
+
+            for_each_cell(mesh[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              auto corner   = cell.corner();
+                              double mean_x = mean_of_power(corner[0], corner[0] + cell.length, p);
+                              double mean_y = mean_of_power(corner[1], corner[1] + cell.length, p);
+                              double exact  = mean_x * mean_y + mean_x + 1;
+                              EXPECT_NEAR(u[cell], exact, 1e-13);
+                              EXPECT_NEAR(v[cell], exact, 1e-13);
+                          });
+        }
+    }
+
+    TEST(gauss_legendre, exact_for_degree_2n_minus_1)
+    {
+        expect_exact_means<1>();
+        expect_exact_means<2>();
+        expect_exact_means<3>();
+        expect_exact_means<4>();
+    }
+
+    TEST(gauss_legendre, vector_batch)
+    {
+        auto mesh = two_level_mesh();
+        GaussLegendre<3> gl;
+
+        // (x^3, x y^2), one row per node
+        auto f = [](const auto& x)
+        {
+            std::size_t n                 = x.shape()[1];
+            xt::xtensor<double, 2> values = xt::empty<double>({n, std::size_t{2}});
+            for (std::size_t c = 0; c < n; ++c)
+            {
+                values(c, 0) = std::pow(x(0, c), 3);
+                values(c, 1) = x(0, c) * x(1, c) * x(1, c);
+            }
+            return values;
+        };
+        auto u = make_field<2>("u", mesh, batch(f), gl);
+
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          auto corner = cell.corner();
+                          double x1   = corner[0] + cell.length;
+                          double y1   = corner[1] + cell.length;
+                          EXPECT_NEAR(u[cell][0], mean_of_power(corner[0], x1, 3), 1e-14);
+                          EXPECT_NEAR(u[cell][1], mean_of_power(corner[0], x1, 1) * mean_of_power(corner[1], y1, 2), 1e-14);
+                      });
+    }
+
+    TEST(gauss_legendre, vector_function_of_a_point)
+    {
+        auto mesh = two_level_mesh();
+        GaussLegendre<3> gl;
+
+        // Not marked by batch(): evaluated point by point, even though it returns an array
+        auto f = [](const auto& point)
+        {
+            return xt::xtensor_fixed<double, xt::xshape<2>>{point[0] * point[0], 1.};
+        };
+        auto u = make_field<2>("u", mesh, f, gl);
+
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          auto corner = cell.corner();
+                          EXPECT_NEAR(u[cell][0], mean_of_power(corner[0], corner[0] + cell.length, 2), 1e-14);
+                          EXPECT_NEAR(u[cell][1], 1., 1e-14);
+                      });
+    }
+
+    TEST(gauss_legendre, batch_of_the_wrong_size)
+    {
+        GaussLegendre<3> gl;
+        using interval_t = typename mesh_t::interval_t;
+        xt::xtensor_fixed<typename interval_t::value_t, xt::xshape<1>> index{0};
+
+        // One value per cell instead of one per node
+        auto one_per_cell = batch(
+            [](const auto& x)
+            {
+                return xt::xtensor<double, 1>(xt::zeros<double>({x.shape()[1] / 4}));
+            });
+        EXPECT_THROW(gl.quadrature<1>(2, interval_t{0, 4}, index, one_per_cell), std::runtime_error);
+
+        // Scalar values for a vector of size 2
+        auto scalars = batch(
+            [](const auto& x)
+            {
+                return xt::xtensor<double, 2>(xt::zeros<double>({x.shape()[1], std::size_t{1}}));
+            });
+        EXPECT_THROW(gl.quadrature<2>(2, interval_t{0, 4}, index, scalars), std::runtime_error);
+    }
+}
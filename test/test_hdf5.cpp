@@ -0,0 +1,146 @@
+#include <filesystem>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <samurai/field.hpp>
+#include <samurai/hdf5.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        // Two levels: the left half of the square on the level 1, the right half on the level 2
+        auto two_level_mesh()
+        {
+            using Config = MRConfig<2>;
+            using mesh_t = MRMesh<Config>;
+
+            typename mesh_t::cl_type cl;
+            for (int j = 0; j < 2; ++j)
+            {
+                cl[1][{j}].add_interval({0, 1});
+            }
+            for (int j = 0; j < 4; ++j)
+            {
+                cl[2][{j}].add_interval({2, 4});
+            }
+            return mesh_t(cl, 1, 2);
+        }
+
+        template <class Field>
+        std::vector<typename Field::value_type> expected_values(const Field& u, std::size_t item)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+
+            std::vector<typename Field::value_type> values;
+            for_each_cell(u.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              if constexpr (Field::size == 1)
+                              {
+                                  values.push_back(u[cell]);
+                              }
+                              else
+                              {
+                                  values.push_back(u[cell][item]);
+                              }
+                          });
+            return values;
+        }
+
+        template <class Field>
+        void fill(Field& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              if constexpr (Field::size == 1)
+                              {
+                                  u[cell] = static_cast<double>(cell.index);
+                              }
+                              else
+                              {
+                                  for (std::size_t item = 0; item < Field::size; ++item)
+                                  {
+                                      u[cell][item] = static_cast<double>(10 * cell.index + item);
+                                  }
+                              }
+                          });
+        }
+
+        template <class Field>
+        void check_round_trip(const Field& u, const std::string& filename)
+        {
+            auto path = std::filesystem::temp_directory_path();
+            save(path, filename, u.mesh(), u);
+
+            HighFive::File file((path / (filename + ".h5")).string(), HighFive::File::ReadOnly);
+            for (std::size_t item = 0; item < Field::size; ++item)
+            {
+                std::string name = (Field::size == 1) ? u.name() : fmt::format("{}_{}", u.name(), item);
+                std::vector<typename Field::value_type> values;
+                file.getDataSet(fmt::format("/mesh/fields/{}", name)).read(values);
+                EXPECT_EQ(values, expected_values(u, item));
+            }
+        }
+    }
+
+    TEST(hdf5, scalar_field_round_trip)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        fill(u);
+        check_round_trip(u, "samurai_test_hdf5_scalar");
+    }
+
+    TEST(hdf5, aos_field_round_trip)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 3, false>("u", mesh);
+        fill(u);
+        check_round_trip(u, "samurai_test_hdf5_aos");
+    }
+
+    TEST(hdf5, soa_field_round_trip)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 3, true>("u", mesh);
+        fill(u);
+        check_round_trip(u, "samurai_test_hdf5_soa");
+    }
+
+    TEST(hdf5, restricted_output)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        fill(u);
+
+        using mesh_t    = decltype(mesh);
+        using options_t = Hdf5Options<typename mesh_t::base_type>;
+        options_t options;
+        options.min_level = 2;
+        options.region    = Box<double, 2>({0.5, 0.}, {1., 0.5});
+
+        auto path = std::filesystem::temp_directory_path();
+        save(path, "samurai_test_hdf5_restricted", options, mesh, u);
+
+        std::vector<double> expected;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto center = cell.center();
+                          if (cell.level == 2 && center[0] > 0.5 && center[1] < 0.5)
+                          {
+                              expected.push_back(u[cell]);
+                          }
+                      });
+
+        HighFive::File file((path / "samurai_test_hdf5_restricted.h5").string(), HighFive::File::ReadOnly);
+        std::vector<double> values;
+        file.getDataSet("/mesh/fields/u").read(values);
+        EXPECT_EQ(expected.size(), 4u);
+        EXPECT_EQ(values, expected);
+    }
+}
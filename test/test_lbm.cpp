@@ -0,0 +1,281 @@
+#include <array>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/field.hpp>
+#include <samurai/lbm.hpp>
+#include <samurai/mr/mesh.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        template <std::size_t dim>
+        auto periodic_mesh(std::size_t level)
+        {
+            using point_t = typename Box<double, dim>::point_t;
+            point_t min_corner;
+            point_t max_corner;
+            min_corner.fill(0.);
+            max_corner.fill(1.);
+            std::array<bool, dim> periodic;
+            periodic.fill(true);
+            return MRMesh<MRConfig<dim>>({min_corner, max_corner}, level, level, periodic);
+        }
+
+        // Integral over the domain of each moment of the distribution functions
+        template <class Lattice, class Field>
+        auto integrated_moments(const Lattice& lattice, const Field& f)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+
+            std::array<double, Lattice::nvel> moments{};
+            for_each_cell(f.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              double volume = std::pow(cell.length, static_cast<double>(Lattice::dim));
+                              for (std::size_t p = 0; p < Lattice::nvel; ++p)
+                              {
+                                  for (std::size_t alpha = 0; alpha < Lattice::nvel; ++alpha)
+                                  {
+                                      moments[p] += volume * lattice.moments()[p][alpha] * f[cell][alpha];
+                                  }
+                              }
+                          });
+            return moments;
+        }
+
+        // D1Q2 relaxing lambda * momentum to 0.2 * density
+        auto d1q2_collision()
+        {
+            return lbm::make_mrt<2>({0., 1.5},
+                                    [](const std::array<double, 2>& m, std::array<double, 2>& m_eq)
+                                    {
+                                        m_eq[0] = m[0];
+                                        m_eq[1] = 0.2 * m[0];
+                                    });
+        }
+    }
+
+    TEST(lbm, d1q2_streaming_is_a_shift)
+    {
+        auto mesh    = periodic_mesh<1>(5);
+        auto f       = make_field<double, 2>("f", mesh);
+        auto lattice = lbm::D1Q2(1.);
+        lbm::scheme<decltype(lattice)> scheme(lattice);
+
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          f[cell][0] = static_cast<double>(cell.indices[0]);
+                          f[cell][1] = static_cast<double>(100 + cell.indices[0]);
+                      });
+
+        // No relaxation: the step is the streaming alone
+        auto no_collision = [](std::array<double, 2>&) {};
+        const int n_steps = 3;
+        for (int k = 0; k < n_steps; ++k)
+        {
+            scheme.step(f, no_collision);
+        }
+
+        const int n = 1 << 5;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          int i = cell.indices[0];
+                          EXPECT_DOUBLE_EQ(f[cell][0], static_cast<double>((i - n_steps + n) % n));
+                          EXPECT_DOUBLE_EQ(f[cell][1], static_cast<double>(100 + (i + n_steps) % n));
+                      });
+    }
+
+    TEST(lbm, d1q2_conserves_the_density)
+    {
+        auto mesh    = periodic_mesh<1>(6);
+        auto f       = make_field<double, 2>("f", mesh);
+        auto lattice = lbm::D1Q2(1.);
+        lbm::scheme<decltype(lattice)> scheme(lattice);
+
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          double rho = 1. + 0.5 * std::sin(2 * std::acos(-1.) * cell.center(0));
+                          f[cell][0] = 0.7 * rho;
+                          f[cell][1] = 0.3 * rho;
+                      });
+
+        auto initial   = integrated_moments(lattice, f);
+        auto collision = d1q2_collision();
+        for (int k = 0; k < 50; ++k)
+        {
+            scheme.step(f, collision);
+        }
+        auto final = integrated_moments(lattice, f);
+
+        EXPECT_NEAR(final[0], initial[0], 1e-12);
+        EXPECT_NE(final[1], initial[1]);
+    }
+
+    TEST(lbm, block_and_cell_collisions_agree)
+    {
+        auto mesh    = periodic_mesh<1>(5);
+        auto lattice = lbm::D1Q2(1.);
+        lbm::scheme<decltype(lattice)> scheme(lattice);
+
+        auto init = [&](auto& f)
+        {
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              f[cell][0] = 1. + cell.center(0);
+                              f[cell][1] = 0.5 * cell.center(0) * cell.center(0);
+                          });
+        };
+        auto f_cell = make_field<double, 2>("f_cell", mesh);
+        auto f_eq   = make_field<double, 2>("f_eq", mesh);
+        auto f_mrt  = make_field<double, 2>("f_mrt", mesh);
+        init(f_cell);
+        init(f_eq);
+        init(f_mrt);
+
+        // Generic lambdas: the kind of the function is given by block(), not guessed from its call operator
+        auto cell_collision = [](auto& m)
+        {
+            m[1] += 1.5 * (0.2 * m[0] - m[1]);
+        };
+        auto block_equilibrium = lbm::block(
+            [](const auto& m, const auto& m_eq)
+            {
+                for (std::size_t x = 0; x < m.n; ++x)
+                {
+                    m_eq(0, x) = m(0, x);
+                    m_eq(1, x) = 0.2 * m(0, x);
+                }
+            });
+        auto mrt_collision = lbm::make_mrt<2>({0., 1.5}, block_equilibrium);
+        static_assert(!lbm::detail::is_block_v<decltype(cell_collision)>);
+        static_assert(lbm::detail::is_block_v<decltype(block_equilibrium)>);
+        static_assert(lbm::detail::is_block_v<decltype(mrt_collision)>);
+
+        for (int k = 0; k < 10; ++k)
+        {
+            scheme.step(f_cell, cell_collision);
+            scheme.step(f_eq, d1q2_collision());
+            scheme.step(f_mrt, mrt_collision);
+        }
+
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          for (std::size_t alpha = 0; alpha < 2; ++alpha)
+                          {
+                              EXPECT_NEAR(f_eq[cell][alpha], f_cell[cell][alpha], 1e-14);
+                              EXPECT_NEAR(f_mrt[cell][alpha], f_cell[cell][alpha], 1e-14);
+                          }
+                      });
+    }
+
+    TEST(lbm, d1q2_two_level_mesh_keeps_the_equilibrium)
+    {
+        // Left half of the periodic segment on the level 3, right half on the level 4
+        using mesh_t = MRMesh<MRConfig<1>>;
+        typename mesh_t::cl_type cl;
+        cl[3][{}].add_interval({0, 4});
+        cl[4][{}].add_interval({8, 16});
+        mesh_t mesh(cl, 3, 4, {true});
+
+        auto f       = make_field<double, 2>("f", mesh);
+        auto lattice = lbm::D1Q2(1.);
+        lbm::scheme<decltype(lattice)> scheme(lattice);
+
+        // m = (1, 0.2) is the equilibrium of the collision
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          f[cell][0] = 0.6;
+                          f[cell][1] = 0.4;
+                      });
+
+        auto collision = d1q2_collision();
+        for (int k = 0; k < 10; ++k)
+        {
+            scheme.step(f, collision);
+        }
+
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          EXPECT_NEAR(f[cell][0], 0.6, 1e-14);
+                          EXPECT_NEAR(f[cell][1], 0.4, 1e-14);
+                      });
+    }
+
+    TEST(lbm, d2q9_conserves_density_and_momentum)
+    {
+        constexpr std::size_t nvel = 9;
+
+        auto mesh    = periodic_mesh<2>(4);
+        auto f       = make_field<double, nvel, true>("f", mesh);
+        auto lattice = lbm::D2Q9(1.);
+        lbm::scheme<decltype(lattice)> scheme(lattice);
+
+        // Distribution functions of non-equilibrium moments
+        double pi = std::acos(-1.);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto x = cell.center();
+                          std::array<double, nvel> m{1. + 0.2 * std::sin(2 * pi * x[0]) * std::cos(2 * pi * x[1]),
+                                                     0.1 * std::cos(2 * pi * x[1]),
+                                                     -0.05 * std::sin(2 * pi * x[0]),
+                                                     0.8,
+                                                     0.1 * x[0],
+                                                     0.,
+                                                     0.,
+                                                     0.05 * x[1],
+                                                     1.};
+                          for (std::size_t alpha = 0; alpha < nvel; ++alpha)
+                          {
+                              f[cell][alpha] = 0;
+                              for (std::size_t p = 0; p < nvel; ++p)
+                              {
+                                  f[cell][alpha] += lattice.inverse_moments()[alpha][p] * m[p];
+                              }
+                          }
+                      });
+
+        // Equilibrium of the whole block, linear in the conserved moments
+        auto equilibrium = [](const lbm::moments_block<nvel>& m, const lbm::moments_block<nvel>& m_eq)
+        {
+            for (std::size_t x = 0; x < m.n; ++x)
+            {
+                for (std::size_t p = 0; p < 3; ++p)
+                {
+                    m_eq(p, x) = m(p, x);
+                }
+                m_eq(3, x) = 0.5 * m(0, x);
+                m_eq(4, x) = 0.;
+                m_eq(5, x) = 0.;
+                m_eq(6, x) = 0.3 * m(1, x);
+                m_eq(7, x) = 0.3 * m(2, x);
+                m_eq(8, x) = 0.2 * m(0, x);
+            }
+        };
+        auto collision = lbm::make_mrt<nvel>({0., 0., 0., 1.2, 1.4, 1.4, 1.1, 1.1, 1.3}, lbm::block(equilibrium));
+
+        auto initial = integrated_moments(lattice, f);
+        for (int k = 0; k < 20; ++k)
+        {
+            scheme.step(f, collision);
+        }
+        auto final = integrated_moments(lattice, f);
+
+        for (std::size_t p = 0; p < 3; ++p)
+        {
+            EXPECT_NEAR(final[p], initial[p], 1e-12);
+        }
+        EXPECT_NE(final[3], initial[3]);
+    }
+}
@@ -0,0 +1,130 @@
+#include <algorithm>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/schemes/fv.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using mesh_t    = MRMesh<MRConfig<1>>;
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        // [0, 0.25] on the level 3, [0.25, 0.5] on the level 4, [0.5, 1] on the level 5
+        auto three_level_mesh()
+        {
+            typename mesh_t::cl_type cl;
+            cl[3][{}].add_interval({0, 2});
+            cl[4][{}].add_interval({4, 8});
+            cl[5][{}].add_interval({16, 32});
+            return mesh_t(cl, 3, 5);
+        }
+
+        // Non-negative bump supported in [0.1, 0.7], across the level jumps of three_level_mesh()
+        template <class Field>
+        void init_bump(Field& u)
+        {
+            double pi = std::acos(-1.);
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              double x = cell.center(0);
+                              u[cell]  = (x > 0.1 && x < 0.7) ? std::pow(std::sin(pi * (x - 0.1) / 0.6), 2) : 0.;
+                          });
+            make_bc<Dirichlet>(u, 0.);
+        }
+
+        template <class Field>
+        double mass(const Field& u)
+        {
+            double m = 0;
+            for_each_cell(u.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              m += cell.length * u[cell];
+                          });
+            return m;
+        }
+
+        // Explicit Euler with the time step of the finest level on every cell
+        template <class Field, class Scheme>
+        void global_time_stepping(Field& u, Scheme& scheme, double dt, std::size_t n_steps)
+        {
+            auto unp1 = make_field<double, 1>("unp1", u.mesh());
+            for (std::size_t k = 0; k < n_steps; ++k)
+            {
+                update_ghost_mr(u);
+                unp1 = u - dt * scheme(u);
+                std::swap(u.array(), unp1.array());
+            }
+        }
+
+        template <class Field>
+        double max_difference(const Field& u, const Field& v)
+        {
+            double diff = 0;
+            for_each_cell(u.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              diff = std::max(diff, std::abs(u[cell] - v[cell]));
+                          });
+            return diff;
+        }
+    }
+
+    TEST(local_time_stepping, uniform_mesh_is_global_time_stepping)
+    {
+        mesh_t mesh{Box<double, 1>({0.}, {1.}), 5, 5};
+        auto u        = make_field<double, 1>("u", mesh);
+        auto u_global = make_field<double, 1>("u_global", mesh);
+        init_bump(u);
+        init_bump(u_global);
+
+        auto conv = make_convection<decltype(u)>();
+        double dt = 0.1 * cell_length(5);
+
+        auto lts = make_local_time_stepping(conv);
+        for (int n = 0; n < 5; ++n)
+        {
+            EXPECT_DOUBLE_EQ(lts.advance(u, dt), dt);
+        }
+        global_time_stepping(u_global, conv, dt, 5);
+
+        EXPECT_LE(max_difference(u, u_global), 1e-14);
+    }
+
+    TEST(local_time_stepping, three_levels)
+    {
+        auto mesh     = three_level_mesh();
+        auto u        = make_field<double, 1>("u", mesh);
+        auto u_global = make_field<double, 1>("u_global", mesh);
+        init_bump(u);
+        init_bump(u_global);
+
+        auto conv = make_convection<decltype(u)>();
+        double dt = 0.05 * cell_length(5);
+
+        double initial_mass = mass(u);
+        auto u_initial      = make_field<double, 1>("u_initial", mesh);
+        u_initial.array()   = u.array();
+
+        // One step of the coarsest level is four steps of the finest level
+        auto lts = make_local_time_stepping(conv);
+        EXPECT_DOUBLE_EQ(lts.advance(u, dt), 4 * dt);
+        global_time_stepping(u_global, conv, dt, 4);
+
+        // The fluxes at the level jumps are applied to the coarse cells through the flux register
+        EXPECT_NEAR(mass(u), initial_mass, 1e-14);
+        EXPECT_NEAR(mass(u_global), initial_mass, 1e-14);
+
+        // The coarse cells take fewer, longer steps: a difference of order dt^2
+        double change = max_difference(u_global, u_initial);
+        EXPECT_GT(change, 0.);
+        EXPECT_LE(max_difference(u, u_global), 0.1 * change);
+    }
+}
@@ -0,0 +1,179 @@
+#include <array>
+
+#include <gtest/gtest.h>
+#include <mpi.h>
+
+#include <xtensor/xmath.hpp>
+
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mpi.hpp>
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/stencil_field.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using mesh_t     = MRMesh<MRConfig<2>>;
+        using mesh_id_t  = typename mesh_t::mesh_id_t;
+        using interval_t = typename mesh_t::interval_t;
+
+        constexpr std::size_t min_level = 3;
+        constexpr std::size_t max_level = 6;
+        constexpr double eps            = 2e-4;
+        constexpr double regularity     = 1.;
+
+        mesh_t initial_mesh()
+        {
+            return mesh_t{Box<double, 2>({0., 0.}, {1., 1.}), min_level, max_level};
+        }
+
+        // Disk of radius 0.2 centered at (0.3, 0.3), across the parts of 2 and 4 processes
+        template <class Mesh>
+        auto init(Mesh& mesh)
+        {
+            auto u = make_field<double, 1>("u", mesh);
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              auto x  = cell.center();
+                              u[cell] = ((x[0] - 0.3) * (x[0] - 0.3) + (x[1] - 0.3) * (x[1] - 0.3) <= 0.04) ? 1. : 0.;
+                          });
+            make_bc<Dirichlet>(u, 0.);
+            return u;
+        }
+
+        int rank()
+        {
+            int r;
+            MPI_Comm_rank(MPI_COMM_WORLD, &r);
+            return r;
+        }
+
+        std::size_t n_processes()
+        {
+            int n;
+            MPI_Comm_size(MPI_COMM_WORLD, &n);
+            return static_cast<std::size_t>(n);
+        }
+    }
+
+    TEST(mpi, partition_computed_together)
+    {
+        auto mesh  = initial_mesh();
+        auto u     = init(mesh);
+        auto adapt = make_MRAdapt(u);
+        adapt(eps, regularity);
+
+        const auto& cells = mesh[mesh_id_t::cells];
+        mpi::SfcPartition<2, interval_t> serial(cells, min_level, n_processes());
+        auto local       = mpi::part_cells(cells, serial, static_cast<std::size_t>(rank()));
+        auto distributed = mpi::detail::make_partition(MPI_COMM_WORLD, local, min_level, n_processes());
+
+        ASSERT_EQ(distributed.n_parts(), serial.n_parts());
+        for_each_interval(cells,
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              serial.for_each_part(level,
+                                                   i,
+                                                   index,
+                                                   [&](std::size_t p, const auto& sub_i)
+                                                   {
+                                                       for (auto x = sub_i.start; x < sub_i.end; ++x)
+                                                       {
+                                                           EXPECT_EQ(distributed.part(level, x, index), p);
+                                                       }
+                                                   });
+                          });
+    }
+
+    TEST(mpi, adaptation_and_advection_as_on_one_process)
+    {
+        const std::array<double, 2> velocity{
+            {1., 1.}
+        };
+        const double dt = 0.5 / (1 << max_level);
+
+        auto serial_mesh  = initial_mesh();
+        auto u_serial     = init(serial_mesh);
+        auto unp1_serial  = make_field<double, 1>("unp1", serial_mesh);
+        auto serial_adapt = make_MRAdapt(u_serial);
+
+        mpi::DistributedMesh<mesh_t> dmesh(initial_mesh());
+        auto u     = init(dmesh.mesh());
+        auto unp1  = make_field<double, 1>("unp1", dmesh.mesh());
+        auto adapt = mpi::make_MRAdapt(dmesh, u);
+
+        for (std::size_t n = 0; n < 3; ++n)
+        {
+            serial_adapt(eps, regularity);
+            update_ghost_mr(u_serial);
+            unp1_serial.resize();
+            unp1_serial = u_serial - dt * upwind(velocity, u_serial);
+            std::swap(u_serial.array(), unp1_serial.array());
+
+            adapt(eps, regularity);
+            mpi::update_ghost_mr(dmesh, u);
+            unp1.resize();
+            unp1 = u - dt * upwind(velocity, u);
+            std::swap(u.array(), unp1.array());
+        }
+
+        // The owned cells of the processes are the leaves of the serial mesh
+        const auto& owned  = dmesh.owned_cells();
+        std::size_t common = 0;
+        for (std::size_t level = min_level; level <= max_level; ++level)
+        {
+            auto set = intersection(owned[level], serial_mesh[mesh_id_t::cells][level]);
+            set(
+                [&](const auto& i, const auto&)
+                {
+                    common += i.size();
+                });
+        }
+        EXPECT_EQ(common, owned.nb_cells());
+        EXPECT_EQ(dmesh.nb_cells(), serial_mesh.nb_cells(mesh_id_t::cells));
+
+        for_each_interval(owned,
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              EXPECT_LE(xt::amax(xt::abs(u(level, i, index) - u_serial(level, i, index)))(), 1e-14);
+                          });
+    }
+
+    TEST(mpi, fields_of_different_sizes_exchanged_together)
+    {
+        mpi::DistributedMesh<mesh_t> dmesh(initial_mesh());
+        auto& mesh = dmesh.mesh();
+        auto a     = make_field<double, 1>("a", mesh);
+        auto b     = make_field<double, 2>("b", mesh);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto x     = cell.center();
+                          a[cell]    = x[0];
+                          b[cell][0] = x[1];
+                          b[cell][1] = x[0] + x[1];
+                      });
+        for_each_interval(dmesh.halo_cells(),
+                          [&](std::size_t level, const auto& i, const auto& index)
+                          {
+                              a(level, i, index) = -1.;
+                              b(level, i, index) = -1.;
+                          });
+
+        // Each field has its own tag: the values of a cannot be received in b
+        dmesh.exchange(a, b);
+
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          auto x = cell.center();
+                          EXPECT_DOUBLE_EQ(a[cell], x[0]);
+                          EXPECT_DOUBLE_EQ(b[cell][0], x[1]);
+                          EXPECT_DOUBLE_EQ(b[cell][1], x[0] + x[1]);
+                      });
+    }
+}
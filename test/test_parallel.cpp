@@ -0,0 +1,182 @@
+#include <gtest/gtest.h>
+
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/parallel.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using mesh_t    = MRMesh<MRConfig<2>>;
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        // Left half of the unit square on the level 4, right half on the level 5
+        auto two_level_mesh()
+        {
+            typename mesh_t::cl_type cl;
+            for (int j = 0; j < 16; ++j)
+            {
+                cl[4][{j}].add_interval({0, 8});
+            }
+            for (int j = 0; j < 32; ++j)
+            {
+                cl[5][{j}].add_interval({16, 32});
+            }
+            return mesh_t(cl, 4, 5);
+        }
+
+        template <class Field>
+        void expect_one_visit_per_cell(const Field& count)
+        {
+            for_each_cell(count.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              EXPECT_EQ(count[cell], 1.);
+                          });
+        }
+
+        // Value depending on the level, the position and the index of the cells
+        template <class Policy, class Field>
+        void fill(Policy policy, Field& u, std::size_t max_chunk)
+        {
+            parallel_for_each_interval(
+                policy,
+                u.mesh(),
+                [&](std::size_t level, const auto& i, const auto& index)
+                {
+                    u(level, i, index) = 1000. * static_cast<double>(level) + 10. * index[0] + xt::arange<double>(i.start, i.end);
+                },
+                max_chunk);
+        }
+
+        std::size_t n_listed_cells(const mesh_t& mesh, std::size_t max_chunk)
+        {
+            auto list     = detail::cached_interval_list(mesh, max_chunk);
+            std::size_t n = 0;
+            for (const auto& i : list->intervals)
+            {
+                n += i.size();
+            }
+            return n;
+        }
+    }
+
+    TEST(parallel, every_cell_is_visited_once)
+    {
+        auto mesh  = two_level_mesh();
+        auto count = make_field<double, 1>("count", mesh);
+
+        for (std::size_t max_chunk : {std::size_t{0}, std::size_t{3}})
+        {
+            count.fill(0);
+            parallel_for_each_interval(
+                execution::thread_pool,
+                mesh,
+                [&](std::size_t level, const auto& i, const auto& index)
+                {
+                    count(level, i, index) += 1;
+                },
+                max_chunk);
+            expect_one_visit_per_cell(count);
+
+            count.fill(0);
+            parallel_for_each_interval(
+                execution::openmp,
+                mesh,
+                [&](std::size_t level, const auto& i, const auto& index)
+                {
+                    count(level, i, index) += 1;
+                },
+                max_chunk);
+            expect_one_visit_per_cell(count);
+        }
+    }
+
+    TEST(parallel, sequential_and_parallel_results_agree)
+    {
+        auto mesh = two_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        auto v    = make_field<double, 1>("v", mesh);
+        auto w    = make_field<double, 1>("w", mesh);
+        u.fill(0);
+        v.fill(0);
+        w.fill(0);
+
+        fill(execution::seq, u, 0);
+        fill(execution::thread_pool, v, 5);
+        fill(execution::openmp, w, 5);
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(v[cell], u[cell]);
+                          EXPECT_EQ(w[cell], u[cell]);
+                      });
+    }
+
+    TEST(parallel, interval_list_is_cached_per_generation)
+    {
+        auto mesh = two_level_mesh();
+
+        auto list = detail::cached_interval_list(mesh, 0);
+        EXPECT_EQ(detail::cached_interval_list(mesh, 0).get(), list.get());
+        EXPECT_NE(detail::cached_interval_list(mesh, 3).get(), list.get());
+        EXPECT_EQ(n_listed_cells(mesh, 0), mesh.nb_cells(mesh_id_t::cells));
+        EXPECT_EQ(n_listed_cells(mesh, 3), mesh.nb_cells(mesh_id_t::cells));
+
+        // A new cell structure (as after an adaptation) gets its own list
+        mesh_t uniform{Box<double, 2>({0., 0.}, {1., 1.}), 3, 3};
+        mesh.swap(uniform);
+        EXPECT_NE(detail::cached_interval_list(mesh, 0).get(), list.get());
+        EXPECT_EQ(n_listed_cells(mesh, 0), mesh.nb_cells(mesh_id_t::cells));
+        EXPECT_EQ(mesh.nb_cells(mesh_id_t::cells), std::size_t{64});
+
+        auto v = make_field<double, 1>("v", mesh);
+        auto w = make_field<double, 1>("w", mesh);
+        fill(execution::seq, v, 0);
+        fill(execution::thread_pool, w, 0);
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          EXPECT_EQ(w[cell], v[cell]);
+                      });
+    }
+
+    TEST(parallel, one_level)
+    {
+        auto mesh  = two_level_mesh();
+        auto count = make_field<double, 1>("count", mesh);
+
+        for (std::size_t level = 4; level <= 5; ++level)
+        {
+            count.fill(0);
+            parallel_for_each_interval(execution::thread_pool,
+                                       mesh,
+                                       level,
+                                       [&](std::size_t l, const auto& i, const auto& index)
+                                       {
+                                           EXPECT_EQ(l, level);
+                                           count(l, i, index) += 1;
+                                       });
+            for_each_cell(mesh[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              EXPECT_EQ(count[cell], (cell.level == level) ? 1. : 0.);
+                          });
+
+            count.fill(0);
+            parallel_for_each_interval(execution::seq,
+                                       mesh,
+                                       level,
+                                       [&](std::size_t l, const auto& i, const auto& index)
+                                       {
+                                           count(l, i, index) += 1;
+                                       });
+            for_each_cell(mesh[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              EXPECT_EQ(count[cell], (cell.level == level) ? 1. : 0.);
+                          });
+        }
+    }
+}
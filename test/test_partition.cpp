@@ -0,0 +1,97 @@
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <samurai/cell_array.hpp>
+#include <samurai/cell_list.hpp>
+#include <samurai/mpi/partition.hpp>
+
+namespace samurai
+{
+    TEST(partition, neighborhood_of_a_coarse_cell)
+    {
+        CellList<2> cl;
+        cl[2][{1}].add_interval({1, 2});
+        CellArray<2> ca{cl};
+
+        // The width is counted in cells of the level 2: the cells of the level 2 around it, on the level 3
+        auto around = mpi::neighborhood(ca, 3, 1);
+        EXPECT_EQ(around.level(), std::size_t{3});
+        EXPECT_EQ(around.nb_cells(), std::size_t{36});
+        for_each_interval(around,
+                          [&](std::size_t, const auto& i, const auto& index)
+                          {
+                              EXPECT_EQ(i.start, 0);
+                              EXPECT_EQ(i.end, 6);
+                              EXPECT_GE(index[0], 0);
+                              EXPECT_LT(index[0], 6);
+                          });
+
+        EXPECT_EQ(mpi::neighborhood(ca, 2, 0).nb_cells(), std::size_t{1});
+        EXPECT_EQ(mpi::neighborhood(ca, 2, 2).nb_cells(), std::size_t{25});
+    }
+
+    TEST(partition, neighborhood_of_a_fine_cell)
+    {
+        CellList<2> cl;
+        cl[4][{5}].add_interval({5, 6});
+        CellArray<2> ca{cl};
+
+        // The width is counted in cells of the level 3, around the cell of the level 3 containing it
+        auto around = mpi::neighborhood(ca, 3, 1);
+        EXPECT_EQ(around.nb_cells(), std::size_t{9});
+        for_each_interval(around,
+                          [&](std::size_t, const auto& i, const auto& index)
+                          {
+                              EXPECT_EQ(i.start, 1);
+                              EXPECT_EQ(i.end, 4);
+                              EXPECT_GE(index[0], 1);
+                              EXPECT_LT(index[0], 4);
+                          });
+
+        // Root cell containing it
+        auto root = mpi::neighborhood(ca, 1, 0);
+        EXPECT_EQ(root.nb_cells(), std::size_t{1});
+    }
+
+    TEST(partition, balanced_parts)
+    {
+        // Level 2 on the left half, level 3 on the right half: 8 + 32 leaves in 16 trees of the level 2
+        CellList<2> cl;
+        for (int j = 0; j < 4; ++j)
+        {
+            cl[2][{j}].add_interval({0, 2});
+        }
+        for (int j = 0; j < 8; ++j)
+        {
+            cl[3][{j}].add_interval({4, 8});
+        }
+        CellArray<2> ca{cl};
+
+        for (std::size_t n_parts : {std::size_t{1}, std::size_t{2}, std::size_t{4}, std::size_t{16}})
+        {
+            mpi::SfcPartition<2, default_config::interval_t> partition(ca, 2, n_parts);
+            EXPECT_EQ(partition.n_parts(), n_parts);
+
+            std::size_t n_cells = 0;
+            for (std::size_t p = 0; p < n_parts; ++p)
+            {
+                auto cells = mpi::part_cells(ca, partition, p);
+                EXPECT_GT(cells.nb_cells(), std::size_t{0});
+                n_cells += cells.nb_cells();
+            }
+            EXPECT_EQ(n_cells, ca.nb_cells());
+        }
+
+        // 10 leaves per part: the trees are not split
+        mpi::SfcPartition<2, default_config::interval_t> partition(ca, 2, 4);
+        for (std::size_t p = 0; p < 4; ++p)
+        {
+            auto n = mpi::part_cells(ca, partition, p).nb_cells();
+            EXPECT_GE(n, std::size_t{8});
+            EXPECT_LE(n, std::size_t{12});
+        }
+
+        EXPECT_THROW((mpi::SfcPartition<2, default_config::interval_t>(ca, 2, 17)), std::runtime_error);
+    }
+}
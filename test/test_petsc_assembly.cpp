@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+#include "test_adapted_mesh.hpp"
+
+namespace samurai
+{
+    namespace
+    {
+        template <class Assembly>
+        Mat assemble(Assembly& assembly)
+        {
+            Mat A;
+            assembly.create_matrix(A);
+            assembly.assemble_matrix(A);
+            return A;
+        }
+
+        bool equal(Mat A, Mat B)
+        {
+            PetscBool eq;
+            MatEqual(A, B, &eq);
+            return eq == PETSC_TRUE;
+        }
+    }
+
+    // The ghost elimination belongs to the assembly: assemblies of the same scheme type on different meshes,
+    // used alternately, each keep the one of their mesh.
+    TEST(petsc_assembly, ghost_elimination_per_assembly)
+    {
+        auto mesh1 = adapted_mesh(2, 5, 0.3);
+        auto mesh2 = adapted_mesh(2, 5, 0.7);
+        auto u1    = make_field<double, 1>("u", mesh1);
+        auto u2    = make_field<double, 1>("u", mesh2);
+        make_bc<Dirichlet>(u1, 0.);
+        make_bc<Dirichlet>(u2, 0.);
+
+        auto diff1 = make_diffusion<decltype(u1)>();
+        auto diff2 = make_diffusion<decltype(u2)>();
+
+        // Reference matrices, each assembled alone
+        auto reference1 = petsc::make_assembly(diff1);
+        auto reference2 = petsc::make_assembly(diff2);
+        reference1.set_unknown(u1);
+        reference2.set_unknown(u2);
+        Mat A1_ref = assemble(reference1);
+        Mat A2_ref = assemble(reference2);
+
+        // Interleaved
+        auto assembly1 = petsc::make_assembly(diff1);
+        auto assembly2 = petsc::make_assembly(diff2);
+        assembly1.set_unknown(u1);
+        assembly2.set_unknown(u2);
+        Mat A1;
+        assembly1.create_matrix(A1);
+        Mat A2 = assemble(assembly2);
+        assembly1.assemble_matrix(A1);
+        assembly1.reassemble_matrix(A1);
+
+        EXPECT_TRUE(equal(A1, A1_ref));
+        EXPECT_TRUE(equal(A2, A2_ref));
+
+        MatDestroy(&A1);
+        MatDestroy(&A2);
+        MatDestroy(&A1_ref);
+        MatDestroy(&A2_ref);
+    }
+
+    // After the adaptation of the mesh, the ghost elimination is rebuilt
+    TEST(petsc_assembly, ghost_elimination_after_adaptation)
+    {
+        auto mesh = adapted_mesh(2, 5, 0.3);
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 0.);
+        auto diff = make_diffusion<decltype(u)>();
+
+        auto assembly = petsc::make_assembly(diff);
+        assembly.set_unknown(u);
+        Mat A = assemble(assembly);
+        MatDestroy(&A);
+
+        auto other_mesh = adapted_mesh(2, 5, 0.7);
+        mesh.swap(other_mesh);
+        u.resize();
+        A = assemble(assembly);
+
+        auto reference = petsc::make_assembly(diff);
+        reference.set_unknown(u);
+        Mat A_ref = assemble(reference);
+        EXPECT_TRUE(equal(A, A_ref));
+
+        MatDestroy(&A);
+        MatDestroy(&A_ref);
+    }
+}
@@ -0,0 +1,116 @@
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+#include "test_adapted_mesh.hpp"
+
+namespace samurai
+{
+    namespace
+    {
+        // Frobenius norm of A - B, relative to the norm of B
+        double relative_difference(Mat A, Mat B)
+        {
+            Mat D;
+            MatDuplicate(A, MAT_COPY_VALUES, &D);
+            MatAXPY(D, -1, B, DIFFERENT_NONZERO_PATTERN);
+            PetscReal norm_d;
+            PetscReal norm_b;
+            MatNorm(D, NORM_FROBENIUS, &norm_d);
+            MatNorm(B, NORM_FROBENIUS, &norm_b);
+            MatDestroy(&D);
+            return norm_d / norm_b;
+        }
+
+        template <class Assembly>
+        void check_csr(Assembly& assembly)
+        {
+            Mat A;
+            assembly.create_matrix(A);
+            assembly.assemble_matrix(A);
+
+            Mat A_csr;
+            assembly.create_csr_matrix(A_csr);
+
+            PetscInt nnz_a;
+            PetscInt nnz_csr;
+            MatInfo info;
+            MatGetInfo(A, MAT_LOCAL, &info);
+            nnz_a = static_cast<PetscInt>(info.nz_used);
+            MatGetInfo(A_csr, MAT_LOCAL, &info);
+            nnz_csr = static_cast<PetscInt>(info.nz_used);
+            EXPECT_EQ(nnz_csr, nnz_a);
+            EXPECT_LE(relative_difference(A_csr, A), 1e-14);
+
+            MatDestroy(&A);
+            MatDestroy(&A_csr);
+        }
+    }
+
+    TEST(petsc_csr, heat)
+    {
+        auto mesh = adapted_mesh(2, 5);
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 0.);
+
+        double dt       = 1e-2;
+        auto diff       = make_diffusion<decltype(u)>();
+        auto id         = make_identity<decltype(u)>();
+        auto back_euler = id + dt * diff;
+
+        auto assembly = petsc::make_assembly(back_euler);
+        assembly.set_unknown(u);
+        check_csr(assembly);
+    }
+
+    TEST(petsc_csr, stokes)
+    {
+        auto mesh     = adapted_mesh(2, 5);
+        auto velocity = make_field<2, false>("velocity", mesh);
+        auto pressure = make_field<1, false>("pressure", mesh);
+        make_bc<Dirichlet>(velocity, 0., 0.);
+        make_bc<Neumann>(pressure, 0.);
+
+        auto diff    = make_diffusion<decltype(velocity)>();
+        auto grad    = make_gradient<decltype(pressure)>();
+        auto div     = make_divergence<decltype(velocity)>();
+        auto zero_op = make_zero_operator<decltype(pressure)>();
+
+        auto stokes = make_block_operator<2, 2>(diff, grad, -div, zero_op);
+
+        auto assembly = petsc::make_assembly<true>(stokes);
+        assembly.set_unknowns(velocity, pressure);
+        check_csr(assembly);
+    }
+
+    TEST(petsc_csr, reassembly)
+    {
+        auto mesh = adapted_mesh(2, 5);
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Neumann>(u, 0.);
+
+        double dt       = 1e-2;
+        auto diff       = make_diffusion<decltype(u)>();
+        auto id         = make_identity<decltype(u)>();
+        auto back_euler = id + dt * diff;
+
+        auto assembly = petsc::make_assembly(back_euler);
+        assembly.set_unknown(u);
+
+        Mat A_csr;
+        assembly.create_csr_matrix(A_csr);
+
+        dt         = 1e-3;
+        back_euler = id + dt * diff;
+        assembly.reassemble_csr_matrix(A_csr);
+
+        Mat A;
+        assembly.create_matrix(A);
+        assembly.assemble_matrix(A);
+        EXPECT_LE(relative_difference(A_csr, A), 1e-14);
+
+        MatDestroy(&A);
+        MatDestroy(&A_csr);
+    }
+}
@@ -0,0 +1,86 @@
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        int event_count(petsc::LogPhase phase)
+        {
+            PetscEventPerfInfo info;
+            PetscLogEventGetPerfInfo(0, petsc::log_event(phase), &info);
+            return info.count;
+        }
+    }
+
+    TEST(petsc_log, one_event_per_phase)
+    {
+        EXPECT_EQ(petsc::log_event(petsc::LogPhase::assemble_scheme), petsc::log_event(petsc::LogPhase::assemble_scheme));
+        EXPECT_NE(petsc::log_event(petsc::LogPhase::assemble_scheme), petsc::log_event(petsc::LogPhase::create_matrix));
+
+        PetscLogEvent registered;
+        PetscLogEventGetId("samurai assemble_scheme", &registered);
+        EXPECT_EQ(registered, petsc::log_event(petsc::LogPhase::assemble_scheme));
+    }
+
+    TEST(petsc_log, schemes_share_the_events)
+    {
+        PetscLogDefaultBegin();
+
+        using Config = MRConfig<2>;
+        Box<double, 2> box({0., 0.}, {1., 1.});
+        MRMesh<Config> mesh{box, 3, 3};
+        auto u = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 0.);
+
+        auto diff = make_diffusion<decltype(u)>();
+        auto id   = make_identity<decltype(u)>();
+
+        int count_before = event_count(petsc::LogPhase::assemble_scheme);
+
+        // The names of the schemes embed the time step: they must not create events
+        for (double dt : {0.1, 0.2, 0.3})
+        {
+            auto back_euler = id + dt * diff;
+            auto assembly   = petsc::make_assembly(back_euler);
+            assembly.set_unknown(u);
+            Mat A;
+            assembly.create_matrix(A);
+            assembly.assemble_matrix(A);
+            MatDestroy(&A);
+        }
+
+        EXPECT_GE(event_count(petsc::LogPhase::assemble_scheme) - count_before, 3);
+    }
+
+    TEST(petsc_log, useless_ghosts_have_their_events)
+    {
+        PetscLogDefaultBegin();
+
+        using Config = MRConfig<2>;
+        Box<double, 2> box({0., 0.}, {1., 1.});
+        MRMesh<Config> mesh{box, 3, 3};
+        auto u = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 0.);
+
+        auto diff     = make_diffusion<decltype(u)>();
+        auto assembly = petsc::make_assembly(diff);
+        assembly.set_unknown(u);
+
+        int sparsity_before = event_count(petsc::LogPhase::sparsity_pattern_useless_ghosts);
+        int assemble_before = event_count(petsc::LogPhase::assemble_useless_ghosts);
+        Mat A;
+        assembly.create_matrix(A);
+        assembly.assemble_matrix(A);
+        MatDestroy(&A);
+
+        EXPECT_EQ(event_count(petsc::LogPhase::sparsity_pattern_useless_ghosts) - sparsity_before, 1);
+        EXPECT_EQ(event_count(petsc::LogPhase::assemble_useless_ghosts) - assemble_before, 1);
+
+        PetscLogEvent registered;
+        PetscLogEventGetId("samurai assemble_useless_ghosts", &registered);
+        EXPECT_EQ(registered, petsc::log_event(petsc::LogPhase::assemble_useless_ghosts));
+    }
+}
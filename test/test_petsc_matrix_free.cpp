@@ -0,0 +1,131 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+#include <samurai/petsc/matrix_free.hpp>
+
+#include "test_adapted_mesh.hpp"
+
+namespace samurai
+{
+    namespace
+    {
+        template <class Assembly>
+        void check_matrix_free(Assembly& assembly, Assembly& matrix_free_assembly)
+        {
+            Mat A;
+            assembly.create_matrix(A);
+            assembly.assemble_matrix(A);
+
+            Mat A_free;
+            petsc::create_matrix_free(matrix_free_assembly, A_free);
+
+            PetscInt n;
+            MatGetSize(A, &n, nullptr);
+
+            Vec x;
+            VecCreateSeq(PETSC_COMM_SELF, n, &x);
+            PetscScalar* x_data;
+            VecGetArray(x, &x_data);
+            for (PetscInt i = 0; i < n; ++i)
+            {
+                x_data[i] = std::sin(static_cast<double>(i));
+            }
+            VecRestoreArray(x, &x_data);
+
+            Vec y;
+            Vec y_free;
+            VecDuplicate(x, &y);
+            VecDuplicate(x, &y_free);
+
+            // Product
+            MatMult(A, x, y);
+            MatMult(A_free, x, y_free);
+
+            PetscReal norm_y;
+            VecNorm(y, NORM_INFINITY, &norm_y);
+            VecAXPY(y_free, -1, y);
+            PetscReal error;
+            VecNorm(y_free, NORM_INFINITY, &error);
+            EXPECT_LE(error, 1e-12 * norm_y);
+
+            // Diagonal
+            MatGetDiagonal(A, y);
+            MatGetDiagonal(A_free, y_free);
+
+            VecNorm(y, NORM_INFINITY, &norm_y);
+            VecAXPY(y_free, -1, y);
+            VecNorm(y_free, NORM_INFINITY, &error);
+            EXPECT_LE(error, 1e-12 * norm_y);
+
+            VecDestroy(&x);
+            VecDestroy(&y);
+            VecDestroy(&y_free);
+            MatDestroy(&A);
+            MatDestroy(&A_free);
+        }
+    }
+
+    TEST(petsc_matrix_free, mesh_is_adapted)
+    {
+        auto mesh       = adapted_mesh<2>(2, 5);
+        using mesh_id_t = typename decltype(mesh)::mesh_id_t;
+        EXPECT_GT(mesh[mesh_id_t::cells].max_level(), mesh[mesh_id_t::cells].min_level());
+    }
+
+    TEST(petsc_matrix_free, diffusion_dirichlet)
+    {
+        auto mesh = adapted_mesh<2>(2, 5);
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 1.);
+
+        auto diff = make_diffusion<decltype(u)>();
+
+        auto assembly = petsc::make_assembly(diff);
+        assembly.set_unknown(u);
+        auto matrix_free_assembly = petsc::make_assembly(diff);
+        matrix_free_assembly.set_unknown(u);
+
+        check_matrix_free(assembly, matrix_free_assembly);
+    }
+
+    TEST(petsc_matrix_free, heat_neumann)
+    {
+        auto mesh = adapted_mesh<2>(2, 5);
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Neumann>(u, 0.);
+
+        double dt       = 1e-2;
+        auto diff       = make_diffusion<decltype(u)>();
+        auto id         = make_identity<decltype(u)>();
+        auto back_euler = id + dt * diff;
+
+        auto assembly = petsc::make_assembly(back_euler);
+        assembly.set_unknown(u);
+        auto matrix_free_assembly = petsc::make_assembly(back_euler);
+        matrix_free_assembly.set_unknown(u);
+
+        check_matrix_free(assembly, matrix_free_assembly);
+    }
+
+    TEST(petsc_matrix_free, heat_1d)
+    {
+        auto mesh = adapted_mesh<1>(2, 5);
+        auto u    = make_field<double, 1>("u", mesh);
+        make_bc<Dirichlet>(u, 0.);
+
+        double dt       = 1e-2;
+        auto diff       = make_diffusion<decltype(u)>();
+        auto id         = make_identity<decltype(u)>();
+        auto back_euler = id + dt * diff;
+
+        auto assembly = petsc::make_assembly(back_euler);
+        assembly.set_unknown(u);
+        auto matrix_free_assembly = petsc::make_assembly(back_euler);
+        matrix_free_assembly.set_unknown(u);
+
+        check_matrix_free(assembly, matrix_free_assembly);
+    }
+}
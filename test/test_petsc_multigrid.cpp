@@ -0,0 +1,141 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+#include "test_adapted_mesh.hpp"
+
+namespace samurai
+{
+    namespace
+    {
+        // Sets a PETSc option for the lifetime of the object
+        struct ScopedOption
+        {
+            const char* name;
+
+            ScopedOption(const char* name_, const char* value)
+                : name(name_)
+            {
+                PetscOptionsSetValue(NULL, name, value);
+            }
+
+            ~ScopedOption()
+            {
+                PetscOptionsClearValue(NULL, name);
+            }
+        };
+    }
+
+    TEST(petsc_multigrid, coarsening_keeps_the_minimum_level)
+    {
+        auto mesh       = adapted_mesh(0, 6);
+        using mesh_id_t = typename decltype(mesh)::mesh_id_t;
+
+        auto min_level = mesh[mesh_id_t::cells].min_level();
+        auto max_level = mesh[mesh_id_t::cells].max_level();
+        ASSERT_EQ(min_level, 0u);
+        ASSERT_GT(max_level, min_level + 1);
+        EXPECT_EQ(petsc::multigrid::levels_to_uniform(mesh), max_level - min_level + 1);
+
+        auto coarse_mesh = petsc::multigrid::coarsen(mesh);
+        EXPECT_EQ(coarse_mesh[mesh_id_t::cells].min_level(), min_level);
+        EXPECT_EQ(coarse_mesh[mesh_id_t::cells].max_level(), max_level - 1);
+        // Only the cells of the finest level are merged
+        EXPECT_LT(coarse_mesh.nb_cells(mesh_id_t::cells), mesh.nb_cells(mesh_id_t::cells));
+        EXPECT_EQ(coarse_mesh.nb_cells(min_level, mesh_id_t::cells), mesh.nb_cells(min_level, mesh_id_t::cells));
+    }
+
+    TEST(petsc_multigrid, pc_type_mg_is_left_to_petsc)
+    {
+        auto mesh = adapted_mesh(0, 6);
+        auto u    = make_field<double, 1>("u", mesh);
+        auto rhs  = make_field<double, 1>("rhs", mesh);
+        make_bc<Dirichlet>(u, 0.);
+        rhs.fill(1.);
+        u.fill(0.);
+
+        auto diff = make_diffusion<decltype(u)>();
+
+        ScopedOption pc_type("-pc_type", "mg");
+        auto solver = petsc::make_solver(diff);
+        solver.set_unknown(u);
+        solver.setup();
+
+        // Plain PCMG: the samurai hierarchy is not built
+        PC pc;
+        KSPGetPC(solver.Krylov_solver(), &pc);
+        PetscInt levels;
+        PCMGGetLevels(pc, &levels);
+        EXPECT_EQ(levels, 1);
+    }
+
+    TEST(petsc_multigrid, samurai_gmg_is_a_pc_type)
+    {
+        petsc::register_samurai_gmg();
+        ScopedOption pc_type("-pc_type", "samurai_gmg");
+        KSP ksp;
+        KSPCreate(PETSC_COMM_SELF, &ksp);
+        PetscErrorCode err = KSPSetFromOptions(ksp);
+        EXPECT_EQ(err, 0);
+        EXPECT_TRUE(petsc::is_samurai_gmg(ksp));
+        KSPDestroy(&ksp);
+    }
+
+    TEST(petsc_multigrid, samurai_gmg_levels_and_convergence)
+    {
+        auto mesh       = adapted_mesh(0, 6);
+        using mesh_id_t = typename decltype(mesh)::mesh_id_t;
+
+        auto u   = make_field<double, 1>("u", mesh);
+        auto rhs = make_field<double, 1>("rhs", mesh);
+        make_bc<Dirichlet>(u, 0.);
+        const double pi = std::acos(-1.);
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          rhs[cell] = std::sin(pi * cell.center(0)) * std::sin(pi * cell.center(1));
+                      });
+
+        auto diff = make_diffusion<decltype(u)>();
+
+        // Reference solution
+        auto u_ref = make_field<double, 1>("u_ref", mesh);
+        make_bc<Dirichlet>(u_ref, 0.);
+        {
+            ScopedOption ksp_rtol("-ksp_rtol", "1e-12");
+            u_ref.fill(0.);
+            petsc::solve(diff, u_ref, rhs);
+        }
+
+        ScopedOption pc_type("-pc_type", "samurai_gmg");
+        ScopedOption ksp_type("-ksp_type", "cg");
+        ScopedOption ksp_rtol("-ksp_rtol", "1e-10");
+        auto solver = petsc::make_solver(diff);
+        u.fill(0.);
+        solver.solve(u, rhs);
+
+        // The hierarchy goes down to the uniform mesh of the minimum level
+        PC pc;
+        KSPGetPC(solver.Krylov_solver(), &pc);
+        PetscInt levels;
+        PCMGGetLevels(pc, &levels);
+        auto expected_levels = mesh[mesh_id_t::cells].max_level() - mesh[mesh_id_t::cells].min_level() + 1;
+        EXPECT_EQ(levels, static_cast<PetscInt>(expected_levels));
+        EXPECT_GT(levels, 1);
+
+        EXPECT_LT(solver.iterations(), 30);
+
+        double error = 0;
+        double norm  = 0;
+        for_each_cell(mesh,
+                      [&](const auto& cell)
+                      {
+                          error = std::max(error, std::abs(u[cell] - u_ref[cell]));
+                          norm  = std::max(norm, std::abs(u_ref[cell]));
+                      });
+        EXPECT_LE(error, 1e-6 * norm);
+    }
+}
@@ -0,0 +1,103 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/mr/adapt.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using solver_mesh_t = MRMesh<MRConfig<2>>;
+
+        Mat operator_of(KSP ksp)
+        {
+            Mat A;
+            KSPGetOperators(ksp, &A, nullptr);
+            return A;
+        }
+
+        // Compares A with the matrix of the scheme assembled from scratch on the current mesh of u
+        template <class Scheme, class Field>
+        bool is_new_assembly(const Scheme& scheme, Field& u, Mat A)
+        {
+            auto assembly = petsc::make_assembly(scheme);
+            assembly.set_unknown(u);
+            Mat B;
+            assembly.create_matrix(B);
+            assembly.assemble_matrix(B);
+
+            PetscInt rows_A, cols_A, rows_B, cols_B;
+            MatGetSize(A, &rows_A, &cols_A);
+            MatGetSize(B, &rows_B, &cols_B);
+            PetscBool eq = PETSC_FALSE;
+            if (rows_A == rows_B && cols_A == cols_B)
+            {
+                MatEqual(A, B, &eq);
+            }
+            MatDestroy(&B);
+            return eq == PETSC_TRUE;
+        }
+    }
+
+    TEST(petsc_solver, matrix_kept_until_the_mesh_changes)
+    {
+        Box<double, 2> box({0., 0.}, {1., 1.});
+        solver_mesh_t mesh{box, 2, 5};
+        auto u   = make_field<double, 1>("u", mesh);
+        auto rhs = make_field<double, 1>("rhs", mesh);
+        make_bc<Dirichlet>(u, 0.);
+        make_bc<Neumann>(rhs, 0.);
+
+        auto init_front = [&](double front)
+        {
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              rhs[cell] = std::tanh(50 * (cell.center(0) - front));
+                          });
+        };
+        auto adapt = make_MRAdapt(rhs);
+        init_front(0.3);
+        adapt(1e-3, 1.);
+        u.resize();
+        u.fill(0.);
+
+        auto diff       = make_diffusion<decltype(u)>();
+        auto id         = make_identity<decltype(u)>();
+        auto back_euler = id + 0.1 * diff;
+        auto solver     = petsc::make_solver(back_euler);
+        solver.solve(u, rhs);
+        Mat A = operator_of(solver.Krylov_solver());
+        EXPECT_TRUE(is_new_assembly(back_euler, u, A));
+
+        // New time steps on the same mesh: the coefficients are inserted into the same matrix
+        for (double dt : {0.2, 0.05})
+        {
+            back_euler = id + dt * diff;
+            solver.update_coefficients();
+            solver.solve(u, rhs);
+            EXPECT_EQ(operator_of(solver.Krylov_solver()), A);
+            EXPECT_TRUE(is_new_assembly(back_euler, u, A));
+        }
+
+        // Without new coefficients, the matrix is left untouched
+        PetscObjectState state_before, state_after;
+        PetscObjectStateGet(reinterpret_cast<PetscObject>(A), &state_before);
+        solver.solve(u, rhs);
+        PetscObjectStateGet(reinterpret_cast<PetscObject>(A), &state_after);
+        EXPECT_EQ(state_after, state_before);
+
+        // After an adaptation which changes the mesh, the matrix is rebuilt
+        auto generation = mesh.generation();
+        init_front(0.7);
+        adapt(1e-3, 1.);
+        ASSERT_NE(mesh.generation(), generation);
+        u.resize();
+        u.fill(0.);
+        solver.solve(u, rhs);
+        EXPECT_TRUE(is_new_assembly(back_euler, u, operator_of(solver.Krylov_solver())));
+    }
+}
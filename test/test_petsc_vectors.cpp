@@ -0,0 +1,125 @@
+#include <gtest/gtest.h>
+
+#include <samurai/mr/mesh.hpp>
+#include <samurai/petsc.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        auto uniform_mesh()
+        {
+            using Config = MRConfig<2>;
+            using mesh_t = MRMesh<Config>;
+
+            Box<double, 2> box({0., 0.}, {1., 1.});
+            return mesh_t{box, 3, 3};
+        }
+    }
+
+    TEST(petsc_vectors, aos_vector_shares_storage)
+    {
+        auto mesh = uniform_mesh();
+        auto u    = make_field<double, 2, false>("u", mesh);
+
+        Vec v = petsc::create_petsc_vector_from(u);
+
+        PetscInt bs;
+        VecGetBlockSize(v, &bs);
+        EXPECT_EQ(bs, 2);
+
+        PetscInt n;
+        VecGetSize(v, &n);
+        EXPECT_EQ(static_cast<std::size_t>(n), 2 * mesh.nb_cells());
+
+        const PetscScalar* data;
+        VecGetArrayRead(v, &data);
+        EXPECT_EQ(data, u.array().data());
+        VecRestoreArrayRead(v, &data);
+
+        VecDestroy(&v);
+    }
+
+    TEST(petsc_vectors, soa_vector_shares_storage)
+    {
+        auto mesh = uniform_mesh();
+        auto u    = make_field<double, 2, true>("u", mesh);
+
+        Vec v = petsc::create_petsc_vector_from(u);
+
+        PetscInt bs;
+        VecGetBlockSize(v, &bs);
+        EXPECT_EQ(bs, 1);
+
+        const PetscScalar* data;
+        VecGetArrayRead(v, &data);
+        EXPECT_EQ(data, u.array().data());
+        VecRestoreArrayRead(v, &data);
+
+        VecDestroy(&v);
+    }
+
+    TEST(petsc_vectors, nested_vector_shares_storage)
+    {
+        auto mesh     = uniform_mesh();
+        auto velocity = make_field<double, 2, false>("velocity", mesh);
+        auto pressure = make_field<double, 1>("pressure", mesh);
+
+        Vec v = petsc::create_nested_petsc_vector_from("x", velocity, pressure);
+
+        Vec block;
+        const PetscScalar* data;
+        VecNestGetSubVec(v, 0, &block);
+        VecGetArrayRead(block, &data);
+        EXPECT_EQ(data, velocity.array().data());
+        VecRestoreArrayRead(block, &data);
+
+        VecNestGetSubVec(v, 1, &block);
+        VecGetArrayRead(block, &data);
+        EXPECT_EQ(data, pressure.array().data());
+        VecRestoreArrayRead(block, &data);
+
+        VecDestroy(&v);
+    }
+
+    // The block size of the matrix of a multi-component (AOS) operator matches the one of the vectors of its fields
+    TEST(petsc_vectors, aos_matrix_block_size)
+    {
+        auto mesh = uniform_mesh();
+        auto u    = make_field<double, 2, false>("u", mesh);
+        auto r    = make_field<double, 2, false>("r", mesh);
+        make_bc<Dirichlet>(u, 0., 0.);
+        u.fill(1.);
+
+        auto diff     = make_diffusion<decltype(u)>();
+        auto assembly = petsc::make_assembly(diff);
+        assembly.set_unknown(u);
+
+        for (bool csr : {false, true})
+        {
+            Mat A;
+            if (csr)
+            {
+                assembly.create_csr_matrix(A);
+            }
+            else
+            {
+                assembly.create_matrix(A);
+                assembly.assemble_matrix(A);
+            }
+
+            PetscInt row_bs;
+            PetscInt col_bs;
+            MatGetBlockSizes(A, &row_bs, &col_bs);
+            EXPECT_EQ(row_bs, 2);
+            EXPECT_EQ(col_bs, 2);
+
+            Vec x = petsc::create_petsc_vector_from(u);
+            Vec y = petsc::create_petsc_vector_from(r);
+            EXPECT_EQ(MatMult(A, x, y), 0);
+            VecDestroy(&x);
+            VecDestroy(&y);
+            MatDestroy(&A);
+        }
+    }
+}
@@ -0,0 +1,108 @@
+#include <gtest/gtest.h>
+
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/numeric/prediction.hpp>
+#include <samurai/subset/subset_op.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        // Level 2 on [0,1]^3, except the center cube [0.25,0.75]^3 which is on the level 3
+        auto two_level_mesh_3d()
+        {
+            using Config = MRConfig<3>;
+            using mesh_t = MRMesh<Config>;
+
+            typename mesh_t::cl_type cl;
+            for (int k = 0; k < 4; ++k)
+            {
+                for (int j = 0; j < 4; ++j)
+                {
+                    if (j >= 1 && j <= 2 && k >= 1 && k <= 2)
+                    {
+                        cl[2][{j, k}].add_interval({0, 1});
+                        cl[2][{j, k}].add_interval({3, 4});
+                    }
+                    else
+                    {
+                        cl[2][{j, k}].add_interval({0, 4});
+                    }
+                }
+            }
+            for (int k = 2; k < 6; ++k)
+            {
+                for (int j = 2; j < 6; ++j)
+                {
+                    cl[3][{j, k}].add_interval({2, 6});
+                }
+            }
+            return mesh_t(cl, 2, 3);
+        }
+
+        // Multilinear: its cell averages are its values at the cell centers,
+        // and the prediction of order 1 is exact. Each term involves a different pair of directions.
+        double f(const xt::xtensor_fixed<double, xt::xshape<3>>& x)
+        {
+            return 1 + x[0] - 2 * x[1] + 3 * x[2] + x[0] * x[1] - 2 * x[0] * x[2] + 3 * x[1] * x[2] + 5 * x[0] * x[1] * x[2];
+        }
+
+        template <class Field>
+        void fill_with_f(Field& u)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+            for_each_cell(u.mesh()[mesh_id_t::reference],
+                          [&](const auto& cell)
+                          {
+                              u[cell] = f(cell.center());
+                          });
+        }
+
+        template <class Field>
+        void expect_exact_on_fine_cells(const Field& u)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+            for_each_cell(u.mesh()[mesh_id_t::cells][3],
+                          [&](const auto& cell)
+                          {
+                              EXPECT_NEAR(u[cell], f(cell.center()), 1e-12) << cell;
+                          });
+        }
+    }
+
+    // Prediction of the fine cells from their parents (dest_on_level = false, as in the update of the ghosts)
+    TEST(prediction, exact_3d_on_level)
+    {
+        auto mesh       = two_level_mesh_3d();
+        using mesh_id_t = typename decltype(mesh)::mesh_id_t;
+
+        auto u = make_field<double, 1>("u", mesh);
+        fill_with_f(u);
+        for_each_cell(mesh[mesh_id_t::cells][3],
+                      [&](const auto& cell)
+                      {
+                          u[cell] = 0;
+                      });
+
+        auto fine_cells = intersection(mesh[mesh_id_t::cells][3], mesh[mesh_id_t::cells][3]).on(3);
+        fine_cells.apply_op(prediction<1, false>(u));
+        expect_exact_on_fine_cells(u);
+    }
+
+    // Prediction of the children of a set of parents (dest_on_level = true, as in the refinement of a field)
+    TEST(prediction, exact_3d_on_children)
+    {
+        auto mesh       = two_level_mesh_3d();
+        using mesh_id_t = typename decltype(mesh)::mesh_id_t;
+
+        auto u = make_field<double, 1>("u", mesh);
+        fill_with_f(u);
+        auto u_fine = make_field<double, 1>("u_fine", mesh);
+        u_fine.fill(0);
+
+        auto parents = intersection(mesh[mesh_id_t::reference][2], mesh[mesh_id_t::cells][3]).on(2);
+        parents.apply_op(prediction<1, true>(u_fine, u));
+        expect_exact_on_fine_cells(u_fine);
+    }
+}
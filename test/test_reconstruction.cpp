@@ -0,0 +1,212 @@
+#include <cmath>
+#include <map>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <xtensor/xmath.hpp>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/reconstruction.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        template <std::size_t order, class index_t>
+        std::map<index_t, double> stencil(const prediction_table<order, index_t>& table, std::size_t ii)
+        {
+            std::map<index_t, double> coeffs;
+            for (std::size_t s = 0; s < table.size(ii); ++s)
+            {
+                coeffs[table.offsets(ii)[s]] = table.weights(ii)[s];
+            }
+            return coeffs;
+        }
+
+        using mr_mesh_t = MRMesh<MRConfig<2>>;
+
+        // Level 3 on the bottom half, level 5 on [0.75, 1] x [0.75, 1] and level 4 elsewhere
+        auto graded_mesh()
+        {
+            typename mr_mesh_t::cl_type cl;
+            for (int j = 0; j < 4; ++j)
+            {
+                cl[3][{j}].add_interval({0, 8});
+            }
+            for (int j = 8; j < 12; ++j)
+            {
+                cl[4][{j}].add_interval({0, 16});
+            }
+            for (int j = 12; j < 16; ++j)
+            {
+                cl[4][{j}].add_interval({0, 12});
+            }
+            for (int j = 24; j < 32; ++j)
+            {
+                cl[5][{j}].add_interval({24, 32});
+            }
+            return mr_mesh_t(cl, 3, 5);
+        }
+
+        template <class Field>
+        void init_smooth(Field& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto x = cell.center();
+                              if constexpr (Field::size == 1)
+                              {
+                                  u[cell] = std::cos(3 * x[0]) * std::sin(2 * x[1]) + x[0];
+                              }
+                              else
+                              {
+                                  for (std::size_t c = 0; c < Field::size; ++c)
+                                  {
+                                      u[cell][c] = std::cos(3 * x[0] + static_cast<double>(c)) * std::sin(2 * x[1]) + x[0];
+                                  }
+                              }
+                          });
+            make_bc<Neumann>(u, 0.);
+            update_ghost_mr(u);
+        }
+
+        // The streaming reconstruction visits each cell of the finest level once, slab by slab, with the values of reconstruction(u)
+        template <class Field>
+        void check_streaming_reconstruction(const Field& u)
+        {
+            auto reconstructed = reconstruction(u);
+
+            std::size_t n_cells = 0;
+            int slab            = -1;
+            reconstruction(u,
+                           [&](const auto& i, const auto& index, const auto& values)
+                           {
+                               EXPECT_GE(index[0], slab);
+                               slab = static_cast<int>(index[0]);
+
+                               auto expected = reconstructed(5, i, index);
+                               ASSERT_EQ(values.size(), expected.size());
+                               EXPECT_LE(xt::amax(xt::abs(values - expected))(), 1e-14);
+                               n_cells += i.size();
+                           });
+            EXPECT_EQ(slab, 31);
+            EXPECT_EQ(n_cells, reconstructed.mesh().nb_cells());
+        }
+    }
+
+    TEST(reconstruction, prediction_table_of_one_level)
+    {
+        const auto& table = get_prediction_table<1>(1);
+        EXPECT_EQ(table.delta_level(), std::size_t{1});
+
+        // u_{2i} = u_i + (u_{i-1} - u_{i+1}) / 8 and u_{2i+1} = u_i - (u_{i-1} - u_{i+1}) / 8
+        std::map<default_config::value_t, double> left{
+            {-1, 1. / 8 },
+            {0,  1.     },
+            {1,  -1. / 8}
+        };
+        std::map<default_config::value_t, double> right{
+            {-1, -1. / 8},
+            {0,  1.     },
+            {1,  1. / 8 }
+        };
+        EXPECT_EQ(stencil(table, 0), left);
+        EXPECT_EQ(stencil(table, 1), right);
+    }
+
+    TEST(reconstruction, prediction_tables_are_conservative)
+    {
+        for (std::size_t delta_l = 0; delta_l <= 6; ++delta_l)
+        {
+            const auto& table        = get_prediction_table<2>(delta_l);
+            std::size_t n_fine_cells = std::size_t{1} << delta_l;
+
+            // Constants are predicted exactly, and the mean of the fine cells is the coarse value
+            std::map<default_config::value_t, double> mean;
+            for (std::size_t ii = 0; ii < n_fine_cells; ++ii)
+            {
+                double sum = 0;
+                for (const auto& [offset, weight] : stencil(table, ii))
+                {
+                    sum += weight;
+                    mean[offset] += weight / static_cast<double>(n_fine_cells);
+                }
+                EXPECT_NEAR(sum, 1., 1e-14);
+            }
+            for (const auto& [offset, weight] : mean)
+            {
+                EXPECT_NEAR(weight, (offset == 0) ? 1. : 0., 1e-14);
+            }
+        }
+    }
+
+    TEST(reconstruction, prediction_map_from_the_tables)
+    {
+        // Fine cell 13 of the level 3 below the coarse cell 1
+        auto map          = prediction<1>(std::size_t{3}, default_config::value_t{13});
+        const auto& table = get_prediction_table<1>(3);
+        auto coeffs       = stencil(table, 5);
+        ASSERT_EQ(map.coeff.size(), coeffs.size());
+        for (const auto& [offset, weight] : coeffs)
+        {
+            EXPECT_DOUBLE_EQ((map.coeff[{1 + offset}]), weight);
+        }
+    }
+
+    TEST(reconstruction, streaming_is_the_reconstruction)
+    {
+        auto mesh = graded_mesh();
+
+        auto u = make_field<double, 1>("u", mesh);
+        init_smooth(u);
+        check_streaming_reconstruction(u);
+
+        auto v = make_field<double, 2>("v", mesh);
+        init_smooth(v);
+        check_streaming_reconstruction(v);
+
+        auto w = make_field<double, 2, true>("w", mesh);
+        init_smooth(w);
+        check_streaming_reconstruction(w);
+    }
+
+    TEST(reconstruction, prediction_tables_built_concurrently)
+    {
+        // Tables of an index type which no other test uses, built on first use by all the threads at once
+        constexpr std::size_t n_threads = 8;
+        std::vector<const prediction_table<3, long long>*> tables(n_threads);
+        std::vector<std::thread> threads;
+        for (std::size_t t = 0; t < n_threads; ++t)
+        {
+            threads.emplace_back(
+                [&tables, t]()
+                {
+                    tables[t] = &get_prediction_table<3, long long>(8);
+                });
+        }
+        for (auto& thread : threads)
+        {
+            thread.join();
+        }
+
+        for (std::size_t t = 1; t < n_threads; ++t)
+        {
+            EXPECT_EQ(tables[t], tables[0]);
+        }
+        for (std::size_t ii = 0; ii < (std::size_t{1} << 8); ++ii)
+        {
+            double sum = 0;
+            for (std::size_t s = 0; s < tables[0]->size(ii); ++s)
+            {
+                sum += tables[0]->weights(ii)[s];
+            }
+            EXPECT_NEAR(sum, 1., 1e-13);
+        }
+    }
+}
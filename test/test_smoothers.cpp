@@ -0,0 +1,80 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/schemes/fv.hpp>
+
+#include "test_adapted_mesh.hpp"
+
+namespace samurai
+{
+    namespace
+    {
+        template <class Field>
+        double cells_norm(const Field& f)
+        {
+            using mesh_id_t = typename Field::mesh_t::mesh_id_t;
+            double sum      = 0;
+            for_each_cell(f.mesh()[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              sum += f[cell] * f[cell];
+                          });
+            return std::sqrt(sum);
+        }
+
+        template <class Mesh>
+        void check_red_black_gauss_seidel(Mesh& mesh)
+        {
+            auto u   = make_field<double, 1>("u", mesh);
+            auto rhs = make_field<double, 1>("rhs", mesh);
+            make_bc<Dirichlet>(u, 1.);
+            for_each_cell(mesh,
+                          [&](const auto& cell)
+                          {
+                              rhs[cell] = std::cos(3 * cell.center(0)) * std::sin(2 * cell.center(1));
+                          });
+
+            double dt   = 1e-2;
+            auto diff   = make_diffusion<decltype(u)>();
+            auto id     = make_identity<decltype(u)>();
+            auto scheme = id + dt * diff;
+
+            double tol = 1e-10;
+
+            auto u_jacobi = u;
+            u_jacobi.fill(0);
+            auto jacobi            = make_smoother(scheme, SmootherType::Jacobi);
+            auto jacobi_iterations = jacobi.solve(u_jacobi, rhs, tol);
+
+            auto u_gs = u;
+            u_gs.fill(0);
+            auto gauss_seidel            = make_smoother(scheme, SmootherType::RedBlackGaussSeidel);
+            auto gauss_seidel_iterations = gauss_seidel.solve(u_gs, rhs, tol);
+
+            EXPECT_LT(gauss_seidel_iterations, jacobi_iterations);
+            EXPECT_LE(cells_norm(gauss_seidel.residual(u_gs, rhs)), tol * cells_norm(rhs));
+
+            auto difference = u_gs;
+            difference.array() -= u_jacobi.array();
+            EXPECT_LE(cells_norm(difference), 1e-6 * cells_norm(u_jacobi));
+        }
+    }
+
+    TEST(smoothers, red_black_gauss_seidel_uniform)
+    {
+        using Config = MRConfig<2>;
+        Box<double, 2> box({0., 0.}, {1., 1.});
+        MRMesh<Config> mesh{box, 4, 4};
+        check_red_black_gauss_seidel(mesh);
+    }
+
+    TEST(smoothers, red_black_gauss_seidel_adapted)
+    {
+        auto mesh = adapted_mesh(2, 5);
+        check_red_black_gauss_seidel(mesh);
+    }
+}
@@ -0,0 +1,97 @@
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/algorithm/update.hpp>
+#include <samurai/bc.hpp>
+#include <samurai/field.hpp>
+#include <samurai/mr/mesh.hpp>
+#include <samurai/reconstruction.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        using mesh_t    = MRMesh<MRConfig<2>>;
+        using mesh_id_t = typename mesh_t::mesh_id_t;
+
+        // [0, 0.25] x [0, 1] on the level 3, [0.25, 0.5] x [0, 1] on the level 4, [0.5, 1] x [0, 1] on the level 5
+        auto three_level_mesh()
+        {
+            typename mesh_t::cl_type cl;
+            for (int j = 0; j < 8; ++j)
+            {
+                cl[3][{j}].add_interval({0, 2});
+            }
+            for (int j = 0; j < 16; ++j)
+            {
+                cl[4][{j}].add_interval({4, 8});
+            }
+            for (int j = 0; j < 32; ++j)
+            {
+                cl[5][{j}].add_interval({16, 32});
+            }
+            return mesh_t(cl, 3, 5);
+        }
+
+        template <class Field>
+        void init(Field& u)
+        {
+            for_each_cell(u.mesh(),
+                          [&](const auto& cell)
+                          {
+                              auto x  = cell.center();
+                              u[cell] = std::sin(3 * x[0]) * std::cos(2 * x[1]) + x[0] * x[1];
+                          });
+            make_bc<Neumann>(u, 0.);
+            update_ghost_mr(u);
+        }
+    }
+
+    TEST(transfer, to_the_finest_level_is_the_reconstruction)
+    {
+        auto mesh = three_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        init(u);
+
+        mesh_t fine_mesh{Box<double, 2>({0., 0.}, {1., 1.}), 5, 5};
+        auto u_fine = make_field<double, 1>("u_fine", fine_mesh);
+
+        transfer_map<mesh_t> map(mesh, fine_mesh);
+        EXPECT_EQ(map.nb_rows(), fine_mesh.nb_cells(mesh_id_t::cells));
+        map.apply(u, u_fine);
+
+        std::size_t n_cells = 0;
+        reconstruction(u,
+                       [&](const auto& i, const auto& index, const auto& values)
+                       {
+                           auto transferred = u_fine(5, i, index);
+                           for (std::size_t x = 0; x < i.size(); ++x)
+                           {
+                               EXPECT_NEAR(transferred(x), values(x), 1e-14);
+                           }
+                           n_cells += i.size();
+                       });
+        EXPECT_EQ(n_cells, fine_mesh.nb_cells(mesh_id_t::cells));
+    }
+
+    TEST(transfer, back_to_the_source_mesh_is_the_identity)
+    {
+        auto mesh = three_level_mesh();
+        auto u    = make_field<double, 1>("u", mesh);
+        init(u);
+
+        // The prediction preserves the means: projecting the reconstruction gives back the source values
+        mesh_t fine_mesh{Box<double, 2>({0., 0.}, {1., 1.}), 5, 5};
+        auto u_fine = make_field<double, 1>("u_fine", fine_mesh);
+        auto v      = make_field<double, 1>("v", mesh);
+        transfer(u, u_fine);
+        transfer(u_fine, v);
+
+        for_each_cell(mesh[mesh_id_t::cells],
+                      [&](const auto& cell)
+                      {
+                          EXPECT_NEAR(v[cell], u[cell], 1e-13);
+                      });
+    }
+}
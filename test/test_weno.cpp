@@ -0,0 +1,126 @@
+#include <array>
+#include <cmath>
+
+#include <gtest/gtest.h>
+
+#include <samurai/field.hpp>
+#include <samurai/schemes/weno.hpp>
+#include <samurai/uniform_mesh.hpp>
+
+namespace samurai
+{
+    namespace
+    {
+        // Cubic: the divided differences of its point values are the averages of its quadratic derivative,
+        // which the WENO5 reconstruction reproduces exactly whatever its nonlinear weights.
+        double p(double x, double y)
+        {
+            return 1 + x - 2 * y + x * x * x - 2 * x * x * y + 3 * x * y * y - y * y * y;
+        }
+
+        double dp_dx(double x, double y)
+        {
+            return 1 + 3 * x * x - 4 * x * y + 3 * y * y;
+        }
+
+        double dp_dy(double x, double y)
+        {
+            return -2 - 2 * x * x + 6 * x * y - 3 * y * y;
+        }
+
+        template <class Operator>
+        void check_exact_advection(Operator&& op)
+        {
+            static constexpr std::size_t dim = 2;
+            using config                     = UniformConfig<dim, 3>;
+            using mesh_t                     = UniformMesh<config>;
+            using mesh_id_t                  = typename mesh_t::mesh_id_t;
+
+            Box<double, dim> box({0., 0.}, {1., 1.});
+            mesh_t mesh{box, 4};
+
+            auto phi = make_field<double, 1>("phi", mesh);
+            auto vel = make_field<double, 2>("vel", mesh);
+            for_each_cell(mesh[mesh_id_t::cells_and_ghosts],
+                          [&](const auto& cell)
+                          {
+                              auto x       = cell.center(0);
+                              auto y       = cell.center(1);
+                              phi[cell]    = p(x, y);
+                              // Both signs of each component
+                              vel[cell][0] = std::cos(5 * x + y);
+                              vel[cell][1] = std::sin(3 * y - x);
+                          });
+
+            auto result = make_field<double, 1>("result", mesh);
+            result      = op(phi, vel);
+
+            for_each_cell(mesh[mesh_id_t::cells],
+                          [&](const auto& cell)
+                          {
+                              auto x       = cell.center(0);
+                              auto y       = cell.center(1);
+                              double exact = vel[cell][0] * dp_dx(x, y) + vel[cell][1] * dp_dy(x, y);
+                              EXPECT_NEAR(result[cell], exact, 1e-9) << cell;
+                          });
+        }
+    }
+
+    // The cell averages of a quadratic are reconstructed exactly at the faces, from both sides
+    TEST(weno, reconstruction_exact_for_quadratics)
+    {
+        // Averages over [k, k+1] of q(x) = 2 - 3x + 0.5x^2
+        auto primitive = [](double x)
+        {
+            return 2 * x - 1.5 * x * x + x * x * x / 6;
+        };
+        auto q = [](double x)
+        {
+            return 2 - 3 * x + 0.5 * x * x;
+        };
+        auto average = [&](std::ptrdiff_t k)
+        {
+            return primitive(static_cast<double>(k + 1)) - primitive(static_cast<double>(k));
+        };
+
+        constexpr std::size_t n = 100; // more than one chunk of faces
+        std::array<double, n> minus;
+        std::array<double, n> plus;
+
+        Weno5<WenoWeights::JS> weno_js;
+        weno_js.reconstruct(average, n, minus.data(), plus.data());
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            double face = static_cast<double>(k) + 1;
+            EXPECT_NEAR(minus[k], q(face), 1e-9 * std::abs(q(face)) + 1e-9);
+            EXPECT_NEAR(plus[k], q(face), 1e-9 * std::abs(q(face)) + 1e-9);
+        }
+
+        Weno5<WenoWeights::Z> weno_z;
+        weno_z.reconstruct(average, n, minus.data(), plus.data());
+        for (std::size_t k = 0; k < n; ++k)
+        {
+            double face = static_cast<double>(k) + 1;
+            EXPECT_NEAR(minus[k], q(face), 1e-9 * std::abs(q(face)) + 1e-9);
+            EXPECT_NEAR(plus[k], q(face), 1e-9 * std::abs(q(face)) + 1e-9);
+        }
+    }
+
+    TEST(weno, weno5_advection_exact_for_cubics)
+    {
+        check_exact_advection(
+            [](const auto& phi, const auto& vel)
+            {
+                return weno5(phi, vel);
+            });
+    }
+
+    TEST(weno, weno5z_advection_exact_for_cubics)
+    {
+        check_exact_advection(
+            [](const auto& phi, const auto& vel)
+            {
+                return weno5z(phi, vel);
+            });
+    }
+}